@@ -55,15 +55,135 @@ typedef enum {
     GSM_CMD_CSTM_CSTT_SET,
     GSM_CMD_CSTM_CIICR,
     GSM_CMD_CSTM_CIFSR,
+    GSM_CMD_CSTM_CIPSTATUS,
 } gsm_cmd_custom_t;
 
+#if GSM_CFG_NETWORK || __DOXYGEN__
+
+/**
+ * \brief           IP connection state reported by `+CIPSTATUS` command
+ * \note            Order of entries follows normal bring-up sequence
+ */
+typedef enum {
+    IP_STATE_UNKNOWN = 0x00,                    /*!< State is not known */
+    IP_STATE_INITIAL,                           /*!< `IP INITIAL` state */
+    IP_STATE_PDP_DEACT,                         /*!< `PDP DEACT` state, context was deactivated */
+    IP_STATE_START,                             /*!< `IP START` state, APN is set */
+    IP_STATE_CONFIG,                            /*!< `IP CONFIG` state, wireless connection is being brought up */
+    IP_STATE_GPRSACT,                           /*!< `IP GPRSACT` state, wireless connection is up */
+    IP_STATE_STATUS,                            /*!< `IP STATUS` or `IP PROCESSING` state, local IP is assigned */
+} ip_state_t;
+
+static ip_state_t ip_state;                     /*!< Last known IP connection state */
+static uint8_t ip_mux_set;                      /*!< Flag indicating `CIPMUX=1` was set since reset */
+static uint8_t ip_rxget_set;                    /*!< Flag indicating `CIPRXGET=1` was set since reset */
+
+/**
+ * \brief           Check if IP bearer is already started and attach teardown steps can be skipped
+ * \param[in]       msg: Current message
+ * \return          `1` if step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_ip_started(gsm_msg_t* msg) {
+    GSM_UNUSED(msg);
+    return ip_mux_set && ip_rxget_set &&
+        (ip_state == IP_STATE_START || ip_state == IP_STATE_GPRSACT || ip_state == IP_STATE_STATUS);
+}
+
+/**
+ * \brief           Check if multiple connections mode is already set
+ * \param[in]       msg: Current message
+ * \return          `1` if step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_mux_set(gsm_msg_t* msg) {
+    GSM_UNUSED(msg);
+    return ip_mux_set;
+}
+
+/**
+ * \brief           Check if manual data receive mode is already set
+ * \param[in]       msg: Current message
+ * \return          `1` if step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_rxget_set(gsm_msg_t* msg) {
+    GSM_UNUSED(msg);
+    return ip_rxget_set;
+}
+
+/**
+ * \brief           Check if wireless connection is already active
+ * \param[in]       msg: Current message
+ * \return          `1` if step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_gprs_active(gsm_msg_t* msg) {
+    GSM_UNUSED(msg);
+    return ip_state == IP_STATE_GPRSACT || ip_state == IP_STATE_STATUS;
+}
+
+/**
+ * \brief           Steps to attach to network
+ * \note            Teardown and setup steps are skipped when state from `+CIPSTATUS` shows they were already done
+ */
+static const gsm_cmd_step_t
+network_attach_steps[] = {
+    { (gsm_cmd_t)GSM_CMD_CSTM_CIPSTATUS, NULL },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CGACT_SET_0, is_ip_started },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CGACT_SET_1, is_ip_started },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CGATT_SET_0, is_ip_started },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CGATT_SET_1, is_ip_started },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CIPSHUT, is_ip_started },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CIPMUX_SET, is_mux_set },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CIPRXGET_SET, is_rxget_set },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CSTT_SET, is_ip_started },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CIICR, is_gprs_active },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CIFSR, NULL },
+};
+
+/**
+ * \brief           Steps to detach from network
+ */
+static const gsm_cmd_step_t
+network_detach_steps[] = {
+    { (gsm_cmd_t)GSM_CMD_CSTM_CGATT_SET_0, NULL },
+    { (gsm_cmd_t)GSM_CMD_CSTM_CGACT_SET_0, NULL },
+};
+
+/**
+ * \brief           Parse state from `STATE: ` line of `+CIPSTATUS` response
+ * \param[in]       str: Pointer to string after `STATE: ` prefix
+ */
+static void
+parse_ip_state(const char* str) {
+    if (!strncmp(str, "IP INITIAL", 10)) {
+        ip_state = IP_STATE_INITIAL;
+    } else if (!strncmp(str, "IP START", 8)) {
+        ip_state = IP_STATE_START;
+    } else if (!strncmp(str, "IP CONFIG", 9)) {
+        ip_state = IP_STATE_CONFIG;
+    } else if (!strncmp(str, "IP GPRSACT", 10)) {
+        ip_state = IP_STATE_GPRSACT;
+    } else if (!strncmp(str, "IP STATUS", 9) || !strncmp(str, "IP PROCESSING", 13)) {
+        ip_state = IP_STATE_STATUS;
+    } else if (!strncmp(str, "PDP DEACT", 9)) {
+        ip_state = IP_STATE_PDP_DEACT;
+    } else {
+        ip_state = IP_STATE_UNKNOWN;
+    }
+}
+
+#endif /* GSM_CFG_NETWORK || __DOXYGEN__ */
+
 /**
  * \brief           Device driver control structure
  */
 gsm_device_driver_t
 gsm_device_sim800_900 = {
     .features = GSM_DEVICE_FEATURE_SMS | GSM_DEVICE_FEATURE_CALL |
-                GSM_DEVICE_FEATURE_PB | GSM_DEVICE_FEATURE_TCPIP,
+                GSM_DEVICE_FEATURE_PB | GSM_DEVICE_FEATURE_TCPIP |
+                GSM_DEVICE_FEATURE_SMS_CMGDA,
     .at_start_cmd_fn = at_send_cmd,
     .at_line_recv_fn = at_line_recv,
     .at_process_sub_cmd_fn = at_process_sub_cmd,
@@ -80,24 +200,25 @@ at_process_sub_cmd(void* m, uint8_t is_ok, uint16_t is_error) {
     if (CMD_IS_DEF(GSM_CMD_RESET)) {            /* Check for device specific reset */
 
 #if GSM_CFG_NETWORK
-    } if (CMD_IS_DEF(GSM_CMD_NETWORK_ATTACH)) {
-        switch (msg->i) {
-            case 0: cmd = GSM_CMD_CSTM_CGACT_SET_1; break;
-            case 1: cmd = GSM_CMD_CSTM_CGATT_SET_0; break;
-            case 2: cmd = GSM_CMD_CSTM_CGATT_SET_1; break;
-            case 3: cmd = GSM_CMD_CSTM_CIPSHUT; break;
-            case 4: cmd = GSM_CMD_CSTM_CIPMUX_SET; break;
-            case 5: cmd = GSM_CMD_CSTM_CIPRXGET_SET; break;
-            case 6: cmd = GSM_CMD_CSTM_CSTT_SET; break;
-            case 7: cmd = GSM_CMD_CSTM_CIICR; break;
-            case 8: cmd = GSM_CMD_CSTM_CIFSR; break;
+    } else if (CMD_IS_DEF(GSM_CMD_NETWORK_ATTACH)) {
+        /*
+         * Track IP state of executed steps.
+         * Errors on intermediate steps are ignored,
+         * final result is given by last step
+         */
+        switch ((uint32_t)CMD_GET_CUR()) {
+            case GSM_CMD_CSTM_CIPSHUT:      if (is_ok) { ip_state = IP_STATE_INITIAL; } break;
+            case GSM_CMD_CSTM_CIPMUX_SET:   ip_mux_set = is_ok; break;
+            case GSM_CMD_CSTM_CIPRXGET_SET: ip_rxget_set = is_ok; break;
+            case GSM_CMD_CSTM_CSTT_SET:     ip_state = is_ok ? IP_STATE_START : IP_STATE_UNKNOWN; break;
+            case GSM_CMD_CSTM_CIICR:        ip_state = is_ok ? IP_STATE_GPRSACT : IP_STATE_UNKNOWN; break;
+            case GSM_CMD_CSTM_CIFSR:        ip_state = is_ok ? IP_STATE_STATUS : IP_STATE_UNKNOWN; break;
             default: break;
         }
+        cmd = gsmi_cmd_steps_next(msg, 0);
     } else if (CMD_IS_DEF(GSM_CMD_NETWORK_DETACH)) {
-        switch (msg->i) {
-            case 0: cmd = GSM_CMD_CSTM_CGACT_SET_0; break;
-            default: break;
-        }
+        ip_state = IP_STATE_UNKNOWN;            /* Force full attach sequence next time */
+        cmd = gsmi_cmd_steps_next(msg, 0);
         if (!cmd) {
             is_ok = 1;
         }
@@ -122,12 +243,28 @@ at_send_cmd(void* m) {
     gsm_msg_t* msg = m;
     switch (CMD_GET_CUR()) {
         case GSM_CMD_RESET_DEVICE_FIRST_CMD: {  /* First command for device driver specific reset */
+#if GSM_CFG_NETWORK
+            ip_state = IP_STATE_UNKNOWN;        /* Device state is not known after reset */
+            ip_mux_set = 0;
+            ip_rxget_set = 0;
+#endif /* GSM_CFG_NETWORK */
             GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
             GSM_AT_PORT_SEND_END();             /* End AT command string */
             break;
         }
 #if GSM_CFG_NETWORK
-        case GSM_CMD_NETWORK_ATTACH:
+        case GSM_CMD_NETWORK_ATTACH: {
+            msg->steps = network_attach_steps;  /* Set steps table for attach */
+            msg->steps_len = GSM_ARRAYSIZE(network_attach_steps);
+            msg->cmd = gsmi_cmd_steps_next(msg, 1);
+            return at_send_cmd(msg);            /* Send first step */
+        }
+        case GSM_CMD_NETWORK_DETACH: {
+            msg->steps = network_detach_steps;  /* Set steps table for detach */
+            msg->steps_len = GSM_ARRAYSIZE(network_detach_steps);
+            msg->cmd = gsmi_cmd_steps_next(msg, 1);
+            return at_send_cmd(msg);            /* Send first step */
+        }
         case GSM_CMD_CSTM_CGACT_SET_0: {
             GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
             GSM_AT_PORT_SEND_STR("+CGACT=0");
@@ -140,7 +277,6 @@ at_send_cmd(void* m) {
             GSM_AT_PORT_SEND_END();             /* End AT command string */
             break;
         }
-        case GSM_CMD_NETWORK_DETACH:
         case GSM_CMD_CSTM_CGATT_SET_0: {
             GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
             GSM_AT_PORT_SEND_STR("+CGATT=0");
@@ -192,6 +328,12 @@ at_send_cmd(void* m) {
             GSM_AT_PORT_SEND_END();             /* End AT command string */
             break;
         }
+        case GSM_CMD_CSTM_CIPSTATUS: {          /* Query current IP connection state */
+            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
+            GSM_AT_PORT_SEND_STR("+CIPSTATUS");
+            GSM_AT_PORT_SEND_END();             /* End AT command string */
+            break;
+        }
 #endif /* GSM_CFG_NETWORK */
         default:
             return gsmERR;
@@ -208,6 +350,24 @@ at_send_cmd(void* m) {
  */
 static uint8_t
 at_line_recv(gsm_recv_t* rcv, uint8_t* is_ok, uint16_t* is_error) {
+#if GSM_CFG_NETWORK
+    /*
+     * State line is sent after OK in CIPSTATUS response.
+     * In multiple connections mode, connection lines follow
+     * where last line for connection 5 finishes the command
+     */
+    if (CMD_IS_CUR(GSM_CMD_CSTM_CIPSTATUS)) {
+        if (*is_ok) {
+            *is_ok = 0;                         /* Wait for state line */
+        } else if (!strncmp(rcv->data, "STATE: ", 7)) {
+            parse_ip_state(&rcv->data[7]);
+            *is_ok = !ip_mux_set;
+        } else if (!strncmp(rcv->data, "C: 5,", 5)) {
+            *is_ok = 1;
+        }
+        return 1;
+    }
+#endif /* GSM_CFG_NETWORK */
     if (rcv->data[0] == '+') {
     
     } else {
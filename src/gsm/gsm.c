@@ -45,6 +45,39 @@ static gsm_cb_func_t def_cb_link;
 
 gsm_t gsm;
 
+/**
+ * \brief           Add callback function to the end of linked list
+ * \note            Core must be locked before calling this function
+ * \param[in,out]   list: Pointer to first entry of linked list
+ * \param[in]       cb_fn: Callback function to add
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+cb_list_add(gsm_cb_func_t** list, gsm_cb_fn cb_fn) {
+    gsm_cb_func_t* func, *newFunc;
+
+    /* Check if function already exists on list */
+    for (func = *list; func != NULL; func = func->next) {
+        if (func->fn == cb_fn) {
+            return gsmERR;
+        }
+    }
+
+    newFunc = gsm_mem_alloc(sizeof(*newFunc));  /* Get memory for new function */
+    if (newFunc == NULL) {
+        return gsmERRMEM;
+    }
+    memset(newFunc, 0x00, sizeof(*newFunc));    /* Reset memory */
+    newFunc->fn = cb_fn;                        /* Set function pointer */
+    if (*list == NULL) {
+        *list = newFunc;                        /* Set as first entry */
+    } else {
+        for (func = *list; func->next != NULL; func = func->next) {}
+        func->next = newFunc;                   /* Set new function as next */
+    }
+    return gsmOK;
+}
+
 /**
  * \brief           Default callback function for events
  * \param[in]       cb: Pointer to callback data structure
@@ -70,6 +103,7 @@ gsm_init(gsm_cb_fn cb_func, uint32_t blocking) {
     def_cb_link.fn = cb_func ? cb_func : def_callback;
     gsm.cb_func = &def_cb_link;                 /* Set callback function */
     
+    gsmi_invalidate_cache();                    /* Device state is not known yet */
     gsm_sys_init();                             /* Init low-level system */
     gsm_ll_init(&gsm.ll, GSM_CFG_AT_PORT_BAUDRATE); /* Init low-level communication */
     
@@ -80,6 +114,13 @@ gsm_init(gsm_cb_fn cb_func, uint32_t blocking) {
     gsm_sys_mbox_create(&gsm.mbox_process, GSM_CFG_THREAD_PROCESS_MBOX_SIZE);   /* Consumer message queue */
     gsm_sys_thread_create(&gsm.thread_process,  "gsm_process", (gsm_sys_thread_fn)gsm_thread_process, &gsm, GSM_SYS_THREAD_SS, GSM_SYS_THREAD_PRIO);
 
+#if GSM_CFG_EVT_QUEUE
+    gsmi_evt_queue_init();                      /* Deferred event queue */
+#if GSM_CFG_EVT_QUEUE_THREAD
+    gsm_sys_thread_create(&gsm.thread_evt, "gsm_evt", (gsm_sys_thread_fn)gsm_thread_evt, &gsm, GSM_SYS_THREAD_SS, GSM_SYS_THREAD_PRIO);
+#endif /* GSM_CFG_EVT_QUEUE_THREAD */
+#endif /* GSM_CFG_EVT_QUEUE */
+
 #if !GSM_CFG_INPUT_USE_PROCESS
     gsm_buff_init(&gsm.buff, GSM_CFG_RCV_BUFF_SIZE);    /* Init buffer for input data */
 #endif /* !GSM_CFG_INPUT_USE_PROCESS */
@@ -168,37 +209,12 @@ gsm_core_unlock(void) {
  */
 gsmr_t
 gsm_cb_register(gsm_cb_fn cb_fn) {
-    gsmr_t res = gsmOK;
-    gsm_cb_func_t* func, *newFunc;
+    gsmr_t res;
     
     GSM_ASSERT("cb_fn != NULL", cb_fn != NULL); /* Assert input parameters */
     
     GSM_CORE_PROTECT();                         /* Lock GSM core */
-    
-    /* Check if function already exists on list */
-    for (func = gsm.cb_func; func != NULL; func = func->next) {
-        if (func->fn == cb_fn) {
-            res = gsmERR;
-            break;
-        }
-    }
-    
-    if (res == gsmOK) {
-        newFunc = gsm_mem_alloc(sizeof(*newFunc));  /* Get memory for new function */
-        if (newFunc != NULL) {
-            memset(newFunc, 0x00, sizeof(*newFunc));/* Reset memory */
-            newFunc->fn = cb_fn;                /* Set function pointer */
-            if (gsm.cb_func == NULL) {
-                gsm.cb_func = newFunc;          /* This should never happen! */
-            } else {
-                for (func = gsm.cb_func; func->next != NULL; func = func->next) {}
-                func->next = newFunc;           /* Set new function as next */
-            }
-            res = gsmOK;
-        } else {
-            res = gsmERRMEM;
-        }
-    }
+    res = cb_list_add(&gsm.cb_func, cb_fn);     /* Add function to list of all events */
     GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
     return res;
 }
@@ -227,6 +243,59 @@ gsm_cb_unregister(gsm_cb_fn cb_fn) {
     return gsmOK;
 }
 
+/**
+ * \brief           Register callback function for single event type only
+ *
+ *                  Function is called only when event of specific type occurs,
+ *                  in contrast to \ref gsm_cb_register, where function is called for every event.
+ *                  Same function may be registered for multiple event types
+ * \param[in]       type: Event type to subscribe to
+ * \param[in]       cb_fn: Callback function to call on specific event
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_cb_register_type(gsm_cb_type_t type, gsm_cb_fn cb_fn) {
+    gsmr_t res;
+
+    GSM_ASSERT("type < GSM_CB_END", type < GSM_CB_END); /* Assert input parameters */
+    GSM_ASSERT("cb_fn != NULL", cb_fn != NULL); /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    res = cb_list_add(&gsm.cb_func_type[type], cb_fn);  /* Add function to list of event type */
+    GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
+    return res;
+}
+
+/**
+ * \brief           Unregister callback function for single event type
+ * \note            Function must be first registered using \ref gsm_cb_register_type
+ * \param[in]       type: Event type function was subscribed to
+ * \param[in]       cb_fn: Callback function to remove
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_cb_unregister_type(gsm_cb_type_t type, gsm_cb_fn cb_fn) {
+    gsm_cb_func_t* func, *prev;
+
+    GSM_ASSERT("type < GSM_CB_END", type < GSM_CB_END); /* Assert input parameters */
+    GSM_ASSERT("cb_fn != NULL", cb_fn != NULL); /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    for (prev = NULL, func = gsm.cb_func_type[type]; func != NULL; prev = func, func = func->next) {
+        if (func->fn == cb_fn) {
+            if (prev == NULL) {
+                gsm.cb_func_type[type] = func->next;
+            } else {
+                prev->next = func->next;
+            }
+            gsm_mem_free(func);
+            break;
+        }
+    }
+    GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
+    return gsmOK;
+}
+
 /**
  * \brief           Delay for amount of milliseconds
  * \param[in]       ms: Milliseconds to delay
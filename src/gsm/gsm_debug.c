@@ -35,13 +35,25 @@
 #include "gsm/gsm.h"
 
 #if GSM_CFG_DBG || __DOXYGEN__
-    
+
+/**
+ * \brief           List of command names, indexed by \ref gsm_cmd_t
+ */
+static const char* const
+cmd_names[] = {
+#define GSM_CMD_DEF(name, str)                  #name,
+#include "gsm/gsm_commands.h"
+};
+
+/**
+ * \brief           Get command name for debug purpose
+ * \param[in]       cmd: Command to get name for
+ * \return          Command name or empty string for idle and device specific commands
+ */
 const char *
 gsmi_dbg_msg_to_string(gsm_cmd_t cmd) {
-    static char tmp_arr[100];
-    if (cmd) {
-        sprintf(tmp_arr, "%d", (int)cmd);
-        return tmp_arr;
+    if (cmd != GSM_CMD_IDLE && cmd < GSM_CMD_END) {
+        return cmd_names[cmd];
     }
     return "";
 }
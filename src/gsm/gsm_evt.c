@@ -44,3 +44,275 @@ uint8_t
 gsm_evt_reset_is_forced(gsm_cb_t* cb) {
     return cb->cb.reset.forced;                 /* Return forced reset status */
 }
+
+#if GSM_CFG_EVT_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Self-contained event record in deferred queue
+ *
+ *                  Data pointed to by event, which belongs to stack and
+ *                  may change before event is delivered, is copied to record
+ */
+typedef struct {
+    gsm_cb_t cb;                                /*!< Copy of event data */
+    union {
+        gsm_operator_curr_t operator_current;   /*!< Copy of current operator */
+#if GSM_CFG_CALL
+        gsm_call_t call;                        /*!< Copy of call information */
+#endif /* GSM_CFG_CALL */
+#if GSM_CFG_SMS_REPORT
+        gsm_sms_report_t sms_report;            /*!< Copy of status report */
+#endif /* GSM_CFG_SMS_REPORT */
+#if GSM_CFG_SMS_OUTBOX
+        char sms_outbox_num[26];                /*!< Copy of outbox message phone number */
+#endif /* GSM_CFG_SMS_OUTBOX */
+    } data;                                     /*!< Event data copied from stack */
+    uint8_t used;                               /*!< Flag indicating record is in use */
+} gsm_evt_rec_t;
+
+static gsm_evt_rec_t evt_pool[GSM_CFG_EVT_QUEUE_SIZE];  /* Pool of event records */
+static gsm_evt_queue_stats_t evt_stats;         /* Queue statistics */
+static size_t evt_used;                         /* Number of records currently in use */
+
+/**
+ * \brief           Check if event may be delivered later
+ *
+ *                  Some events expect immediate reaction from user,
+ *                  and these must be delivered synchronously from stack thread
+ * \param[in]       type: Event type
+ * \return          `1` if event may be deferred, `0` otherwise
+ */
+static uint8_t
+evt_is_deferrable(gsm_cb_type_t type) {
+    switch (type) {
+        case GSM_CB_DEVICE_IDENTIFIED:          /* Driver must be selected before reset sequence continues */
+        case GSM_CB_CONN_DATA_RECV:             /* Connection events hold packet buffers and have own callbacks */
+        case GSM_CB_CONN_DATA_SENT:
+        case GSM_CB_CONN_DATA_SEND_ERR:
+        case GSM_CB_CONN_ACTIVE:
+        case GSM_CB_CONN_ERROR:
+        case GSM_CB_CONN_CLOSED:
+        case GSM_CB_CONN_POLL:
+#if GSM_CFG_SMS_CONCAT
+        case GSM_CB_SMS_CONCAT:                 /* Assembled message buffer is released after event */
+#endif /* GSM_CFG_SMS_CONCAT */
+#if GSM_CFG_SMS_DIRECT
+        case GSM_CB_SMS_RECV_DIRECT:            /* Entry buffer is reused for next message */
+#endif /* GSM_CFG_SMS_DIRECT */
+#if GSM_CFG_SMS_DRAIN
+        case GSM_CB_SMS_RECV_BATCH:             /* Entries buffer is reused for next batch */
+#endif /* GSM_CFG_SMS_DRAIN */
+#if GSM_CFG_SMS_BODY_SLICE
+        case GSM_CB_SMS_BODY:                   /* Slice points to received data */
+#endif /* GSM_CFG_SMS_BODY_SLICE */
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+/**
+ * \brief           Init deferred event queue
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_evt_queue_init(void) {
+    memset(evt_pool, 0x00, sizeof(evt_pool));
+    memset(&evt_stats, 0x00, sizeof(evt_stats));
+    evt_used = 0;
+    if (!gsm_sys_mbox_create(&gsm.mbox_evt, GSM_CFG_EVT_QUEUE_SIZE)) {
+        return gsmERRMEM;
+    }
+    return gsmOK;
+}
+
+/**
+ * \brief           Copy event to free record and put it to deferred queue
+ * \param[in]       cb: Event data to copy
+ * \return          \ref gsmOK if event has been queued,
+ *                  \ref gsmERRMEM if event was dropped because queue is full,
+ *                  \ref gsmERR if event must be delivered immediately
+ */
+gsmr_t
+gsmi_evt_queue_put(const gsm_cb_t* cb) {
+    gsm_evt_rec_t* rec = NULL;
+    size_t i;
+
+    if (!evt_is_deferrable(cb->type) || !gsm_sys_mbox_isvalid(&gsm.mbox_evt)) {
+        return gsmERR;
+    }
+
+    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    for (i = 0; i < GSM_ARRAYSIZE(evt_pool); i++) {
+        if (!evt_pool[i].used) {
+            rec = &evt_pool[i];
+            rec->used = 1;
+            break;
+        }
+    }
+    if (rec == NULL) {
+        evt_stats.dropped++;                    /* No free record, event is lost */
+        GSM_CORE_UNPROTECT();                   /* Unlock GSM core */
+        return gsmERRMEM;
+    }
+    evt_used++;
+    if (evt_used > evt_stats.max_used) {
+        evt_stats.max_used = evt_used;          /* Save high watermark */
+    }
+    evt_stats.queued++;
+
+    memcpy(&rec->cb, cb, sizeof(rec->cb));      /* Copy event data */
+    switch (cb->type) {
+        case GSM_CB_OPERATOR_CURRENT: {
+            if (cb->cb.operator_current.operator_current != NULL) {
+                memcpy(&rec->data.operator_current, cb->cb.operator_current.operator_current, sizeof(rec->data.operator_current));
+                rec->cb.cb.operator_current.operator_current = &rec->data.operator_current;
+            }
+            break;
+        }
+#if GSM_CFG_CALL
+        case GSM_CB_CALL_CHANGED: {
+            if (cb->cb.call_changed.call != NULL) {
+                memcpy(&rec->data.call, cb->cb.call_changed.call, sizeof(rec->data.call));
+                rec->cb.cb.call_changed.call = &rec->data.call;
+            }
+            break;
+        }
+#endif /* GSM_CFG_CALL */
+#if GSM_CFG_SMS_REPORT
+        case GSM_CB_SMS_REPORT: {               /* Report buffer is reused for next report */
+            if (cb->cb.sms_report.report != NULL) {
+                memcpy(&rec->data.sms_report, cb->cb.sms_report.report, sizeof(rec->data.sms_report));
+                rec->cb.cb.sms_report.report = &rec->data.sms_report;
+            }
+            break;
+        }
+#endif /* GSM_CFG_SMS_REPORT */
+#if GSM_CFG_SMS_OUTBOX
+        case GSM_CB_SMS_OUTBOX: {               /* Outbox slot is released after event */
+            if (cb->cb.sms_outbox.num != NULL) {
+                strncpy(rec->data.sms_outbox_num, cb->cb.sms_outbox.num, sizeof(rec->data.sms_outbox_num) - 1);
+                rec->data.sms_outbox_num[sizeof(rec->data.sms_outbox_num) - 1] = 0;
+                rec->cb.cb.sms_outbox.num = rec->data.sms_outbox_num;
+            }
+            break;
+        }
+#endif /* GSM_CFG_SMS_OUTBOX */
+        default: break;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
+
+    /* There is always space in queue, as it is as long as records pool */
+    gsm_sys_mbox_putnow(&gsm.mbox_evt, rec);
+    return gsmOK;
+}
+
+/**
+ * \brief           Deliver queued event to registered callback functions
+ *
+ *                  User functions are called without core lock,
+ *                  so that slow application code does not block AT port processing
+ * \param[in]       r: Event record from deferred queue
+ */
+void
+gsmi_evt_queue_dispatch(void* r) {
+    gsm_evt_rec_t* rec = r;
+    gsm_cb_fn fns_local[GSM_CFG_EVT_QUEUE_LISTENERS];
+    gsm_cb_fn* fns = fns_local;
+    gsm_cb_func_t* link;
+    size_t cnt = 0, max = GSM_ARRAYSIZE(fns_local), i;
+
+    /*
+     * Make a copy of listeners first,
+     * as they may be unregistered by other thread while callbacks are running
+     */
+    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    for (link = gsm.cb_func; link != NULL; link = link->next) {
+        cnt++;
+    }
+    if (rec->cb.type < GSM_CB_END) {
+        for (link = gsm.cb_func_type[rec->cb.type]; link != NULL; link = link->next) {
+            cnt++;
+        }
+    }
+    if (cnt > max) {                            /* Snapshot does not fit to stack */
+        fns = gsm_mem_alloc(sizeof(*fns) * cnt);
+        if (fns != NULL) {
+            max = cnt;
+        } else {
+            fns = fns_local;
+            evt_stats.skipped += cnt - max;     /* Only first listeners are called */
+        }
+    }
+    cnt = 0;
+    for (link = gsm.cb_func; link != NULL && cnt < max; link = link->next) {
+        fns[cnt++] = link->fn;
+    }
+    if (rec->cb.type < GSM_CB_END) {
+        for (link = gsm.cb_func_type[rec->cb.type]; link != NULL && cnt < max; link = link->next) {
+            fns[cnt++] = link->fn;
+        }
+    }
+    GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
+
+    for (i = 0; i < cnt; i++) {
+        fns[i](&rec->cb);
+    }
+    if (fns != fns_local) {
+        gsm_mem_free(fns);
+    }
+
+    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    rec->used = 0;                              /* Return record to pool */
+    evt_used--;
+    evt_stats.dispatched++;
+    GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
+}
+
+/**
+ * \brief           Deliver pending events from deferred queue
+ *
+ *                  Use this function when \ref GSM_CFG_EVT_QUEUE_THREAD is disabled
+ *                  to deliver events from application thread
+ * \param[in]       timeout: Maximal time in units of milliseconds to wait for first event.
+ *                      Set to `0` to process only events already in queue
+ * \return          \ref gsmOK if at least one event was delivered, \ref gsmTIMEOUT otherwise
+ */
+gsmr_t
+gsm_evt_queue_process(uint32_t timeout) {
+    gsmr_t res = gsmTIMEOUT;
+    void* rec;
+
+    if (timeout > 0) {
+        if (gsm_sys_mbox_get(&gsm.mbox_evt, &rec, timeout) == GSM_SYS_TIMEOUT || rec == NULL) {
+            return gsmTIMEOUT;
+        }
+        gsmi_evt_queue_dispatch(rec);
+        res = gsmOK;
+    }
+    while (gsm_sys_mbox_getnow(&gsm.mbox_evt, &rec)) {
+        if (rec != NULL) {
+            gsmi_evt_queue_dispatch(rec);
+            res = gsmOK;
+        }
+    }
+    return res;
+}
+
+/**
+ * \brief           Get deferred event queue statistics
+ * \param[out]      stats: Pointer to output statistics structure
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_evt_queue_get_stats(gsm_evt_queue_stats_t* stats) {
+    GSM_ASSERT("stats != NULL", stats != NULL); /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Lock GSM core */
+    memcpy(stats, &evt_stats, sizeof(*stats));
+    stats->used = evt_used;
+    GSM_CORE_UNPROTECT();                       /* Unlock GSM core */
+    return gsmOK;
+}
+
+#endif /* GSM_CFG_EVT_QUEUE || __DOXYGEN__ */
@@ -39,11 +39,42 @@
 #include "system/gsm_ll.h"
 
 static gsm_recv_t recv_buff;
+static uint8_t tx_buff[GSM_CFG_AT_PORT_TX_BUFF_SIZE];   /* Staging buffer for command to send */
+static size_t tx_buff_len;                      /* Number of bytes waiting in staging buffer */
+#if GSM_CFG_SMS_PDU
+static uint8_t sms_pdu_buff[GSM_SMS_PDU_MAX_LEN];   /* PDU octets of SMS to send or SMS read with active command */
+static size_t sms_pdu_len;                      /* Number of octets of encoded PDU to send */
+static size_t sms_pdu_hex;                      /* Number of received hex digits of PDU */
+#if GSM_CFG_SMS_DIRECT || GSM_CFG_SMS_REPORT
+static uint8_t sms_pdu_urc_buff[GSM_SMS_PDU_MAX_LEN];   /* PDU octets of SMS or status report received with unsolicited code */
+static size_t sms_pdu_urc_hex;                  /* Number of received hex digits of unsolicited PDU */
+#endif /* GSM_CFG_SMS_DIRECT || GSM_CFG_SMS_REPORT */
+#endif /* GSM_CFG_SMS_PDU */
+#if GSM_CFG_SMS_DIRECT_ACK
+static uint8_t sms_ack_pending;                 /* Set to 1 when acknowledgement is sent after active command */
+static uint8_t sms_ack_skip;                    /* Number of +CNMA responses not yet received */
+#endif /* GSM_CFG_SMS_DIRECT_ACK */
+#if GSM_CFG_SMS_DIRECT
+static gsm_sms_entry_t sms_direct_entry;        /* Entry of SMS received with +CMT */
+static uint8_t sms_direct_read;                 /* Set to 1 when +CMT header is received and message line follows */
+#endif /* GSM_CFG_SMS_DIRECT */
+#if GSM_CFG_SMS_REPORT
+static gsm_sms_report_t sms_report;             /* Status report received with +CDS */
+#if GSM_CFG_SMS_PDU
+static uint8_t sms_report_read;                 /* Set to 1 when +CDS header is received and PDU line follows */
+#endif /* GSM_CFG_SMS_PDU */
+#endif /* GSM_CFG_SMS_REPORT */
+#if GSM_CFG_SMS_BODY_SLICE
+static uint8_t sms_body_cr;                     /* Set to 1 when last received body byte is \r, not yet passed to user */
+#endif /* GSM_CFG_SMS_BODY_SLICE */
 
 #define CH_CTRL_Z           (0x1A)
 #define CH_ESC              (0x1A)
 
 static gsmr_t gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t is_ok, uint16_t is_error);
+#if GSM_CFG_SMS
+static gsmr_t sms_send_prepare(gsm_msg_t* msg);
+#endif /* GSM_CFG_SMS */
 
 /**
  * \brief           Memory map
@@ -88,6 +119,53 @@ gsmi_get_sim_info(uint32_t blocking) {
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+/**
+ * \brief           Send staged data to AT port with single low-level call
+ */
+void
+gsmi_at_port_flush(void) {
+    if (tx_buff_len > 0) {
+        gsm.ll.send_fn(tx_buff, (uint16_t)tx_buff_len);
+        tx_buff_len = 0;
+    }
+}
+
+/**
+ * \brief           Add data to command staging buffer
+ *
+ *                  Data are sent to AT port when buffer is full
+ *                  or when \ref gsmi_at_port_flush is called at the end of command
+ * \param[in]       data: Pointer to data to send
+ * \param[in]       len: Number of bytes to send
+ */
+void
+gsmi_at_port_send(const void* data, size_t len) {
+    const uint8_t* d = data;
+    size_t l;
+
+    /* Send long data directly, no need to copy it first */
+    if (len >= sizeof(tx_buff)) {
+        gsmi_at_port_flush();
+        while (len > 0) {
+            l = GSM_MIN(len, 0xFFFF);
+            gsm.ll.send_fn(d, (uint16_t)l);
+            d += l;
+            len -= l;
+        }
+        return;
+    }
+    while (len > 0) {
+        l = GSM_MIN(len, sizeof(tx_buff) - tx_buff_len);
+        memcpy(&tx_buff[tx_buff_len], d, l);
+        tx_buff_len += l;
+        d += l;
+        len -= l;
+        if (tx_buff_len == sizeof(tx_buff)) {   /* Is buffer full? */
+            gsmi_at_port_flush();
+        }
+    }
+}
+
 /**
  * \brief           Create 2-characters long hex from byte
  * \param[in]       num: Number to convert to string
@@ -95,27 +173,46 @@ gsmi_get_sim_info(uint32_t blocking) {
  */
 void
 byte_to_str(uint8_t num, char* str) {
-    sprintf(str, "%02X", (unsigned)num);        /* Currently use sprintf only */
+    static const char hex[] = "0123456789ABCDEF";
+
+    str[0] = hex[(num >> 4) & 0x0F];
+    str[1] = hex[num & 0x0F];
+    str[2] = 0;
 }
 
 /**
  * \brief           Create string from number
  * \param[in]       num: Number to convert to string
- * \param[out]      str: Pointer to string to save result to
+ * \param[out]      str: Pointer to string to save result to, at least `11` bytes long
  */
 void
 number_to_str(uint32_t num, char* str) {
-    sprintf(str, "%u", (unsigned)num);          /* Currently use sprintf only */
+    char tmp[10];
+    size_t i = 0;
+
+    do {                                        /* Get digits in reverse order */
+        tmp[i++] = (char)('0' + (num % 10));
+        num /= 10;
+    } while (num > 0);
+    while (i > 0) {                             /* Copy them in correct order */
+        *str++ = tmp[--i];
+    }
+    *str = 0;
 }
 
 /**
  * \brief           Create string from signed number
  * \param[in]       num: Number to convert to string
- * \param[out]      str: Pointer to string to save result to
+ * \param[out]      str: Pointer to string to save result to, at least `12` bytes long
  */
 void
 signed_number_to_str(int32_t num, char* str) {
-    sprintf(str, "%d", (signed)num);            /* Currently use sprintf only */
+    if (num < 0) {
+        *str++ = '-';
+        number_to_str((uint32_t)(-(num + 1)) + 1, str); /* Works also for minimal value */
+    } else {
+        number_to_str((uint32_t)num, str);
+    }
 }
 
 /**
@@ -162,17 +259,22 @@ send_ip_mac(const void* d, uint8_t is_ip, uint8_t q, uint8_t c) {
 void
 send_string(const char* str, uint8_t e, uint8_t q, uint8_t c) {
     char special = '\\';
+    size_t i;
     
     GSM_AT_PORT_SEND_COMMA_COND(c);             /* Send comma */
     GSM_AT_PORT_SEND_QUOTE_COND(q);             /* Send quote */
     if (str != NULL) {
         if (e) {                                /* Do we have to escape string? */
             while (*str) {                      /* Go through string */
-                if (*str == ',' || *str == '"' || *str == '\\') {   /* Check for special character */    
+                /* Find run of characters without special ones */
+                for (i = 0; str[i] && str[i] != ',' && str[i] != '"' && str[i] != '\\'; i++) {}
+                GSM_AT_PORT_SEND(str, i);       /* Send plain part at once */
+                str += i;
+                if (*str) {                     /* Stopped on special character */
                     GSM_AT_PORT_SEND_CHR(&special); /* Send special character */
+                    GSM_AT_PORT_SEND_CHR(str);  /* Send character */
+                    str++;
                 }
-                GSM_AT_PORT_SEND_CHR(str);      /* Send character */
-                str++;
             }
         } else {
             GSM_AT_PORT_SEND_STR(str);          /* Send plain string */
@@ -225,7 +327,7 @@ send_port(gsm_port_t port, uint8_t q, uint8_t c) {
  */
 void
 send_signed_number(int32_t num, uint8_t q, uint8_t c) {
-    char str[11];
+    char str[12];
     
     signed_number_to_str(num, str);             /* Convert digit to decimal string */
     
@@ -258,6 +360,19 @@ send_dev_memory(gsm_mem_t mem, uint8_t q, uint8_t c) {
  */
 static void
 send_sms_stat(gsm_sms_status_t status, uint8_t q, uint8_t c) {
+#if GSM_CFG_SMS_PDU
+    uint32_t v;
+    switch (status) {                           /* Numeric status is used in PDU mode */
+        case GSM_SMS_STATUS_UNREAD: v = 0;      break;
+        case GSM_SMS_STATUS_READ:   v = 1;      break;
+        case GSM_SMS_STATUS_UNSENT: v = 2;      break;
+        case GSM_SMS_STATUS_SENT:   v = 3;      break;
+        case GSM_SMS_STATUS_ALL:
+        default:                    v = 4;      break;
+    }
+    send_number(v, 0, c);
+    GSM_UNUSED(q);
+#else /* GSM_CFG_SMS_PDU */
     const char* t = NULL;
     switch (status) {
         case GSM_SMS_STATUS_UNREAD: t = "REC UNREAD";   break;
@@ -268,8 +383,173 @@ send_sms_stat(gsm_sms_status_t status, uint8_t q, uint8_t c) {
         default:                    t = "ALL";          break;
     }
     send_string(t, 0, q, c);
+#endif /* !GSM_CFG_SMS_PDU */
+}
+
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+/**
+ * \brief           Add received hex character to PDU buffer
+ * \param[in]       buff: PDU buffer of \ref GSM_SMS_PDU_MAX_LEN bytes
+ * \param[in,out]   hex: Number of hex digits already in buffer
+ * \param[in]       ch: Received character, non-hex characters are ignored
+ */
+static void
+sms_pdu_add_hex(uint8_t* buff, size_t* hex, uint8_t ch) {
+    if (GSM_CHARISHEXNUM(ch) && *hex < 2 * GSM_SMS_PDU_MAX_LEN) {
+        if (*hex & 0x01) {
+            buff[*hex >> 1] |= GSM_CHARHEXTONUM(ch);
+        } else {
+            buff[*hex >> 1] = GSM_CHARHEXTONUM(ch) << 4;
+        }
+        (*hex)++;
+    }
+}
+
+/**
+ * \brief           Send encoded PDU from buffer as hex string
+ */
+static void
+sms_pdu_send_hex(void) {
+    static const char hex[] = "0123456789ABCDEF";
+    char str[32];
+    size_t i, k = 0;
+
+    for (i = 0; i < sms_pdu_len; i++) {
+        str[k++] = hex[sms_pdu_buff[i] >> 4];
+        str[k++] = hex[sms_pdu_buff[i] & 0x0F];
+        if (k == sizeof(str)) {
+            GSM_AT_PORT_SEND(str, k);
+            k = 0;
+        }
+    }
+    if (k) {
+        GSM_AT_PORT_SEND(str, k);
+    }
+}
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_DIRECT_ACK || __DOXYGEN__
+
+/**
+ * \brief           Send `AT+CNMA` to acknowledge received message to network
+ * \note            Response is not passed to active command
+ */
+static void
+sms_ack_write(void) {
+    sms_ack_pending = 0;
+    sms_ack_skip++;
+    GSM_AT_PORT_SEND_BEGIN();
+    GSM_AT_PORT_SEND_STR("+CNMA");
+    GSM_AT_PORT_SEND_END();
+}
+
+/**
+ * \brief           Acknowledge directly delivered SMS or status report to network
+ *
+ *                  Acknowledgement is sent from processing thread without producer queue.
+ *                  When command is active, it is sent as soon as command finishes
+ */
+static void
+sms_ack(void) {
+    if (gsm.msg != NULL) {
+        sms_ack_pending = 1;                    /* Do not interleave with active command */
+    } else {
+        sms_ack_write();
+    }
 }
 
+#endif /* GSM_CFG_SMS_DIRECT_ACK || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+
+/**
+ * \brief           Process received status report
+ */
+static void
+sms_report_recv(void) {
+#if GSM_CFG_SMS_DIRECT_ACK
+    sms_ack();                                  /* Service stays phase 2+ when direct delivery is disabled */
+#endif /* GSM_CFG_SMS_DIRECT_ACK */
+    gsmi_sms_report_process(&sms_report);
+}
+
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_BODY_SLICE || __DOXYGEN__
+
+/**
+ * \brief           Send slice of SMS body to user and copy it to entry if requested
+ * \param[in]       e: Entry of message
+ * \param[in]       data: Pointer to slice data
+ * \param[in]       len: Length of slice in units of bytes
+ * \param[in]       last: Set to `1` if slice is last part of body
+ */
+static void
+sms_body_send(gsm_sms_entry_t* e, const char* data, size_t len, uint8_t last) {
+    gsm.cb.cb.sms_body.entry = e;
+    gsm.cb.cb.sms_body.data = data;
+    gsm.cb.cb.sms_body.len = len;
+    gsm.cb.cb.sms_body.offset = e->body_length;
+    gsm.cb.cb.sms_body.last = last;
+    gsm.cb.cb.sms_body.copy = 0;
+    gsmi_send_cb(GSM_CB_SMS_BODY);              /* Send to user */
+    if (gsm.cb.cb.sms_body.copy && e->body_length < (sizeof(e->data) - 1)) {
+        size_t n = GSM_MIN(len, sizeof(e->data) - 1 - e->body_length);
+        memcpy(&e->data[e->body_length], data, n);
+        e->length = e->body_length + n;         /* Length of data stored in entry */
+    }
+    e->body_length += len;                      /* Length of entire body, not limited by data field */
+}
+
+/**
+ * \brief           Pass SMS body to user directly from received data
+ *
+ *                  Body ends with `\r\n` sequence, which is not part of any slice
+ *
+ * \param[in]       e: Entry of message
+ * \param[in]       data: Pointer to received data, starting with first unprocessed body character
+ * \param[in]       len: Length of received data in units of bytes
+ * \return          Number of processed bytes, including `\n` at the end of body
+ */
+static size_t
+sms_body_slice(gsm_sms_entry_t* e, const uint8_t* data, size_t len) {
+    const uint8_t* nl;
+    size_t pos = 0, n;
+    uint8_t end = 0;
+
+    while (pos < len && (nl = memchr(&data[pos], '\n', len - pos)) != NULL) {
+        pos = nl - data;
+        if (pos > 0 ? data[pos - 1] == '\r' : sms_body_cr) {
+            end = 1;
+            break;
+        }
+        pos++;                                  /* Single \n is part of body */
+    }
+    n = end ? pos : len;                        /* Number of body bytes in data */
+    if (sms_body_cr) {                          /* Check \r from previous data */
+        sms_body_cr = 0;
+        if (n > 0) {                            /* Not followed by \n, part of body */
+            sms_body_send(e, "\r", 1, 0);
+        }
+    }
+    if (n > 0 && data[n - 1] == '\r') {         /* Possible start of \r\n sequence */
+        n--;
+        sms_body_cr = !end;                     /* Decide when next data arrives */
+    }
+    if (end) {
+        sms_body_send(e, (const char *)data, n, 1);
+        return pos + 1;
+    }
+    if (n > 0) {
+        sms_body_send(e, (const char *)data, n, 0);
+    }
+    return len;
+}
+
+#endif /* GSM_CFG_SMS_BODY_SLICE || __DOXYGEN__ */
+
 #endif /* GSM_CFG_SMS */
 
 /**
@@ -304,6 +584,18 @@ gsmr_t
 gsmi_send_cb(gsm_cb_type_t type) {
     gsm_cb_func_t* link;
     gsm.cb.type = type;                         /* Set callback type to process */
+
+#if GSM_CFG_EVT_QUEUE
+    /*
+     * Copy event to queue and deliver it later,
+     * unless event must be processed immediately
+     */
+    switch (gsmi_evt_queue_put(&gsm.cb)) {
+        case gsmOK: return gsmOK;
+        case gsmERRMEM: return gsmERRMEM;
+        default: break;
+    }
+#endif /* GSM_CFG_EVT_QUEUE */
     
     /*
      * Call callback function for all registered functions
@@ -311,6 +603,15 @@ gsmi_send_cb(gsm_cb_type_t type) {
     for (link = gsm.cb_func; link != NULL; link = link->next) {
         link->fn(&gsm.cb);
     }
+
+    /*
+     * Call only functions subscribed to this event type
+     */
+    if (type < GSM_CB_END) {
+        for (link = gsm.cb_func_type[type]; link != NULL; link = link->next) {
+            link->fn(&gsm.cb);
+        }
+    }
     return gsmOK;
 }
 
@@ -426,31 +727,81 @@ gsmi_parse_received(gsm_recv_t* rcv) {
         }
     }
 
+#if GSM_CFG_SMS_DIRECT_ACK
+    if ((is_ok || is_error) && sms_ack_skip > 0) {
+        sms_ack_skip--;                         /* Response of +CNMA, active command was sent after it */
+        return;
+    }
+#endif /* GSM_CFG_SMS_DIRECT_ACK */
+
     /* Scan received strings which start with '+' */
     if (rcv->data[0] == '+') {
         if (!strncmp(rcv->data, "+CSQ", 4)) {
             gsmi_parse_csq(rcv->data);          /* Parse +CSQ response */
         } else if (!strncmp(rcv->data, "+CREG", 5)) {   /* Check for +CREG indication */
             gsmi_parse_creg(rcv->data, GSM_U8(CMD_IS_CUR(GSM_CMD_CREG_GET)));  /* Parse +CREG response */
+#if GSM_CFG_NETWORK_REG
+        } else if (!strncmp(rcv->data, "+CGREG", 6)) {  /* Check for +CGREG indication */
+            gsmi_parse_reg(rcv->data, GSM_NETWORK_REG_DOMAIN_PS, 0);
+        } else if (!strncmp(rcv->data, "+CEREG", 6)) {  /* Check for +CEREG indication */
+            gsmi_parse_reg(rcv->data, GSM_NETWORK_REG_DOMAIN_EPS, 0);
+#endif /* GSM_CFG_NETWORK_REG */
         } else if (CMD_IS_CUR(GSM_CMD_CPIN_GET) && !strncmp(rcv->data, "+CPIN", 5)) {  /* Check for +CPIN indication for SIM */
             gsmi_parse_cpin(rcv->data, 1);      /* Parse +CPIN response */
         } else if (CMD_IS_CUR(GSM_CMD_COPS_GET) && !strncmp(rcv->data, "+COPS", 5)) {
             gsmi_parse_cops(rcv->data);         /* Parse current +COPS */
+#if GSM_CFG_OPERATOR_CACHE
+        } else if (CMD_IS_CUR(GSM_CMD_COPN) && !strncmp(rcv->data, "+COPN", 5)) {
+            gsmi_parse_copn(rcv->data);         /* Parse +COPN statement */
+#endif /* GSM_CFG_OPERATOR_CACHE */
 #if GSM_CFG_SMS
         } else if (CMD_IS_CUR(GSM_CMD_CMGS) && !strncmp(rcv->data, "+CMGS", 5)) {
             gsmi_parse_cmgs(rcv->data, 1);      /* Parse +CMGS response */
         } else if (CMD_IS_CUR(GSM_CMD_CMGR) && !strncmp(rcv->data, "+CMGR", 5)) {
             if (gsmi_parse_cmgr(rcv->data)) {   /* Parse +CMGR response */
                 gsm.msg->msg.sms_read.read = 2; /* Set read flag and process the data */
+#if GSM_CFG_SMS_PDU
+                sms_pdu_hex = 0;                /* Start new PDU */
+#elif GSM_CFG_SMS_BODY_SLICE
+                sms_body_cr = 0;                /* Start new body */
+#endif /* GSM_CFG_SMS_PDU */
             } else {
                 gsm.msg->msg.sms_read.read = 1; /* Read but ignore data */
             }
         } else if (CMD_IS_CUR(GSM_CMD_CMGL) && !strncmp(rcv->data, "+CMGL", 5)) {
             if (gsmi_parse_cmgl(rcv->data)) {   /* Parse +CMGL response */
                 gsm.msg->msg.sms_list.read = 2; /* Set read flag and process the data */
+#if GSM_CFG_SMS_PDU
+                sms_pdu_hex = 0;                /* Start new PDU */
+#elif GSM_CFG_SMS_BODY_SLICE
+                sms_body_cr = 0;                /* Start new body */
+#endif /* GSM_CFG_SMS_PDU */
             } else {
                 gsm.msg->msg.sms_list.read = 1; /* Read but ignore data */
             }
+#if GSM_CFG_SMS_DIRECT
+        } else if (!strncmp(rcv->data, "+CMT:", 5)) {
+            gsmi_parse_cmt(rcv->data, &sms_direct_entry);   /* Parse +CMT header, message follows in next line */
+            sms_direct_read = 1;
+#if GSM_CFG_SMS_PDU
+            sms_pdu_urc_hex = 0;                /* Start new PDU */
+#endif /* GSM_CFG_SMS_PDU */
+#endif /* GSM_CFG_SMS_DIRECT */
+#if GSM_CFG_SMS_REPORT
+        } else if (!strncmp(rcv->data, "+CDS:", 5)) {
+#if GSM_CFG_SMS_PDU
+            if (gsm.sms.format == 0) {
+                sms_report_read = 1;            /* Report PDU follows in next line */
+                sms_pdu_urc_hex = 0;            /* Start new PDU */
+            } else if (gsmi_parse_cds(rcv->data, &sms_report)) {
+                sms_report_recv();              /* Report in text mode */
+            }
+#else /* GSM_CFG_SMS_PDU */
+            if (gsmi_parse_cds(rcv->data, &sms_report)) {
+                sms_report_recv();
+            }
+#endif /* !GSM_CFG_SMS_PDU */
+#endif /* GSM_CFG_SMS_REPORT */
         } else if (!strncmp(rcv->data, "+CMTI", 5)) {
             gsmi_parse_cmti(rcv->data, 1);      /* Parse +CMTI response with received SMS */
         } else if (CMD_IS_CUR(GSM_CMD_CPMS_GET_OPT) && !strncmp(rcv->data, "+CPMS", 5)) {
@@ -459,6 +810,10 @@ gsmi_parse_received(gsm_recv_t* rcv) {
             gsmi_parse_cpms(rcv->data, 1);      /* Parse +CPMS with SMS memories info */
         } else if (CMD_IS_CUR(GSM_CMD_CPMS_SET) && !strncmp(rcv->data, "+CPMS", 5)) {
             gsmi_parse_cpms(rcv->data, 2);      /* Parse +CPMS with SMS memories info */
+#if GSM_CFG_SMS_REPORT
+        } else if (CMD_IS_CUR(GSM_CMD_CSMP_GET) && !strncmp(rcv->data, "+CSMP", 5)) {
+            gsmi_parse_csmp(rcv->data);         /* Parse +CSMP with text mode parameters */
+#endif /* GSM_CFG_SMS_REPORT */
 #endif /* GSM_CFG_SMS */
 #if GSM_CFG_CALL
         } else if (!strncmp(rcv->data, "+CLCC", 5)) {
@@ -502,6 +857,12 @@ gsmi_parse_received(gsm_recv_t* rcv) {
         if (CMD_IS_CUR(GSM_CMD_CMGS) && is_ok) {
             /* At this point we have to wait for "> " to send data */
         } else if (CMD_IS_CUR(GSM_CMD_CMGS) && is_error) {
+#if GSM_CFG_SMS_OUTBOX
+            if (!strncmp(rcv->data, "+CMS ERROR: ", 12)) {
+                const char* tmp = &rcv->data[12];
+                gsm.msg->msg.sms_send.cms_err = (uint16_t)gsmi_parse_number(&tmp);  /* Save error code for retry decision */
+            }
+#endif /* GSM_CFG_SMS_OUTBOX */
             gsmi_send_cb(GSM_CB_SMS_SEND_ERROR);    /* SIM card event */
         }
 #endif /* GSM_CFG_SMS */
@@ -533,6 +894,9 @@ gsmi_parse_received(gsm_recv_t* rcv) {
             if (CMD_IS_DEF(GSM_CMD_RESET)) {
                 if (gsm.msg->cmd == GSM_CMD_IDLE) {
                     gsmi_send_cb(GSM_CB_RESET_FINISH);  /* Send to upper layer */
+#if GSM_CFG_SMS_OUTBOX
+                    gsmi_sms_outbox_resume(1);  /* Send unfinished outbox messages again */
+#endif /* GSM_CFG_SMS_OUTBOX */
                 }
             }
 
@@ -552,6 +916,11 @@ gsmi_parse_received(gsm_recv_t* rcv) {
          * from user thread and start with next command
          */
         if (res != gsmCONT) {                   /* Do we have to continue to wait for command? */
+#if GSM_CFG_SMS_DIRECT_ACK
+            if (sms_ack_pending) {              /* Acknowledge before next command starts */
+                sms_ack_write();
+            }
+#endif /* GSM_CFG_SMS_DIRECT_ACK */
             gsm_sys_sem_release(&gsm.sem_sync); /* Release semaphore */
         }
     }
@@ -627,36 +996,130 @@ gsmi_process(const void* data, size_t data_len) {
                 gsmi_parse_cops_scan(ch, 0);    /* Parse character by character */
             }
 #if GSM_CFG_SMS
+#if GSM_CFG_SMS_DIRECT
+        } else if (sms_direct_read) {           /* Message line of +CMT */
+            gsm_sms_entry_t* e = &sms_direct_entry;
+#if GSM_CFG_SMS_PDU
+            sms_pdu_add_hex(sms_pdu_urc_buff, &sms_pdu_urc_hex, ch);  /* Collect PDU octets */
+#else /* GSM_CFG_SMS_PDU */
+            if (e->length < (sizeof(e->data) - 1)) {
+                e->data[e->length++] = ch;
+            }
+#endif /* !GSM_CFG_SMS_PDU */
+            if (ch == '\n' && ch_prev1 == '\r') {
+#if GSM_CFG_SMS_PDU
+                gsm_sms_pdu_decode(sms_pdu_urc_buff, sms_pdu_urc_hex >> 1, e);  /* Decode entry from PDU */
+                sms_pdu_urc_hex = 0;
+#endif /* GSM_CFG_SMS_PDU */
+                sms_direct_read = 0;
+#if GSM_CFG_SMS_DIRECT_ACK
+                sms_ack();                      /* Acknowledge message to network */
+#endif /* GSM_CFG_SMS_DIRECT_ACK */
+                gsm.cb.cb.sms_recv_direct.entry = e;
+                gsmi_send_cb(GSM_CB_SMS_RECV_DIRECT);   /* Send to user */
+#if GSM_CFG_SMS_ROUTER
+                gsm_sms_router_dispatch(e);     /* Send to handler of sender route */
+#endif /* GSM_CFG_SMS_ROUTER */
+#if GSM_CFG_SMS_CONCAT
+                gsmi_sms_concat_process(e);     /* Check for concatenated message part */
+#endif /* GSM_CFG_SMS_CONCAT */
+            }
+#endif /* GSM_CFG_SMS_DIRECT */
+#if GSM_CFG_SMS_REPORT && GSM_CFG_SMS_PDU
+        } else if (sms_report_read) {           /* PDU line of +CDS */
+            sms_pdu_add_hex(sms_pdu_urc_buff, &sms_pdu_urc_hex, ch);  /* Collect PDU octets */
+            if (ch == '\n' && ch_prev1 == '\r') {
+                sms_report_read = 0;
+                memset(&sms_report, 0x00, sizeof(sms_report));
+                if (gsm_sms_pdu_decode_report(sms_pdu_urc_buff, sms_pdu_urc_hex >> 1, &sms_report)) {
+                    sms_report_recv();
+                }
+                sms_pdu_urc_hex = 0;
+            }
+#endif /* GSM_CFG_SMS_REPORT && GSM_CFG_SMS_PDU */
         } else if (CMD_IS_CUR(GSM_CMD_CMGR) && gsm.msg->msg.sms_read.read) {
             gsm_sms_entry_t* e = gsm.msg->msg.sms_read.entry;
             if (gsm.msg->msg.sms_read.read == 2) {  /* Read only if set to 2 */
                 if (e != NULL) {                /* Check if valid entry */
+#if GSM_CFG_SMS_PDU
+                    sms_pdu_add_hex(sms_pdu_buff, &sms_pdu_hex, ch);  /* Collect PDU octets */
+#elif GSM_CFG_SMS_BODY_SLICE
+                    size_t n = sms_body_slice(e, d - 1, d_len + 1);
+                    if (n > 1) {                /* Skip processed body */
+                        d += n - 1;
+                        d_len -= n - 1;
+                        ch_prev1 = d[-2];
+                        ch = d[-1];
+                    }
+#else /* GSM_CFG_SMS_PDU */
                     if (e->length < (sizeof(e->data) - 1)) {
                         e->data[e->length++] = ch;
                     }
+#endif /* !GSM_CFG_SMS_PDU */
                 } else {
                     gsm.msg->msg.sms_read.read = 1; /* Read but ignore data */
                 }
             }
             if (ch == '\n' && ch_prev1 == '\r') {
                 if (gsm.msg->msg.sms_read.read == 2) {
+#if GSM_CFG_SMS_PDU
+                    gsm_sms_pdu_decode(sms_pdu_buff, sms_pdu_hex >> 1, e);  /* Decode entry from PDU */
+                    sms_pdu_hex = 0;
+#endif /* GSM_CFG_SMS_PDU */
                     gsm.cb.cb.sms_read.entry = e;
                     gsmi_send_cb(GSM_CB_SMS_READ);
+#if GSM_CFG_SMS_MIRROR
+                    gsmi_sms_mirror_update(e, gsm.msg->msg.sms_read.update);
+#endif /* GSM_CFG_SMS_MIRROR */
                 }
                 gsm.msg->msg.sms_read.read = 0;
             }
         } else if (CMD_IS_CUR(GSM_CMD_CMGL) && gsm.msg->msg.sms_list.read) {
             if (gsm.msg->msg.sms_list.read == 2) {
+#if GSM_CFG_SMS_PDU
+                sms_pdu_add_hex(sms_pdu_buff, &sms_pdu_hex, ch);  /* Collect PDU octets */
+#elif GSM_CFG_SMS_BODY_SLICE
+                size_t n = sms_body_slice(&gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.ei], d - 1, d_len + 1);
+                if (n > 1) {                    /* Skip processed body */
+                    d += n - 1;
+                    d_len -= n - 1;
+                    ch_prev1 = d[-2];
+                    ch = d[-1];
+                }
+#else /* GSM_CFG_SMS_PDU */
                 gsm_sms_entry_t* e = &gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.ei];
                 if (e->length < (sizeof(e->data) - 1)) {
                     e->data[e->length++] = ch;
                 }
+#endif /* !GSM_CFG_SMS_PDU */
             }
             if (ch == '\n' && ch_prev1 == '\r') {
                 if (gsm.msg->msg.sms_list.read == 2) {
-                    gsm.msg->msg.sms_list.ei++; /* Go to next entry */
-                    if (gsm.msg->msg.sms_list.er != NULL) { /* Check and update user variable */
-                        *gsm.msg->msg.sms_list.er = gsm.msg->msg.sms_list.ei;
+#if GSM_CFG_SMS_PDU
+                    gsm_sms_pdu_decode(sms_pdu_buff, sms_pdu_hex >> 1, &gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.ei]);
+                    sms_pdu_hex = 0;
+#endif /* GSM_CFG_SMS_PDU */
+#if GSM_CFG_SMS_MIRROR
+                    gsmi_sms_mirror_update(&gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.ei], gsm.msg->msg.sms_list.update);
+#endif /* GSM_CFG_SMS_MIRROR */
+#if GSM_CFG_SMS_CONCAT && GSM_CFG_SMS_DRAIN
+                    if (gsm.msg->msg.sms_list.drain) {  /* Assemble only received messages, not plain list */
+                        gsmi_sms_concat_process(&gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.ei]);
+                    }
+#endif /* GSM_CFG_SMS_CONCAT && GSM_CFG_SMS_DRAIN */
+                    if (gsm.msg->msg.sms_list.fn != NULL) { /* Pass entry to user and reuse buffer */
+                        gsm.msg->msg.sms_list.en++;
+                        if (gsm.msg->msg.sms_list.fn(gsm.msg->msg.sms_list.entries, gsm.msg->msg.sms_list.fn_arg) != gsmOK) {
+                            gsm.msg->msg.sms_list.stop = 1; /* Ignore remaining entries */
+                        }
+                        if (gsm.msg->msg.sms_list.er != NULL) {
+                            *gsm.msg->msg.sms_list.er = gsm.msg->msg.sms_list.en;
+                        }
+                    } else {
+                        gsm.msg->msg.sms_list.ei++; /* Go to next entry */
+                        if (gsm.msg->msg.sms_list.er != NULL) { /* Check and update user variable */
+                            *gsm.msg->msg.sms_list.er = gsm.msg->msg.sms_list.ei;
+                        }
                     }
                 }
                 gsm.msg->msg.sms_list.read = 0;
@@ -700,7 +1163,11 @@ gsmi_process(const void* data, size_t data_len) {
                     if (ch_prev2 == '\n' && ch_prev1 == '>' && ch == ' ') {
 #if GSM_CFG_SMS
                         if (CMD_IS_CUR(GSM_CMD_CMGS)) {    /* Send SMS? */
+#if GSM_CFG_SMS_PDU
+                            sms_pdu_send_hex(); /* Send PDU encoded with command */
+#else /* GSM_CFG_SMS_PDU */
                             GSM_AT_PORT_SEND(gsm.msg->msg.sms_send.text, strlen(gsm.msg->msg.sms_send.text));
+#endif /* !GSM_CFG_SMS_PDU */
                             GSM_AT_PORT_SEND_CTRL_Z();
                         }
 #endif /* GSM_CFG_SMS */
@@ -708,6 +1175,9 @@ gsmi_process(const void* data, size_t data_len) {
                         if (RECV_LEN() > 5 && !strncmp(recv_buff.data, "+COPS:", 5)) {
                             RECV_RESET();       /* Reset incoming buffer */
                             gsmi_parse_cops_scan(0, 1); /* Reset parser state */
+#if GSM_CFG_OPERATOR_CACHE
+                            gsmi_operator_cache_start();
+#endif /* GSM_CFG_OPERATOR_CACHE */
                             gsm.msg->msg.cops_scan.read = 1;    /* Start reading incoming bytes */
                         }
                     }
@@ -733,6 +1203,202 @@ gsmi_process(const void* data, size_t data_len) {
     return gsmOK;
 }
 
+/**
+ * \brief           Get next command from steps table of message
+ *
+ *                  Steps with satisfied `is_done_fn` function are skipped.
+ *                  Last step in table is always executed
+ *
+ * \param[in]       msg: Pointer to message with steps table
+ * \param[in]       first: Set to `1` to start from beginning of table or `0` to continue after active step
+ * \return          Next command to execute or \ref GSM_CMD_IDLE if there are no more steps
+ */
+gsm_cmd_t
+gsmi_cmd_steps_next(gsm_msg_t* msg, uint8_t first) {
+    uint8_t i;
+
+    if (msg->steps == NULL) {
+        return GSM_CMD_IDLE;
+    }
+    for (i = first ? 0 : msg->step + 1; i < msg->steps_len; i++) {
+        if (i == msg->steps_len - 1 ||          /* Last step is always executed */
+            msg->steps[i].is_done_fn == NULL || !msg->steps[i].is_done_fn(msg)) {
+            msg->step = i;                      /* Set new active step */
+            return msg->steps[i].cmd;
+        }
+    }
+    return GSM_CMD_IDLE;
+}
+
+/**
+ * \brief           Invalidate cached device state used to skip sub-command steps
+ * \note            Must be called when device is reset or its state is not known anymore
+ */
+void
+gsmi_invalidate_cache(void) {
+#if GSM_CFG_SMS
+    size_t i;
+    for (i = 0; i < GSM_ARRAYSIZE(gsm.sms.mem); i++) {
+        gsm.sms.mem[i].current = GSM_MEM_UNKNOWN;
+    }
+    gsm.sms.format = GSM_SMS_FORMAT_UNKNOWN;
+#if GSM_CFG_SMS_DIRECT
+    gsm.sms.direct = 0;                         /* Device reports messages with +CMTI after reset */
+    sms_direct_read = 0;
+#endif /* GSM_CFG_SMS_DIRECT */
+#if GSM_CFG_SMS_REPORT
+    gsm.sms.report = 0;                         /* Status reports are not requested after reset */
+#if GSM_CFG_SMS_PDU
+    sms_report_read = 0;
+#endif /* GSM_CFG_SMS_PDU */
+#endif /* GSM_CFG_SMS_REPORT */
+#if GSM_CFG_SMS_MIRROR
+    gsmi_sms_mirror_invalidate();               /* Storage content is not known anymore */
+#endif /* GSM_CFG_SMS_MIRROR */
+#endif /* GSM_CFG_SMS */
+#if GSM_CFG_PHONEBOOK
+    gsm.pb.mem.current = GSM_MEM_UNKNOWN;
+#if GSM_CFG_PB_CACHE
+    gsmi_pb_cache_invalidate();                 /* Phonebook content is not known anymore */
+#endif /* GSM_CFG_PB_CACHE */
+#endif /* GSM_CFG_PHONEBOOK */
+#if GSM_CFG_NETWORK_REG
+    gsmi_network_reg_reset();                   /* Registration is reported again after reset */
+#endif /* GSM_CFG_NETWORK_REG */
+}
+
+#if GSM_CFG_SMS || __DOXYGEN__
+
+/**
+ * \brief           Get memory used by SMS read, delete or list message
+ * \param[in]       msg: Pointer to message
+ * \return          Memory for operation, \ref GSM_MEM_CURRENT is replaced with current device memory
+ */
+gsm_mem_t
+gsmi_sms_get_op_mem(gsm_msg_t* msg) {
+    gsm_mem_t mem = GSM_MEM_CURRENT;
+    if (msg->cmd_def == GSM_CMD_CMGR) {
+        mem = msg->msg.sms_read.mem;
+    } else if (msg->cmd_def == GSM_CMD_CMGD || msg->cmd_def == GSM_CMD_CMGDA) {
+        mem = msg->msg.sms_delete.mem;
+    } else if (msg->cmd_def == GSM_CMD_CMGL) {
+        mem = msg->msg.sms_list.mem;
+    }
+    return mem == GSM_MEM_CURRENT ? gsm.sms.mem[0].current : mem;
+}
+
+/**
+ * \brief           Get SMS message format required by message
+ * \param[in]       msg: Pointer to message
+ * \return          `0` for PDU or `1` for text mode
+ */
+uint8_t
+gsmi_sms_get_op_format(gsm_msg_t* msg) {
+    if (msg->cmd_def == GSM_CMD_CMGS) {
+        return !!msg->msg.sms_send.format;
+    } else if (msg->cmd_def == GSM_CMD_CMGR) {
+        return !!msg->msg.sms_read.format;
+    } else if (msg->cmd_def == GSM_CMD_CMGL) {
+        return !!msg->msg.sms_list.format;
+    } else if (msg->cmd_def == GSM_CMD_CMGDA) {
+        return !!msg->msg.sms_delete.format;
+    } else if (msg->cmd_def == GSM_CMD_CNMI) {
+        return !!msg->msg.sms_cnmi.format;
+    }
+    return 1;                                   /* Force text mode */
+}
+
+#endif /* GSM_CFG_SMS || __DOXYGEN__ */
+
+#if GSM_CFG_PHONEBOOK || __DOXYGEN__
+
+/**
+ * \brief           Get memory used by phonebook message
+ * \param[in]       msg: Pointer to message
+ * \return          Memory for operation, \ref GSM_MEM_CURRENT is replaced with current device memory
+ */
+gsm_mem_t
+gsmi_pb_get_op_mem(gsm_msg_t* msg) {
+    gsm_mem_t mem = GSM_MEM_CURRENT;
+    if (msg->cmd_def == GSM_CMD_CPBW_SET) {
+        mem = msg->msg.pb_write.mem;
+    } else if (msg->cmd_def == GSM_CMD_CPBR) {
+        mem = msg->msg.pb_list.mem;
+    } else if (msg->cmd_def == GSM_CMD_CPBF) {
+        mem = msg->msg.pb_search.mem;
+#if GSM_CFG_PB_SYNC
+    } else if (msg->cmd_def == GSM_CMD_PHONEBOOK_SYNC) {
+        mem = msg->msg.pb_sync.mem;
+#endif /* GSM_CFG_PB_SYNC */
+    }
+    return mem == GSM_MEM_CURRENT ? gsm.pb.mem.current : mem;
+}
+
+/**
+ * \brief           Move paged `+CPBR` read to next page
+ *
+ *                  Read is finished when last position of memory is read
+ *                  or when all used entries are received
+ *
+ * \param[in,out]   start_index: First position of page, moved to first position of next page
+ * \param[in]       page: Number of positions read with single command
+ * \param[in]       read: Number of entries received so far
+ * \return          `1` if next page shall be read, `0` otherwise
+ */
+uint8_t
+gsmi_pb_page_next(size_t* start_index, size_t page, size_t read) {
+    *start_index += page;
+    return *start_index <= gsm.pb.mem.total && read < gsm.pb.mem.used;
+}
+
+#endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
+
+/**
+ * \brief           Update cached device state after sub-command finished
+ * \param[in]       msg: Pointer to current message
+ * \param[in]       is_ok: Status whether last command result was OK
+ */
+static void
+gsmi_update_cache(gsm_msg_t* msg, uint8_t is_ok) {
+#if GSM_CFG_SMS
+    if (CMD_IS_CUR(GSM_CMD_CPMS_SET)) {
+        if (!is_ok) {                           /* Memory state is not known after error */
+            size_t i;
+            for (i = 0; i < GSM_ARRAYSIZE(gsm.sms.mem); i++) {
+                gsm.sms.mem[i].current = GSM_MEM_UNKNOWN;
+            }
+        } else if (CMD_IS_DEF(GSM_CMD_CPMS_SET)) {
+            size_t i;
+            for (i = 0; i < GSM_ARRAYSIZE(gsm.sms.mem); i++) {
+                if (msg->msg.sms_memory.mem[i] != GSM_MEM_CURRENT) {
+                    gsm.sms.mem[i].current = msg->msg.sms_memory.mem[i];
+                }
+            }
+        } else {
+            gsm.sms.mem[0].current = gsmi_sms_get_op_mem(msg);
+        }
+    } else if (CMD_IS_CUR(GSM_CMD_CMGF)) {
+        gsm.sms.format = is_ok ? gsmi_sms_get_op_format(msg) : GSM_SMS_FORMAT_UNKNOWN;
+#if GSM_CFG_SMS_DIRECT || GSM_CFG_SMS_REPORT
+    } else if (CMD_IS_CUR(GSM_CMD_CNMI) && is_ok) {
+#if GSM_CFG_SMS_DIRECT
+        gsm.sms.direct = msg->msg.sms_cnmi.mt == 2;
+#endif /* GSM_CFG_SMS_DIRECT */
+#if GSM_CFG_SMS_REPORT
+        gsm.sms.report = msg->msg.sms_cnmi.ds == 1;
+#endif /* GSM_CFG_SMS_REPORT */
+#endif /* GSM_CFG_SMS_DIRECT || GSM_CFG_SMS_REPORT */
+    }
+#endif /* GSM_CFG_SMS */
+#if GSM_CFG_PHONEBOOK
+    if (CMD_IS_CUR(GSM_CMD_CPBS_SET)) {
+        gsm.pb.mem.current = is_ok ? gsmi_pb_get_op_mem(msg) : GSM_MEM_UNKNOWN;
+    }
+#endif /* GSM_CFG_PHONEBOOK */
+    GSM_UNUSED(msg);
+    GSM_UNUSED(is_ok);
+}
+
 /**
  * \brief           Process current command with known execution status and start another if necessary
  * \param[in]       msg: Pointer to current message
@@ -743,9 +1409,12 @@ gsmi_process(const void* data, size_t data_len) {
 static gsmr_t
 gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t is_ok, uint16_t is_error) {
     gsm_cmd_t n_cmd = GSM_CMD_IDLE;
+
+    gsmi_update_cache(msg, is_ok);              /* Keep cached device state in sync */
     if (CMD_IS_DEF(GSM_CMD_RESET)) {
         switch (CMD_GET_CUR()) {                /* Check current command */
             case GSM_CMD_RESET: {
+                gsmi_invalidate_cache();        /* Device state is not known after reset */
                 n_cmd = GSM_CFG_AT_ECHO ? GSM_CMD_ATE1 : GSM_CMD_ATE0;  /* Set ECHO mode */
                 gsm_delay(3000);                /* Delay for some time before we can continue after reset */
                 break;
@@ -779,6 +1448,16 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t is_ok, uint16_t is_error) {
                  */
                 gsmi_send_cb(GSM_CB_DEVICE_IDENTIFIED);
 
+#if GSM_CFG_NETWORK_REG
+                n_cmd = GSM_CMD_CGREG_SET;      /* Enable unsolicited code for CGREG */
+                break;
+            }
+            case GSM_CMD_CGREG_SET: {
+                n_cmd = GSM_CMD_CEREG_SET;      /* Enable unsolicited code for CEREG, error is ignored on non-LTE devices */
+                break;
+            }
+            case GSM_CMD_CEREG_SET: {
+#endif /* GSM_CFG_NETWORK_REG */
                 n_cmd = GSM_CMD_CREG_SET;       /* Enable unsolicited code for CREG */
                 break;
             }
@@ -801,6 +1480,14 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t is_ok, uint16_t is_error) {
             gsm.cb.cb.operator_current.operator_current = &gsm.network.curr_operator;
             gsmi_send_cb(GSM_CB_OPERATOR_CURRENT);
         }
+    } else if (CMD_IS_DEF(GSM_CMD_COPS_GET_OPT)) {
+#if GSM_CFG_OPERATOR_CACHE
+        gsmi_operator_cache_finish(is_ok && !msg->msg.cops_scan.stop && msg->msg.cops_scan.opsi <= msg->msg.cops_scan.opsl);
+    } else if (CMD_IS_DEF(GSM_CMD_COPN)) {
+        if (gsmi_operator_names_finish(is_ok) != gsmOK) {
+            is_ok = 0;
+        }
+#endif /* GSM_CFG_OPERATOR_CACHE */
 #if GSM_CFG_SMS
     } else if (CMD_IS_DEF(GSM_CMD_SMS_ENABLE)) {
         switch (CMD_GET_CUR()) {
@@ -818,45 +1505,121 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t is_ok, uint16_t is_error) {
             gsm.sms.enabled = n_cmd == GSM_CMD_IDLE;    /* Set enabled status */
             gsm.cb.cb.sms_enable.status = gsm.sms.enabled ? gsmOK : gsmERR;
             gsmi_send_cb(GSM_CB_SMS_ENABLE);    /* Send to user */
+#if GSM_CFG_SMS_OUTBOX
+            if (gsm.sms.enabled) {
+                gsmi_sms_outbox_resume(0);      /* Outbox may have messages waiting for SMS to be enabled */
+            }
+#endif /* GSM_CFG_SMS_OUTBOX */
         }    
-    } else if (CMD_IS_DEF(GSM_CMD_CMGS)) {      /* Send SMS default command */
-        if (CMD_IS_CUR(GSM_CMD_CMGF) && is_ok) {/* Set message format current command*/
-            n_cmd = GSM_CMD_CMGS;               /* Now send actual message */
+    } else if (CMD_IS_DEF(GSM_CMD_CMGS) && msg->msg.sms_send.batch != NULL) {  /* Send batch of SMS */
+        if (CMD_IS_CUR(GSM_CMD_CMGS)) {
+            msg->msg.sms_send.batch[msg->msg.sms_send.batch_i].res = is_ok ? gsmOK : gsmERR;
+            is_ok = 1;                          /* Result is reported per message, batch itself continues */
+            if (++msg->msg.sms_send.batch_i < msg->msg.sms_send.batch_len
+                && sms_send_prepare(msg) == gsmOK) {
+                n_cmd = GSM_CMD_CMGS;           /* Continue with next message, also after failed one */
+            } else if (msg->msg.sms_send.batch_len > 1 && msg->msg.sms_send.cmms) {
+                msg->msg.sms_send.cmms = 0;
+                n_cmd = GSM_CMD_CMMS_SET;       /* Release link after last message */
+            }
+        } else if (CMD_IS_CUR(GSM_CMD_CMMS_SET)) {
+            if (msg->msg.sms_send.cmms && !is_ok) {
+                msg->msg.sms_send.cmms = 0;     /* Link is not kept open, nothing to release at the end */
+                ++msg->step;                    /* Continue with send step */
+                n_cmd = GSM_CMD_CMGS;           /* Link control is optional, send messages anyway */
+            } else if (!msg->msg.sms_send.cmms) {
+                is_ok = 1;                      /* Failed link release does not affect sent messages */
+            }
+        }
+#if GSM_CFG_SMS_PDU
+    } else if (CMD_IS_DEF(GSM_CMD_CMGS) && msg->msg.sms_send.is_long) {    /* Send long SMS */
+        uint8_t done = !is_ok;
+
+        if (CMD_IS_CUR(GSM_CMD_CMGS) && is_ok) {
+            done = 1;
+            if (++msg->msg.sms_send.part < msg->msg.sms_send.parts) {
+                msg->msg.sms_send.part_pos += msg->msg.sms_send.part_len;
+                msg->msg.sms_send.part_len = gsm_sms_pdu_get_text_fit(
+                    &msg->msg.sms_send.text[msg->msg.sms_send.part_pos],
+                    msg->msg.sms_send.len - msg->msg.sms_send.part_pos, msg->msg.sms_send.coding,
+                    msg->msg.sms_send.coding == GSM_SMS_CODING_UCS2 ? GSM_SMS_PDU_CONCAT_UCS2_LEN : GSM_SMS_PDU_CONCAT_7BIT_LEN);
+                n_cmd = GSM_CMD_CMGS;           /* Send next part */
+                done = 0;
+            } else if (msg->msg.sms_send.cmms) {
+                msg->msg.sms_send.cmms = 0;
+                n_cmd = GSM_CMD_CMMS_SET;       /* Release link after last part */
+                done = 0;
+            }
+        } else if (CMD_IS_CUR(GSM_CMD_CMMS_SET)) {
+            if (msg->msg.sms_send.cmms) {       /* Link control is optional, send parts anyway */
+                if (!is_ok) {
+                    msg->msg.sms_send.cmms = 0; /* Link is not kept open, nothing to release at the end */
+                    ++msg->step;                /* Continue with send step */
+                    n_cmd = GSM_CMD_CMGS;
+                }
+                done = 0;
+            } else {
+                done = 1;                       /* Failed link release does not affect sent parts */
+            }
+        }
+        if (done) {
+            is_ok = msg->msg.sms_send.part == msg->msg.sms_send.parts;
+            gsm.cb.cb.sms_send_long.num = msg->msg.sms_send.num;
+            gsm.cb.cb.sms_send_long.parts = msg->msg.sms_send.parts;
+            gsm.cb.cb.sms_send_long.sent = msg->msg.sms_send.part;
+            gsm.cb.cb.sms_send_long.status = is_ok ? gsmOK : gsmERR;
+            gsmi_send_cb(GSM_CB_SMS_SEND_LONG); /* Send to user */
         }
+#endif /* GSM_CFG_SMS_PDU */
     } else if (CMD_IS_DEF(GSM_CMD_CMGR)) {      /* Read SMS message */
-        if (CMD_IS_CUR(GSM_CMD_CPMS_GET) && is_ok) {
-            n_cmd = GSM_CMD_CPMS_SET;           /* Set memory */
-        } else if (CMD_IS_CUR(GSM_CMD_CPMS_SET) && is_ok) {
-            n_cmd = GSM_CMD_CMGF;               /* Set text mode */
-        } else if (CMD_IS_CUR(GSM_CMD_CMGF) && is_ok) {/* Set message format current command*/
-            n_cmd = GSM_CMD_CMGR;               /* Start message read */
-        } else if (CMD_IS_CUR(GSM_CMD_CMGR) && is_ok) {
+        if (CMD_IS_CUR(GSM_CMD_CMGR) && is_ok) {
             msg->msg.sms_read.mem = gsm.sms.mem[0].current; /* Set current memory */
         }
-    } else if (CMD_IS_DEF(GSM_CMD_CMGD)) {      /* Delete SMS message*/
-        if (CMD_IS_CUR(GSM_CMD_CPMS_GET) && is_ok) {
-            n_cmd = GSM_CMD_CPMS_SET;           /* Set memory */
-        } else if (CMD_IS_CUR(GSM_CMD_CPMS_SET) && is_ok) {
-            n_cmd = GSM_CMD_CMGD;               /* Delete message */
+    } else if (CMD_IS_DEF(GSM_CMD_CMGD)) {      /* Delete SMS message */
+        if (CMD_IS_CUR(GSM_CMD_CMGD) && is_ok) {
+#if GSM_CFG_SMS_MIRROR
+            if (msg->msg.sms_delete.delflag) {
+                gsmi_sms_mirror_delete_status(gsmi_sms_get_op_mem(msg), msg->msg.sms_delete.status);
+            } else {
+                gsmi_sms_mirror_delete(gsmi_sms_get_op_mem(msg), msg->msg.sms_delete.pos);
+            }
+#endif /* GSM_CFG_SMS_MIRROR */
+#if GSM_CFG_SMS_WATERMARK
+            if (!msg->msg.sms_delete.delflag) { /* Usage after delete flag is updated with CPMS_GET step */
+                gsmi_sms_watermark_update(gsmi_sms_get_op_mem(msg), -1);
+            }
+#endif /* GSM_CFG_SMS_WATERMARK */
+        }
+#if GSM_CFG_SMS_DRAIN
+        if (CMD_IS_CUR(GSM_CMD_CMGD) && ++msg->msg.sms_delete.drain_idx < msg->msg.sms_delete.drain_cnt) {
+            msg->msg.sms_delete.pos = msg->msg.sms_delete.drain_pos[msg->msg.sms_delete.drain_idx];
+            n_cmd = GSM_CMD_CMGD;               /* Delete next drained message, also after failed delete */
         }
+#endif /* GSM_CFG_SMS_DRAIN */
+#if GSM_CFG_SMS_MIRROR
+    } else if (CMD_IS_DEF(GSM_CMD_CMGDA)) {     /* Delete SMS messages by type */
+        if (CMD_IS_CUR(GSM_CMD_CMGDA) && is_ok) {
+            gsmi_sms_mirror_delete_status(gsmi_sms_get_op_mem(msg), msg->msg.sms_delete.status);
+        }
+#endif /* GSM_CFG_SMS_MIRROR */
     } else if (CMD_IS_DEF(GSM_CMD_CMGL)) {      /* List SMS messages */
-        if (CMD_IS_CUR(GSM_CMD_CPMS_GET) && is_ok) {
-            n_cmd = GSM_CMD_CPMS_SET;           /* Set memory */
-        } else if (CMD_IS_CUR(GSM_CMD_CPMS_SET) && is_ok) {
-            n_cmd = GSM_CMD_CMGF;               /* Set text format */
-        } else if (CMD_IS_CUR(GSM_CMD_CMGF) && is_ok) {
-            n_cmd = GSM_CMD_CMGL;               /* List messages */
-        } else if (CMD_IS_CUR(GSM_CMD_CMGL)) {
+        if (CMD_IS_CUR(GSM_CMD_CMGL)) {
+#if GSM_CFG_SMS_MIRROR
+            if (msg->msg.sms_list.mirror) {
+                gsmi_sms_mirror_sync_finish(gsm.sms.mem[0].current, is_ok);
+            }
+#endif /* GSM_CFG_SMS_MIRROR */
             gsm.cb.cb.sms_list.mem = gsm.sms.mem[0].current;
-            gsm.cb.cb.sms_list.entries = gsm.msg->msg.sms_list.entries;
-            gsm.cb.cb.sms_list.size = gsm.msg->msg.sms_list.ei;
+            if (gsm.msg->msg.sms_list.fn != NULL) { /* Entries were already passed to callback */
+                gsm.cb.cb.sms_list.entries = NULL;
+                gsm.cb.cb.sms_list.size = gsm.msg->msg.sms_list.en;
+            } else {
+                gsm.cb.cb.sms_list.entries = gsm.msg->msg.sms_list.entries;
+                gsm.cb.cb.sms_list.size = gsm.msg->msg.sms_list.ei;
+            }
             gsm.cb.cb.sms_list.err = is_ok ? gsmOK : gsmERR;
             gsmi_send_cb(GSM_CB_SMS_LIST);
         }
-    } else if (CMD_IS_DEF(GSM_CMD_CPMS_SET)) {  /* Set preferred memory */
-        if (CMD_IS_CUR(GSM_CMD_CPMS_GET) && is_ok) {
-            n_cmd = GSM_CMD_CPMS_SET;           /* Now set the command */
-        }
 #endif /* GSM_CFG_SMS */
     } else if (CMD_IS_DEF(GSM_CMD_SIM_PROCESS_BASIC_CMDS)) {
         switch (CMD_GET_CUR()) {
@@ -886,30 +1649,57 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t is_ok, uint16_t is_error) {
         gsm.pb.enabled = is_ok;                 /* Set enabled status */
         gsm.cb.cb.pb_enable.status = gsm.pb.enabled ? gsmOK : gsmERR;
         gsmi_send_cb(GSM_CB_PB_ENABLE);         /* Send to user */
-    } else if (CMD_IS_DEF(GSM_CMD_CPBW_SET)) {  /* Write phonebook entry */
-        if (CMD_IS_CUR(GSM_CMD_CPBS_GET) && is_ok) {/* Get current memory */
-            n_cmd = GSM_CMD_CPBS_SET;           /* Set current memory */
-        } else if (CMD_IS_CUR(GSM_CMD_CPBS_SET) && is_ok) {
-            n_cmd = GSM_CMD_CPBW_SET;           /* Write entry to phonebook */
+#if GSM_CFG_PB_SYNC
+    } else if (CMD_IS_DEF(GSM_CMD_PHONEBOOK_SYNC)) {
+        if (CMD_IS_CUR(GSM_CMD_CPBR) || CMD_IS_CUR(GSM_CMD_CPBW_SET) || !is_ok) {
+            n_cmd = gsmi_pb_sync_next(msg, is_ok);  /* Read next range or write next diff entry */
+            if (n_cmd == GSM_CMD_IDLE) {
+                is_ok = msg->msg.pb_sync.res == gsmOK;
+            }
         }
+#endif /* GSM_CFG_PB_SYNC */
+#if GSM_CFG_PB_CACHE
+    } else if (CMD_IS_DEF(GSM_CMD_CPBW_SET)) {
+        if (CMD_IS_CUR(GSM_CMD_CPBW_SET) && is_ok) {    /* Keep cache coherent with device */
+            gsmi_pb_cache_update(gsmi_pb_get_op_mem(msg), msg->msg.pb_write.pos, msg->msg.pb_write.del ? NULL : msg->msg.pb_write.name, msg->msg.pb_write.num, msg->msg.pb_write.type);
+        }
+#endif /* GSM_CFG_PB_CACHE */
     } else if (CMD_IS_DEF(GSM_CMD_CPBR)) {
-        if (CMD_IS_CUR(GSM_CMD_CPBS_GET) && is_ok) {/* Get current memory */
-            n_cmd = GSM_CMD_CPBS_SET;           /* Set current memory */
-        } else if (CMD_IS_CUR(GSM_CMD_CPBS_SET) && is_ok) {
-            n_cmd = GSM_CMD_CPBR;               /* Read entries */
-        } else if (CMD_IS_CUR(GSM_CMD_CPBR)) {
-            gsm.cb.cb.pb_list.mem = gsm.pb.mem.current;
-            gsm.cb.cb.pb_list.entries = gsm.msg->msg.pb_list.entries;
-            gsm.cb.cb.pb_list.size = gsm.msg->msg.pb_list.ei;
-            gsm.cb.cb.pb_list.err = is_ok ? gsmOK : gsmERR;
-            gsmi_send_cb(GSM_CB_PB_LIST);
+        if (CMD_IS_CUR(GSM_CMD_CPBR)) {
+            if (msg->msg.pb_list.fn != NULL && is_ok && !msg->msg.pb_list.stop
+                && gsmi_pb_page_next(&msg->msg.pb_list.start_index, msg->msg.pb_list.page, msg->msg.pb_list.en)) {
+                n_cmd = GSM_CMD_CPBR;           /* Read next page */
+            }
+#if GSM_CFG_PB_CACHE
+            if (msg->msg.pb_list.cache) {
+                gsmr_t res = gsmi_pb_cache_load_chunk(msg, is_ok);
+                if (res == gsmCONT) {
+                    n_cmd = GSM_CMD_CPBR;       /* Read next chunk */
+                } else {
+                    is_ok = res == gsmOK;
+                }
+            }
+#endif /* GSM_CFG_PB_CACHE */
+            if (n_cmd == GSM_CMD_IDLE) {
+                gsm.cb.cb.pb_list.mem = gsm.pb.mem.current;
+                if (gsm.msg->msg.pb_list.fn != NULL) {  /* Entries were already passed to callback */
+                    gsm.cb.cb.pb_list.entries = NULL;
+                    gsm.cb.cb.pb_list.size = gsm.msg->msg.pb_list.en;
+                } else {
+                    gsm.cb.cb.pb_list.entries = gsm.msg->msg.pb_list.entries;
+                    gsm.cb.cb.pb_list.size = gsm.msg->msg.pb_list.ei;
+                }
+#if GSM_CFG_PB_CACHE
+                if (msg->msg.pb_list.cache) {   /* Entries were stored to cache */
+                    gsm.cb.cb.pb_list.entries = NULL;
+                }
+#endif /* GSM_CFG_PB_CACHE */
+                gsm.cb.cb.pb_list.err = is_ok ? gsmOK : gsmERR;
+                gsmi_send_cb(GSM_CB_PB_LIST);
+            }
         }
     } else if (CMD_IS_DEF(GSM_CMD_CPBF)) {
-        if (CMD_IS_CUR(GSM_CMD_CPBS_GET) && is_ok) {/* Get current memory */
-            n_cmd = GSM_CMD_CPBS_SET;           /* Set current memory */
-        } else if (CMD_IS_CUR(GSM_CMD_CPBS_SET) && is_ok) {
-            n_cmd = GSM_CMD_CPBF;               /* Read entries */
-        } else if (CMD_IS_CUR(GSM_CMD_CPBF)) {
+        if (CMD_IS_CUR(GSM_CMD_CPBF)) {
             gsm.cb.cb.pb_search.mem = gsm.pb.mem.current;
             gsm.cb.cb.pb_search.search = gsm.msg->msg.pb_search.search;
             gsm.cb.cb.pb_search.entries = gsm.msg->msg.pb_search.entries;
@@ -920,6 +1710,14 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t is_ok, uint16_t is_error) {
 #endif /* GSM_CFG_PHONEBOOK */
     }
 
+    /*
+     * Continue with next step from steps table,
+     * skipping steps already satisfied by device state
+     */
+    if (n_cmd == GSM_CMD_IDLE && is_ok) {
+        n_cmd = gsmi_cmd_steps_next(msg, 0);
+    }
+
     /*
      * Check if new command was set for execution
      */
@@ -934,352 +1732,474 @@ gsmi_process_sub_cmd(gsm_msg_t* msg, uint8_t is_ok, uint16_t is_error) {
     return is_ok ? gsmOK : gsmERR;
 }
 
+#if GSM_CFG_CALL || __DOXYGEN__
+
 /**
- * \brief           Function to initialize every AT command
- * \note            Never call this function directly. Set as initialization function for command and use `msg->fn(msg)`
- * \param[in]       msg: Pointer to \ref gsm_msg_t with data
- * \return          Member of \ref gsmr_t enumeration
+ * \brief           Write arguments for dial command
+ * \param[in]       msg: Current message
  */
-gsmr_t
-gsmi_initiate_cmd(gsm_msg_t* msg) {
-    switch (CMD_GET_CUR()) {                    /* Check current message we want to send over AT */
-        case GSM_CMD_RESET: {                   /* Reset modem with AT commands */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CFUN=1,1");  /* Second "1" means reset */
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_ATE0:
-        case GSM_CMD_ATE1: {
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            if (CMD_IS_CUR(GSM_CMD_ATE0)) {
-                GSM_AT_PORT_SEND_STR("E0");
-            } else {
-                GSM_AT_PORT_SEND_STR("E1");
-            }
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CMEE: {                    /* Enable detailed error messages */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CMEE=1");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CGMI_GET: {                /* Get manufacturer */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CGMI");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CGMM_GET: {                /* Get model */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CGMM");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CGSN_GET: {                /* Get serial number */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CGSN");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
+static void
+cmd_enc_atd(gsm_msg_t* msg) {
+    send_string(msg->msg.call_start.number, 0, 0, 0);
+    GSM_AT_PORT_SEND_STR(";");                  /* Voice call includes semicolon at the end */
+}
+
+#endif /* GSM_CFG_CALL || __DOXYGEN__ */
+
+/**
+ * \brief           Write arguments for operator selection
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cops_set(gsm_msg_t* msg) {
+    send_number(GSM_U32(msg->msg.cops_set.mode), 0, 0);
+    if (msg->msg.cops_set.mode != GSM_OPERATOR_MODE_AUTO) {
+        send_number(GSM_U32(msg->msg.cops_set.format), 0, 1);
+        switch (msg->msg.cops_set.format) {
+            case GSM_OPERATOR_FORMAT_LONG_NAME:
+            case GSM_OPERATOR_FORMAT_SHORT_NAME:
+                send_string(msg->msg.cops_set.name, 1, 1, 1);
+                break;
+            default: 
+                send_number(GSM_U32(msg->msg.cops_set.num), 0, 1);
         }
-        case GSM_CMD_CREG_SET: {                /* Enable +CREG message */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CREG=1");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CREG_GET: {                /* Get network registration status */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CREG?");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CFUN_SET: {
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CFUN=");
-            /**
-             * \todo: If CFUN command forced, check value
-             */
-            if (CMD_IS_DEF(GSM_CMD_RESET) ||
-                (CMD_IS_DEF(GSM_CMD_CFUN_SET) && msg->msg.cfun.mode)) {
-                GSM_AT_PORT_SEND_STR("1");
-            } else {
-                GSM_AT_PORT_SEND_STR("0");
-            }
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPIN_GET: {                /* Read current SIM status */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPIN?");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPIN_SET: {                /* Set SIM pin code */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPIN=");
-            send_string(msg->msg.cpin_enter.pin, 0, 1, 0);  /* Send pin with quotes */
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPIN_ADD: {                /* Add new pin code */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CLCK=\"SC\",1,");
-            send_string(msg->msg.cpin_add.pin, 0, 1, 0);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }                          
-        case GSM_CMD_CPIN_CHANGE: {             /* Change already active SIM */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPWD=\"SC\"");
-            send_string(msg->msg.cpin_change.current_pin, 0, 1, 1);
-            send_string(msg->msg.cpin_change.new_pin, 0, 1, 1);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPIN_REMOVE: {             /* Remove current PIN */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CLCK=\"SC\",0,");
-            send_string(msg->msg.cpin_remove.pin, 0, 1, 0);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GMM_CMD_CPUK_SET: {                /* Enter PUK and set new PIN */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPIN=");
-            send_string(msg->msg.cpuk_enter.puk, 0, 1, 1);
-            send_string(msg->msg.cpuk_enter.pin, 0, 1, 1);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_COPS_SET: {                /* Set current operator */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+COPS=");
-            send_number(GSM_U32(msg->msg.cops_set.mode), 0, 0);
-            if (msg->msg.cops_set.mode != GSM_OPERATOR_MODE_AUTO) {
-                send_number(GSM_U32(msg->msg.cops_set.format), 0, 1);
-                switch (msg->msg.cops_set.format) {
-                    case GSM_OPERATOR_FORMAT_LONG_NAME:
-                    case GSM_OPERATOR_FORMAT_SHORT_NAME:
-                        send_string(msg->msg.cops_set.name, 1, 1, 1);
-                        break;
-                    default: 
-                        send_number(GSM_U32(msg->msg.cops_set.num), 0, 1);
-                }
-            }
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_COPS_GET: {                /* Get current operator */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+COPS?");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_COPS_GET_OPT: {            /* Get list of available operators */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+COPS=?");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CSQ_GET: {                 /* Get signal strength */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CSQ");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CNUM: {                    /* Get SIM number */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CNUM");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-#if GSM_CFG_CONN
-        case GSM_CMD_CIPSHUT: {                 /* Shut down network connection and put to reset state */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CIPSHUT");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
+    }
+}
+
+#if GSM_CFG_OPERATOR_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Start loading operator names, command has no arguments
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_copn(gsm_msg_t* msg) {
+    GSM_UNUSED(msg);
+    gsmi_operator_names_start();                /* Names are added while read */
+}
+
+#endif /* GSM_CFG_OPERATOR_CACHE || __DOXYGEN__ */
+
+/**
+ * \brief           Write arguments for phone functionality
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cfun_set(gsm_msg_t* msg) {
+    /**
+     * \todo: If CFUN command forced, check value
+     */
+    if (CMD_IS_DEF(GSM_CMD_RESET) ||
+        (CMD_IS_DEF(GSM_CMD_CFUN_SET) && msg->msg.cfun.mode)) {
+        GSM_AT_PORT_SEND_STR("1");
+    } else {
+        GSM_AT_PORT_SEND_STR("0");
+    }
+}
+
+/**
+ * \brief           Write arguments for PIN enter
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpin_set(gsm_msg_t* msg) {
+    send_string(msg->msg.cpin_enter.pin, 0, 1, 0); /* Send pin with quotes */
+}
+
+/**
+ * \brief           Write arguments for new PIN
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpin_add(gsm_msg_t* msg) {
+    send_string(msg->msg.cpin_add.pin, 0, 1, 0);
+}
+
+/**
+ * \brief           Write arguments for PIN change
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpin_change(gsm_msg_t* msg) {
+    send_string(msg->msg.cpin_change.current_pin, 0, 1, 1);
+    send_string(msg->msg.cpin_change.new_pin, 0, 1, 1);
+}
+
+/**
+ * \brief           Write arguments for PIN removal
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpin_remove(gsm_msg_t* msg) {
+    send_string(msg->msg.cpin_remove.pin, 0, 1, 0);
+}
+
+/**
+ * \brief           Write arguments for PUK enter
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpuk_set(gsm_msg_t* msg) {
+    send_string(msg->msg.cpuk_enter.puk, 0, 1, 1);
+    send_string(msg->msg.cpuk_enter.pin, 0, 1, 1);
+}
+
+#if GSM_CFG_SMS || __DOXYGEN__
+
+/**
+ * \brief           Write arguments for SMS message format
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cmgf(gsm_msg_t* msg) {
+    send_number(GSM_U32(gsmi_sms_get_op_format(msg)), 0, 0);
+}
+
+/**
+ * \brief           Encode SMS to send
+ * \param[in]       msg: Current message
+ * \return          \ref gsmOK on success, \ref gsmPARERR if message cannot be encoded
+ */
+static gsmr_t
+sms_send_encode(gsm_msg_t* msg) {
+#if GSM_CFG_SMS_PDU
+    gsm_sms_concat_t concat;
+
+    concat.ref = msg->msg.sms_send.ref;
+    concat.total = msg->msg.sms_send.parts;
+    concat.seq = msg->msg.sms_send.part + 1;
+
+    /* Encode PDU now, it is sent after prompt */
+    sms_pdu_len = gsm_sms_pdu_encode_submit(sms_pdu_buff, msg->msg.sms_send.num,
+        &msg->msg.sms_send.text[msg->msg.sms_send.part_pos], msg->msg.sms_send.part_len,
+        msg->msg.sms_send.coding, msg->msg.sms_send.parts > 1 ? &concat : NULL);
+    if (sms_pdu_len == 0) {
+        return gsmPARERR;
+    }
+#if GSM_CFG_SMS_REPORT
+    if (gsm.sms.report) {
+        sms_pdu_buff[1] |= 0x20;                /* Request status report, first octet follows SMSC information */
+    }
+#endif /* GSM_CFG_SMS_REPORT */
+#else /* GSM_CFG_SMS_PDU */
+    GSM_UNUSED(msg);
+#endif /* !GSM_CFG_SMS_PDU */
+    return gsmOK;
+}
+
+/**
+ * \brief           Prepare SMS before `AT+CMGS` command is sent
+ *
+ *                  Nothing is sent to device when message cannot be encoded.
+ *                  Batch messages which cannot be encoded are skipped with \ref gsmPARERR result
+ *
+ * \param[in]       msg: Current message
+ * \return          \ref gsmOK on success, \ref gsmPARERR if there is no message to send
+ */
+static gsmr_t
+sms_send_prepare(gsm_msg_t* msg) {
+    if (msg->msg.sms_send.batch == NULL) {
+        return sms_send_encode(msg);
+    }
+    for (; msg->msg.sms_send.batch_i < msg->msg.sms_send.batch_len; msg->msg.sms_send.batch_i++) {
+        msg->msg.sms_send.num = msg->msg.sms_send.batch[msg->msg.sms_send.batch_i].num;
+        msg->msg.sms_send.text = msg->msg.sms_send.batch[msg->msg.sms_send.batch_i].text;
+#if GSM_CFG_SMS_PDU
+        msg->msg.sms_send.len = strlen(msg->msg.sms_send.text);
+        msg->msg.sms_send.coding = gsm_sms_pdu_get_coding(msg->msg.sms_send.text, msg->msg.sms_send.len);
+        msg->msg.sms_send.parts = 1;
+        msg->msg.sms_send.part_len = msg->msg.sms_send.len;
+#endif /* GSM_CFG_SMS_PDU */
+        if (sms_send_encode(msg) == gsmOK) {
+            return gsmOK;
+        }
+        msg->msg.sms_send.batch[msg->msg.sms_send.batch_i].res = gsmPARERR;
+    }
+    return gsmPARERR;
+}
+
+/**
+ * \brief           Write arguments for SMS send
+ * \note            Message is prepared with \ref sms_send_prepare before
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cmgs(gsm_msg_t* msg) {
+#if GSM_CFG_SMS_PDU
+    send_number(GSM_U32(sms_pdu_len - 1), 0, 0);    /* Length is without SMSC information byte */
+#else /* GSM_CFG_SMS_PDU */
+    send_string(msg->msg.sms_send.num, 0, 1, 0);
+#endif /* !GSM_CFG_SMS_PDU */
+}
+
+/**
+ * \brief           Write arguments for more messages to send
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cmms_set(gsm_msg_t* msg) {
+    send_number(GSM_U32(msg->msg.sms_send.cmms), 0, 0);
+}
+
+/**
+ * \brief           Write arguments for new message indications
+ *
+ *                  Indications are buffered by device while command is in progress
+ *
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cnmi(gsm_msg_t* msg) {
+    send_number(2, 0, 0);                       /* Buffer indications when link is reserved */
+    send_number(GSM_U32(msg->msg.sms_cnmi.mt), 0, 1);
+    send_number(0, 0, 1);
+    send_number(GSM_U32(msg->msg.sms_cnmi.ds), 0, 1);
+    send_number(0, 0, 1);
+}
+
+/**
+ * \brief           Write arguments for text mode parameters
+ *
+ *                  Status report request bit is set in first octet when status reports are enabled
+ *
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_csmp(gsm_msg_t* msg) {
+    uint8_t fo = msg->msg.sms_cnmi.fo;
+    if (msg->msg.sms_cnmi.ds) {                 /* Change status report request only */
+        fo |= 0x20;
+    } else {
+        fo &= ~0x20;
+    }
+    send_number(fo, 0, 0);
+    if (msg->msg.sms_cnmi.params[0]) {
+        send_string(msg->msg.sms_cnmi.params, 0, 0, 1);
+    }
+}
+
+/**
+ * \brief           Write arguments for SMS read
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cmgr(gsm_msg_t* msg) {
+    send_number(GSM_U32(msg->msg.sms_read.pos), 0, 0);
+    send_number(GSM_U32(!msg->msg.sms_read.update), 0, 1);
+}
+
+/**
+ * \brief           Write arguments for SMS delete
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cmgd(gsm_msg_t* msg) {
+    send_number(GSM_U32(msg->msg.sms_delete.pos), 0, 0);
+    if (msg->msg.sms_delete.delflag) {
+        send_number(GSM_U32(msg->msg.sms_delete.delflag), 0, 1);
+    }
+}
+
+/**
+ * \brief           Write arguments for SMS delete by type
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cmgda(gsm_msg_t* msg) {
+    static const char* const types[] = { "DEL ALL", "DEL READ", "DEL UNREAD", "DEL SENT", "DEL UNSENT" };
+    gsm_sms_status_t status = msg->msg.sms_delete.status;
+
+    if (gsmi_sms_get_op_format(msg)) {          /* Type is string in text mode */
+        send_string(types[status], 0, 1, 0);
+    } else {                                    /* and number in PDU mode */
+        send_number(GSM_U32(status == GSM_SMS_STATUS_ALL ? 6 : status), 0, 0);
+    }
+}
+
+/**
+ * \brief           Write arguments for SMS list
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cmgl(gsm_msg_t* msg) {
+#if GSM_CFG_SMS_MIRROR
+    if (msg->msg.sms_list.mirror) {
+        gsmi_sms_mirror_sync_start(gsmi_sms_get_op_mem(msg));  /* Entries are added again while listed */
+    }
+#endif /* GSM_CFG_SMS_MIRROR */
+    send_sms_stat(msg->msg.sms_list.status, 1, 0);
+    send_number(GSM_U32(!msg->msg.sms_list.update), 0, 1);
+}
+
+/**
+ * \brief           Write arguments for preferred SMS storage
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpms_set(gsm_msg_t* msg) {
+    if (CMD_IS_DEF(GSM_CMD_CMGR) || CMD_IS_DEF(GSM_CMD_CMGD) || CMD_IS_DEF(GSM_CMD_CMGDA) || CMD_IS_DEF(GSM_CMD_CMGL)) {
+        send_dev_memory(gsmi_sms_get_op_mem(msg), 1, 0);    /* Memory for read, delete or list operation */
+    } else if (CMD_IS_DEF(GSM_CMD_CPMS_SET)) {  /* Do we want to set memory for read/delete,sent/write,receive? */
+        size_t i;
+        for (i = 0; i < 3; i++) {               /* Write 3 memories */
+            send_dev_memory(msg->msg.sms_memory.mem[i] == GSM_MEM_CURRENT ? gsm.sms.mem[i].current : msg->msg.sms_memory.mem[i], 1, !!i);
         }
-        case GSM_CMD_CIPMUX: {                  /* Enable multiple connections */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CIPMUX=1");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
+    }
+}
+
+#endif /* GSM_CFG_SMS || __DOXYGEN__ */
+
+#if GSM_CFG_PHONEBOOK || __DOXYGEN__
+
+/**
+ * \brief           Write arguments for phonebook storage
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpbs_set(gsm_msg_t* msg) {
+    send_dev_memory(gsmi_pb_get_op_mem(msg), 1, 0);
+}
+
+/**
+ * \brief           Write arguments for phonebook entry write or delete
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpbw_set(gsm_msg_t* msg) {
+#if GSM_CFG_PB_SYNC
+    if (msg->cmd_def == GSM_CMD_PHONEBOOK_SYNC) {
+        const gsm_pb_entry_t* t = &msg->msg.pb_sync.entries[msg->msg.pb_sync.ti];
+        send_number(GSM_U32(msg->msg.pb_sync.pos), 0, 0);
+        if (!msg->msg.pb_sync.del) {
+            send_string(t->number, 0, 1, 1);
+            send_number(GSM_U32(t->type), 0, 1);
+            send_string(t->name, 0, 1, 1);
         }
-        case GSM_CMD_CIPHEAD: {                 /* Enable information on receive data about connection and length */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CIPHEAD=1");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
+        return;
+    }
+#endif /* GSM_CFG_PB_SYNC */
+#if GSM_CFG_PB_CACHE
+    if (!msg->msg.pb_write.pos && !msg->msg.pb_write.del) { /* Select free position, so cache knows where entry is */
+        msg->msg.pb_write.pos = gsmi_pb_cache_free_pos(gsmi_pb_get_op_mem(msg));
+    }
+#endif /* GSM_CFG_PB_CACHE */
+    if (msg->msg.pb_write.pos) {                /* Write number if more than 0 */
+        send_number(GSM_U32(msg->msg.pb_write.pos), 0, 0);
+    }
+    if (!msg->msg.pb_write.del) {
+        send_string(msg->msg.pb_write.num, 0, 1, 1);
+        send_number(GSM_U32(msg->msg.pb_write.type), 0, 1);
+        send_string(msg->msg.pb_write.name, 0, 1, 1);
+    }
+}
+
+/**
+ * \brief           Write range of positions for page of paged `+CPBR` read
+ * \param[in]       start_index: First position of page
+ * \param[in]       page: Number of positions read with single command
+ */
+static void
+send_pb_page(size_t start_index, size_t page) {
+    size_t end = start_index + page - 1;
+    if (end > gsm.pb.mem.total && gsm.pb.mem.total >= start_index) {
+        end = gsm.pb.mem.total;                 /* Do not read past last position */
+    }
+    send_number(GSM_U32(start_index), 0, 0);
+    send_number(GSM_U32(end), 0, 1);
+}
+
+/**
+ * \brief           Write arguments for phonebook read
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpbr(gsm_msg_t* msg) {
+#if GSM_CFG_PB_SYNC
+    if (msg->cmd_def == GSM_CMD_PHONEBOOK_SYNC) {
+        if (msg->msg.pb_sync.start_index == 1) {
+            gsmi_pb_sync_start(msg);            /* Entries are compared while read */
         }
-        case GSM_CMD_CIPSRIP: {
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CIPSRIP=1");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
+        send_pb_page(msg->msg.pb_sync.start_index, GSM_CFG_PB_SYNC_CHUNK);
+        return;
+    }
+#endif /* GSM_CFG_PB_SYNC */
+#if GSM_CFG_PB_CACHE
+    if (msg->msg.pb_list.cache) {
+        if (msg->msg.pb_list.start_index == 1) {
+            gsmi_pb_cache_load_start(gsmi_pb_get_op_mem(msg));  /* Entries are added while read */
         }
-#endif /* GSM_CFG_CONN */
+        send_pb_page(msg->msg.pb_list.start_index, msg->msg.pb_list.etr);
+        return;
+    }
+#endif /* GSM_CFG_PB_CACHE */
+    if (msg->msg.pb_list.fn != NULL) {          /* Stream entries page by page */
+        send_pb_page(msg->msg.pb_list.start_index, msg->msg.pb_list.page);
+        return;
+    }
+    send_number(GSM_U32(msg->msg.pb_list.start_index), 0, 0);
+    send_number(GSM_U32(msg->msg.pb_list.start_index + msg->msg.pb_list.etr - 1), 0, 1);   /* Last index to read */
+}
+
+/**
+ * \brief           Write arguments for phonebook search
+ * \param[in]       msg: Current message
+ */
+static void
+cmd_enc_cpbf(gsm_msg_t* msg) {
+    send_string(msg->msg.pb_search.search, 1, 1, 0);
+}
+
+#endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
+
+/**
+ * \brief           AT command description
+ */
+typedef struct {
+    const char* str;                            /*!< Constant part of command after `AT` */
+    size_t len;                                 /*!< Length of constant part */
+    void (*enc)(gsm_msg_t* msg);                /*!< Function to write command arguments or `NULL` */
+} gsm_cmd_entry_t;
+
+/**
+ * \brief           List of AT commands, indexed by \ref gsm_cmd_t
+ */
+static const gsm_cmd_entry_t
+cmd_list[] = {
+#define GSM_CMD_DEF(name, str)                  { str, sizeof(str) - 1, NULL },
+#define GSM_CMD_DEF_ENC(name, str, enc)         { str, sizeof(str) - 1, cmd_enc_ ## enc },
+#include "gsm/gsm_commands.h"
+};
+
+/**
+ * \brief           Function to initialize every AT command
+ * \note            Never call this function directly. Set as initialization function for command and use `msg->fn(msg)`
+ * \param[in]       msg: Pointer to \ref gsm_msg_t with data
+ * \return          Member of \ref gsmr_t enumeration
+ */
+gsmr_t
+gsmi_initiate_cmd(gsm_msg_t* msg) {
+    gsm_cmd_t cmd = CMD_GET_CUR();
+    const gsm_cmd_entry_t* c;
+
+    if (cmd >= GSM_CMD_END) {
+        return gsmERR;                          /* Invalid command */
+    }
+    c = &cmd_list[cmd];
+    if (c->len == 0 && c->enc == NULL) {
+        return gsmERR;                          /* Command cannot be sent directly */
+    }
 #if GSM_CFG_SMS
-        case GSM_CMD_CMGF: {                    /* Select SMS message format */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CMGF=");
-            if (CMD_IS_DEF(GSM_CMD_CMGS)) {
-                send_number(GSM_U32(!!msg->msg.sms_send.format), 0, 0);
-            } else if (CMD_IS_DEF(GSM_CMD_CMGR)) {
-                send_number(GSM_U32(!!msg->msg.sms_read.format), 0, 0);
-            } else if (CMD_IS_DEF(GSM_CMD_CMGL)) {
-                send_number(GSM_U32(!!msg->msg.sms_list.format), 0, 0);
-            } else {
-                GSM_AT_PORT_SEND_STR("1");      /* Force text mode */
-            }
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CMGS: {                    /* Send SMS */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CMGS=");
-            send_string(msg->msg.sms_send.num, 0, 1, 0);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CMGR: {                    /* Read message */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CMGR=");
-            send_number(GSM_U32(msg->msg.sms_read.pos), 0, 0);
-            send_number(GSM_U32(!msg->msg.sms_read.update), 0, 1);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CMGD: {                    /* Delete SMS message */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CMGD=");
-            send_number(GSM_U32(msg->msg.sms_delete.pos), 0, 0);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CMGL: {                    /* Delete SMS message */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CMGL=");
-            send_sms_stat(msg->msg.sms_list.status, 1, 0);
-            send_number(GSM_U32(!msg->msg.sms_list.update), 0, 1);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPMS_GET_OPT: {            /* Get available SMS storages */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPMS=?");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPMS_GET: {                /* Get current SMS storage info */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPMS?");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPMS_SET: {                /* Set active SMS storage(s) */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPMS=");
-            if (CMD_IS_DEF(GSM_CMD_CMGR)) { /* Read SMS original command? */
-                send_dev_memory(msg->msg.sms_read.mem == GSM_MEM_CURRENT ? gsm.sms.mem[0].current : msg->msg.sms_read.mem, 1, 0);
-            } else if(CMD_IS_DEF(GSM_CMD_CMGD)) {   /* Delete SMS original command? */
-                send_dev_memory(msg->msg.sms_delete.mem == GSM_MEM_CURRENT ? gsm.sms.mem[0].current : msg->msg.sms_delete.mem, 1, 0);
-            } else if(CMD_IS_DEF(GSM_CMD_CMGL)) {   /* List SMS original command? */
-                send_dev_memory(msg->msg.sms_list.mem == GSM_MEM_CURRENT ? gsm.sms.mem[0].current : msg->msg.sms_list.mem, 1, 0);
-            } else if (CMD_IS_DEF(GSM_CMD_CPMS_SET)) {  /* Do we want to set memory for read/delete,sent/write,receive? */
-                size_t i;
-                for (i = 0; i < 3; i++) {       /* Write 3 memories */
-                    send_dev_memory(msg->msg.sms_memory.mem[i] == GSM_MEM_CURRENT ? gsm.sms.mem[i].current : msg->msg.sms_memory.mem[i], 1, !!i);
-                }
-            }
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
+    if (cmd == GSM_CMD_CMGS && sms_send_prepare(msg) != gsmOK) {
+        return gsmPARERR;                       /* Message cannot be encoded, nothing is sent */
+    }
 #endif /* GSM_CFG_SMS */
-#if GSM_CFG_CALL
-        case GSM_CMD_ATD: {                     /* Start new call */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("D");
-            send_string(msg->msg.call_start.number, 0, 0, 0);
-            GSM_AT_PORT_SEND_STR(";");          /* Voice call includes semicolon at the end */
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_ATA: {                     /* Answer phone call */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("A");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_ATH: {                     /* Disconnect existing connection (hang-up phone call) */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("H");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CLCC: {                    /* Enable auto notification on received call */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CLCC=1");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-#endif /* GSM_CFG_CALL */
-#if GSM_CFG_PHONEBOOK
-        case GSM_CMD_CPBS_GET_OPT: {            /* Get available phonebook storages */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPBS=?");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPBS_GET: {                /* Get current memory info */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPBS?");
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPBS_SET: {                /* Get current memory info */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPBS=");
-            send_dev_memory(msg->msg.pb_write.mem == GSM_MEM_CURRENT ? gsm.pb.mem.current : msg->msg.pb_write.mem, 1, 0);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPBW_SET: {                /* Write/Delete new/old entry */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPBW=");
-            if (msg->msg.pb_write.pos) {        /* Write number if more than 0 */
-                send_number(GSM_U32(msg->msg.pb_write.pos), 0, 0);
-            }
-            if (!msg->msg.pb_write.del) {
-                send_string(msg->msg.pb_write.num, 0, 1, 1);
-                send_number(GSM_U32(msg->msg.pb_write.type), 0, 1);
-                send_string(msg->msg.pb_write.name, 0, 1, 1);
-            }
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPBR: {                    /* Read entires */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPBR=");
-            send_number(GSM_U32(msg->msg.pb_list.start_index), 0, 0);
-            send_number(GSM_U32(msg->msg.pb_list.etr), 0, 1);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-        case GSM_CMD_CPBF: {                    /* Find entires */
-            GSM_AT_PORT_SEND_BEGIN();           /* Begin AT command string */
-            GSM_AT_PORT_SEND_STR("+CPBF=");
-            send_string(msg->msg.pb_search.search, 1, 1, 0);
-            GSM_AT_PORT_SEND_END();             /* End AT command string */
-            break;
-        }
-#endif /* GSM_CFG_PHONEBOOK */
-        default: 
-            return gsmERR;                      /* Invalid command */
+
+    GSM_AT_PORT_SEND_BEGIN();                   /* Begin AT command string */
+    GSM_AT_PORT_SEND(c->str, c->len);           /* Send constant part of command */
+    if (c->enc != NULL) {
+        c->enc(msg);                            /* Write command arguments */
     }
+    GSM_AT_PORT_SEND_END();                     /* End AT command string */
     return gsmOK;                               /* Valid command */
 }
 
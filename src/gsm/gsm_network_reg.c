@@ -0,0 +1,190 @@
+/**
+ * \file            gsm_network_reg.c
+ * \brief           Debounced network registration state
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_network.h"
+#include "gsm/gsm_operator.h"
+#include "gsm/gsm_timeout.h"
+
+#if GSM_CFG_NETWORK_REG || __DOXYGEN__
+
+#define REG_IS_HOME(s)                  ((s) == GSM_NETWORK_REG_STATUS_CONNECTED)
+#define REG_IS_ROAMING(s)               ((s) == GSM_NETWORK_REG_STATUS_CONNECTED_ROAMING)
+
+static gsm_network_reg_t reg_cur[GSM_NETWORK_REG_DOMAIN_END];   /*!< Debounced registration of every domain */
+static gsm_network_reg_t reg_new[GSM_NETWORK_REG_DOMAIN_END];   /*!< Last reported registration of every domain */
+static uint32_t reg_time[GSM_NETWORK_REG_DOMAIN_END];   /*!< Time of last changed report of every domain */
+static uint8_t reg_pending;                     /*!< Bit mask of domains with report waiting for debounce time */
+static uint8_t reg_timeout_active;              /*!< Flag indicating debounce timeout is active */
+
+/**
+ * \brief           Check if registration info differs
+ * \param[in]       a: First registration
+ * \param[in]       b: Second registration
+ * \return          `1` if different, `0` otherwise
+ */
+static uint8_t
+reg_differs(const gsm_network_reg_t* a, const gsm_network_reg_t* b) {
+    return a->status != b->status || a->lac != b->lac || a->ci != b->ci || a->act != b->act;
+}
+
+/**
+ * \brief           Apply reported registration of domain
+ * \param[in]       domain: Registration domain
+ * \return          `1` if device became registered or changed between home and roaming network,
+ *                  `0` otherwise. Change of location area or cell alone does not change network
+ */
+static uint8_t
+reg_commit(gsm_network_reg_domain_t domain) {
+    gsm_network_reg_status_t prev = reg_cur[domain].status;
+
+    reg_pending &= ~(1 << domain);
+    if (!reg_differs(&reg_cur[domain], &reg_new[domain])) {
+        return 0;                               /* State returned to applied one */
+    }
+    memcpy(&reg_cur[domain], &reg_new[domain], sizeof(reg_cur[domain]));
+    if (domain == GSM_NETWORK_REG_DOMAIN_CS) {
+        gsm.network.status = reg_cur[domain].status;
+    }
+
+    gsm.cb.cb.network_reg.domain = domain;
+    memcpy(&gsm.cb.cb.network_reg.reg, &reg_cur[domain], sizeof(gsm.cb.cb.network_reg.reg));
+    gsm.cb.cb.network_reg.prev_status = prev;
+    if (prev != reg_cur[domain].status) {
+        gsmi_send_cb(GSM_CB_NETWORK_REG_CHANGED);   /* Send to user */
+    } else if (REG_IS_HOME(prev) || REG_IS_ROAMING(prev)) {
+        gsmi_send_cb(GSM_CB_NETWORK_CELL_CHANGED);  /* Send to user */
+    }
+    return prev != reg_cur[domain].status
+        && (REG_IS_HOME(reg_cur[domain].status) || REG_IS_ROAMING(reg_cur[domain].status));
+}
+
+/**
+ * \brief           Debounce time of any domain elapsed, apply registration and query operator on network change
+ * \param[in]       arg: Unused
+ */
+static void
+reg_timeout_fn(void* arg) {
+    uint32_t now, age, next = 0xFFFFFFFF;
+    uint8_t query = 0;
+    size_t i;
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    reg_timeout_active = 0;
+    now = gsm_sys_now();
+    for (i = 0; i < GSM_NETWORK_REG_DOMAIN_END; i++) {
+        if (reg_pending & (1 << i)) {
+            age = now - reg_time[i];
+            if (age >= GSM_CFG_NETWORK_REG_DEBOUNCE) {
+                query |= reg_commit((gsm_network_reg_domain_t)i);
+            } else {
+                next = GSM_MIN(next, GSM_CFG_NETWORK_REG_DEBOUNCE - age);
+            }
+        }
+    }
+    if (next != 0xFFFFFFFF && gsm_timeout_add(next, reg_timeout_fn, NULL) == gsmOK) {
+        reg_timeout_active = 1;                 /* Check again when next domain is stable */
+    }
+    if (query) {
+        gsm_operator_get(NULL, 0);              /* Registered to new network */
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    GSM_UNUSED(arg);
+}
+
+/**
+ * \brief           Save reported registration
+ *
+ *                  Unsolicited report is applied when it does not change for \ref GSM_CFG_NETWORK_REG_DEBOUNCE milliseconds.
+ *                  Debounce time is measured for every domain separately
+ *
+ * \param[in]       domain: Registration domain
+ * \param[in]       reg: Reported registration
+ * \param[in]       solicited: Set to `1` when report is response to read command and is applied immediately
+ */
+void
+gsmi_network_reg_update(gsm_network_reg_domain_t domain, const gsm_network_reg_t* reg, uint8_t solicited) {
+    if (!solicited && !reg_differs(&reg_new[domain], reg)) {
+        return;                                 /* Repeated report */
+    }
+    memcpy(&reg_new[domain], reg, sizeof(reg_new[domain]));
+    if (solicited) {
+        if (reg_commit(domain)) {
+            gsm_operator_get(NULL, 0);          /* Registered to new network */
+        }
+        return;
+    }
+    reg_time[domain] = gsm_sys_now();           /* Restart debounce time of domain */
+    reg_pending |= 1 << domain;
+    if (!reg_timeout_active
+        && gsm_timeout_add(GSM_CFG_NETWORK_REG_DEBOUNCE, reg_timeout_fn, NULL) == gsmOK) {
+        reg_timeout_active = 1;
+    }
+}
+
+/**
+ * \brief           Reset registration state after device reset
+ */
+void
+gsmi_network_reg_reset(void) {
+    size_t i;
+
+    if (reg_timeout_active) {
+        gsm_timeout_remove(reg_timeout_fn);
+        reg_timeout_active = 0;
+    }
+    memset(reg_cur, 0x00, sizeof(reg_cur));
+    for (i = 0; i < GSM_NETWORK_REG_DOMAIN_END; i++) {
+        reg_cur[i].act = GSM_OPERATOR_ACT_UNKNOWN;
+    }
+    memcpy(reg_new, reg_cur, sizeof(reg_new));
+    reg_pending = 0;
+}
+
+/**
+ * \brief           Get debounced network registration
+ * \param[in]       domain: Registration domain
+ * \param[out]      reg: Output variable to save registration
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_network_reg_get(gsm_network_reg_domain_t domain, gsm_network_reg_t* reg) {
+    GSM_ASSERT("domain < GSM_NETWORK_REG_DOMAIN_END", domain < GSM_NETWORK_REG_DOMAIN_END); /* Assert input parameters */
+    GSM_ASSERT("reg != NULL", reg != NULL);     /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    memcpy(reg, &reg_cur[domain], sizeof(*reg));
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return gsmOK;
+}
+
+#endif /* GSM_CFG_NETWORK_REG || __DOXYGEN__ */
@@ -80,6 +80,8 @@ gsm_operator_set(gsm_operator_mode_t mode, gsm_operator_format_t format, const c
 
 /**
  * \brief           Scan for available operators
+ * \note            When \ref GSM_CFG_OPERATOR_CACHE is enabled, result of last complete scan
+ *                  is returned without network scan if not older than \ref GSM_CFG_OPERATOR_CACHE_TTL
  * \param[in]       ops: Pointer to array to write found operators
  * \param[in]       opsl: Length of input array in units of elements
  * \param[out]      opf: Pointer to ouput variable to save number of operators found
@@ -94,6 +96,12 @@ gsm_operator_scan(gsm_operator_t* ops, size_t opsl, size_t* opf, uint32_t blocki
         *opf = 0;
     }
 
+#if GSM_CFG_OPERATOR_CACHE
+    if (gsmi_operator_cache_scan(ops, opsl, opf) == gsmOK) {
+        return gsmOK;                           /* Operators found in local cache */
+    }
+#endif /* GSM_CFG_OPERATOR_CACHE */
+
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_COPS_GET_OPT;
     GSM_MSG_VAR_REF(msg).msg.cops_scan.ops = ops;
@@ -103,6 +111,70 @@ gsm_operator_scan(gsm_operator_t* ops, size_t opsl, size_t* opf, uint32_t blocki
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 120000);  /* Send message to producer queue */
 }
 
+/**
+ * \brief           Scan for available operators with callback function for every operator
+ *
+ *                  Callback function is called as soon as operator is parsed from response,
+ *                  before final result of command is received. Return other than \ref gsmOK
+ *                  from callback to cancel the scan, for example when wanted network is found.
+ *                  Remaining operators are ignored and command is aborted on modem.
+ *                  Modem replies with error when abort is received before the response is complete
+ *
+ * \note            Callback function is called from processing thread
+ *                  and must not call blocking API functions
+ * \param[in]       op: Pointer to operator buffer used for every found operator. Must stay valid until operation finishes
+ * \param[in]       fn: Callback function called for every operator
+ * \param[in]       arg: User argument passed to callback function
+ * \param[out]      opf: Pointer to ouput variable to save number of operators passed to callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_operator_scan_stream(gsm_operator_t* op, gsm_operator_scan_fn fn, void* arg, size_t* opf, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("op != NULL", op != NULL);       /* Assert input parameters */
+    GSM_ASSERT("fn != NULL", fn != NULL);       /* Assert input parameters */
+
+    if (opf != NULL) {
+        *opf = 0;
+    }
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_COPS_GET_OPT;
+    GSM_MSG_VAR_REF(msg).msg.cops_scan.ops = op;
+    GSM_MSG_VAR_REF(msg).msg.cops_scan.opsl = 1;    /* Single operator is reused */
+    GSM_MSG_VAR_REF(msg).msg.cops_scan.opf = opf;
+    GSM_MSG_VAR_REF(msg).msg.cops_scan.fn = fn;
+    GSM_MSG_VAR_REF(msg).msg.cops_scan.fn_arg = arg;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 120000);  /* Send message to producer queue */
+}
+
+#if GSM_CFG_OPERATOR_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Load operator names table from device with `AT+COPN`
+ *
+ *                  Table is sorted by operator numeric code,
+ *                  use \ref gsm_operator_name_find to resolve code to name
+ *
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise.
+ *                  Command fails also when not all names fit to table, stored names are still valid
+ */
+gsmr_t
+gsm_operator_names_load(uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_COPN;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_OPERATOR_CACHE || __DOXYGEN__ */
+
 /**
  * \brief           Read RSSI signal from operator
  * \param[out]      rssi: RSSI output variable. When set to `0`, RSSI is not valid
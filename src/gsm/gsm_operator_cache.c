@@ -0,0 +1,263 @@
+/**
+ * \file            gsm_operator_cache.c
+ * \brief           Operator scan cache and operator names table
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_operator.h"
+
+#if GSM_CFG_OPERATOR_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Packed entry of operator names table
+ */
+typedef struct {
+    uint16_t num[2];                            /*!< Operator numeric code, `MCC` and `MNC`, as upper and lower half to avoid padding */
+    uint16_t name;                              /*!< Offset of name in names pool */
+} op_name_t;
+
+static gsm_operator_t scan_ops[GSM_CFG_OPERATOR_CACHE_SIZE];    /*!< Operators of last complete scan */
+static size_t scan_cnt;                         /*!< Number of operators in last scan */
+static uint32_t scan_time;                      /*!< Time when last scan finished */
+static uint8_t scan_valid;                      /*!< Flag indicating last scan is complete */
+static uint8_t scan_full;                       /*!< Flag indicating scan found more operators than fit to cache */
+
+static op_name_t names[GSM_CFG_OPERATOR_NAMES_SIZE];    /*!< Names table sorted by numeric code */
+static char names_pool[GSM_CFG_OPERATOR_NAMES_POOL];    /*!< Zero terminated names */
+static size_t names_cnt;                        /*!< Number of entries in names table */
+static size_t names_sorted;                     /*!< Number of entries in sorted part of names table, used for search */
+static size_t names_pool_used;                  /*!< Number of used bytes in names pool */
+static uint8_t names_full;                      /*!< Flag indicating names did not fit to table */
+
+/**
+ * \brief           Get operator numeric code of names table entry
+ * \param[in]       e: Names table entry
+ * \return          Operator numeric code
+ */
+static uint32_t
+name_get_num(const op_name_t* e) {
+    return ((uint32_t)e->num[0] << 16) | e->num[1];
+}
+
+/**
+ * \brief           Compare names table entries by numeric code, then by order of receive
+ * \param[in]       a: First entry
+ * \param[in]       b: Second entry
+ * \return          Negative, zero or positive value as required by `qsort`
+ */
+static int
+name_cmp(const void* a, const void* b) {
+    const op_name_t* ea = a;
+    const op_name_t* eb = b;
+    uint32_t na = name_get_num(ea), nb = name_get_num(eb);
+
+    if (na != nb) {
+        return na < nb ? -1 : 1;
+    }
+    return (int)ea->name - (int)eb->name;       /* Names are stored in order of receive */
+}
+
+/**
+ * \brief           Find index of first names table entry with code not less than `num`
+ * \param[in]       num: Operator numeric code
+ * \return          Index in names table
+ */
+static size_t
+names_lower_bound(uint32_t num) {
+    size_t lo = 0, hi = names_sorted, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (name_get_num(&names[mid]) < num) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * \brief           Start new operator scan, called when scan response starts
+ */
+void
+gsmi_operator_cache_start(void) {
+    scan_cnt = 0;
+    scan_valid = 0;
+    scan_full = 0;
+}
+
+/**
+ * \brief           Add operator received during scan
+ * \param[in]       op: Parsed operator or `NULL` when operator did not fit to user array
+ */
+void
+gsmi_operator_cache_add(const gsm_operator_t* op) {
+    if (op != NULL && scan_cnt < GSM_ARRAYSIZE(scan_ops)) {
+        memcpy(&scan_ops[scan_cnt++], op, sizeof(*op));
+    } else {
+        scan_full = 1;
+    }
+}
+
+/**
+ * \brief           Finish operator scan
+ * \param[in]       ok: Set to `1` when all operators of scan were received
+ */
+void
+gsmi_operator_cache_finish(uint8_t ok) {
+    scan_valid = ok && !scan_full;
+    scan_time = gsm_sys_now();
+}
+
+/**
+ * \brief           Get operators of last scan if not older than \ref GSM_CFG_OPERATOR_CACHE_TTL
+ * \param[out]      ops: Pointer to array to write found operators
+ * \param[in]       opsl: Length of input array in units of elements
+ * \param[out]      opf: Pointer to ouput variable to save number of operators found
+ * \return          \ref gsmOK if operators were copied from cache, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsmi_operator_cache_scan(gsm_operator_t* ops, size_t opsl, size_t* opf) {
+    gsmr_t res = gsmERR;
+    size_t n;
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    if (scan_valid && (uint32_t)(gsm_sys_now() - scan_time) < GSM_CFG_OPERATOR_CACHE_TTL) {
+        n = GSM_MIN(scan_cnt, opsl);
+        memcpy(ops, scan_ops, n * sizeof(*ops));
+        if (opf != NULL) {
+            *opf = n;
+        }
+        res = gsmOK;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Start loading operator names table, called before `+COPN` is sent
+ */
+void
+gsmi_operator_names_start(void) {
+    names_cnt = 0;
+    names_sorted = 0;
+    names_pool_used = 0;
+    names_full = 0;
+}
+
+/**
+ * \brief           Add operator name received with `+COPN` to end of table
+ *
+ *                  Table is sorted once when all names are received
+ *
+ * \param[in]       num: Operator numeric code
+ * \param[in]       name: Operator long alphanumeric name
+ */
+void
+gsmi_operator_names_add(uint32_t num, const char* name) {
+    size_t len = strlen(name) + 1;
+
+    if (names_cnt >= GSM_ARRAYSIZE(names) || names_pool_used + len > sizeof(names_pool)) {
+        names_full = 1;
+        return;
+    }
+    names[names_cnt].num[0] = (uint16_t)(num >> 16);
+    names[names_cnt].num[1] = (uint16_t)num;
+    names[names_cnt].name = (uint16_t)names_pool_used;
+    memcpy(&names_pool[names_pool_used], name, len);
+    names_pool_used += len;
+    names_cnt++;
+}
+
+/**
+ * \brief           Finish loading operator names table
+ *
+ *                  Table is sorted by numeric code and only first received name of every code is kept
+ *
+ * \param[in]       ok: Set to `1` when `+COPN` finished successfully
+ * \return          \ref gsmOK on success, \ref gsmERRMEM if not all names fit to table, \ref gsmERR otherwise
+ */
+gsmr_t
+gsmi_operator_names_finish(uint8_t ok) {
+    size_t i, n = 0;
+
+    qsort(names, names_cnt, sizeof(names[0]), name_cmp);
+    for (i = 0; i < names_cnt; i++) {           /* Remove duplicated codes */
+        if (n == 0 || name_get_num(&names[i]) != name_get_num(&names[n - 1])) {
+            names[n++] = names[i];
+        }
+    }
+    names_cnt = n;
+    names_sorted = n;
+    if (!ok) {
+        return gsmERR;
+    }
+    return names_full ? gsmERRMEM : gsmOK;
+}
+
+/**
+ * \brief           Invalidate cached operator scan, so next scan is sent to network
+ */
+void
+gsm_operator_cache_invalidate(void) {
+    GSM_CORE_PROTECT();                         /* Protect core */
+    scan_valid = 0;
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+}
+
+/**
+ * \brief           Resolve operator numeric code to name without communication with device
+ * \note            Names table must be loaded first with \ref gsm_operator_names_load
+ * \param[in]       num: Operator numeric code, `MCC` followed by `MNC`, as in \ref gsm_operator_t
+ * \param[out]      name: Output buffer for operator name
+ * \param[in]       len: Length of output buffer including zero termination
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_operator_name_find(uint32_t num, char* name, size_t len) {
+    gsmr_t res = gsmERR;
+    size_t i;
+
+    GSM_ASSERT("name != NULL", name != NULL);   /* Assert input parameters */
+    GSM_ASSERT("len > 0", len > 0);             /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    i = names_lower_bound(num);
+    if (i < names_sorted && name_get_num(&names[i]) == num) {
+        strncpy(name, &names_pool[names[i].name], len - 1);
+        name[len - 1] = '\0';
+        res = gsmOK;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+#endif /* GSM_CFG_OPERATOR_CACHE || __DOXYGEN__ */
@@ -297,6 +297,9 @@ gsmi_parse_memories_string(const char** src, uint32_t* mem_dst) {
  */
 uint8_t
 gsmi_parse_creg(const char* str, uint8_t skip_first) {
+#if GSM_CFG_NETWORK_REG
+    return gsmi_parse_reg(str, GSM_NETWORK_REG_DOMAIN_CS, skip_first);
+#else /* GSM_CFG_NETWORK_REG */
     uint8_t cb = 0;
     if (*str == '+') {
         str += 7;
@@ -328,8 +331,48 @@ gsmi_parse_creg(const char* str, uint8_t skip_first) {
     }
 
     return 1;
+#endif /* !GSM_CFG_NETWORK_REG */
 }
 
+#if GSM_CFG_NETWORK_REG || __DOXYGEN__
+
+/**
+ * \brief           Parse received +CREG, +CGREG or +CEREG message with location info
+ * \param[in]       str: Input string
+ * \param[in]       domain: Registration domain of message
+ * \param[in]       skip_first: Set to `1` to skip first number, used for response to read command
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_reg(const char* str, gsm_network_reg_domain_t domain, uint8_t skip_first) {
+    gsm_network_reg_t reg;
+
+    if (*str == '+') {
+        str += domain == GSM_NETWORK_REG_DOMAIN_CS ? 7 : 8;
+    }
+
+    if (skip_first) {
+        gsmi_parse_number(&str);
+    }
+    memset(&reg, 0x00, sizeof(reg));
+    reg.act = GSM_OPERATOR_ACT_UNKNOWN;
+    reg.status = (gsm_network_reg_status_t)gsmi_parse_number(&str);
+    if (*str == '"') {                          /* Location info is available */
+        reg.lac = gsmi_parse_hexnumber(&str);
+        reg.ci = gsmi_parse_hexnumber(&str);
+        if (*str == '"') {
+            str++;
+        }
+        if (*str == ',') {
+            reg.act = (gsm_operator_act_t)gsmi_parse_number(&str);
+        }
+    }
+    gsmi_network_reg_update(domain, &reg, skip_first);  /* Response to read command starts with mode */
+    return 1;
+}
+
+#endif /* GSM_CFG_NETWORK_REG || __DOXYGEN__ */
+
 /**
  * \brief           Parse received +CSQ signal value
  * \param[in]       str: Input string
@@ -447,7 +490,7 @@ gsmi_parse_cops_scan(uint8_t ch, uint8_t reset) {
         struct {
             uint8_t bo:1;                       /*!< Bracket open flag (Bracket Open) */
             uint8_t ccd:1;                      /*!< 2 consecutive commas detected in a row (Comma Comma Detected) */
-            uint8_t tn:2;                       /*!< Term number in response, 2 bits for 4 diff values */
+            uint8_t tn:3;                       /*!< Term number in response, 3 bits for up to 8 diff values */
             uint8_t tp;                         /*!< Current term character position */
             uint8_t ch_prev;                    /*!< Previous character */
         } f;
@@ -467,8 +510,19 @@ gsmi_parse_cops_scan(uint8_t ch, uint8_t reset) {
         }
     }
  
-    if (u.f.ccd ||                              /* Ignore data after 2 commas in a row */
-        gsm.msg->msg.cops_scan.opsi >= gsm.msg->msg.cops_scan.opsl) {   /* or if array is full */
+    if (u.f.ccd || gsm.msg->msg.cops_scan.stop) {   /* Ignore data after 2 commas in a row or after cancel */
+        return 1;
+    }
+    if (gsm.msg->msg.cops_scan.opsi >= gsm.msg->msg.cops_scan.opsl) {   /* Ignore operators if array is full */
+#if GSM_CFG_OPERATOR_CACHE
+        if (ch == '(') {
+            gsmi_operator_cache_add(NULL);      /* Scan result does not fit, do not cache it */
+        }
+#endif /* GSM_CFG_OPERATOR_CACHE */
+        if (ch == ',' && u.f.ch_prev == ',') {
+            u.f.ccd = 1;                        /* 2 commas in a row, end of operators list */
+        }
+        u.f.ch_prev = ch;
         return 1;
     }
 
@@ -477,9 +531,24 @@ gsmi_parse_cops_scan(uint8_t ch, uint8_t reset) {
             u.f.bo = 0;                         /* Clear bracket open flag */
             u.f.tn = 0;                         /* Go to next term */
             u.f.tp = 0;                         /* Go to beginning of next term */
-            gsm.msg->msg.cops_scan.opsi++;      /* Increase index */
-            if (gsm.msg->msg.cops_scan.opf != NULL) {
-                *gsm.msg->msg.cops_scan.opf = gsm.msg->msg.cops_scan.opsi;
+#if GSM_CFG_OPERATOR_CACHE
+            gsmi_operator_cache_add(&gsm.msg->msg.cops_scan.ops[gsm.msg->msg.cops_scan.opsi]);
+#endif /* GSM_CFG_OPERATOR_CACHE */
+            if (gsm.msg->msg.cops_scan.fn != NULL) {    /* Pass operator to user and reuse buffer */
+                gsm.msg->msg.cops_scan.en++;
+                if (gsm.msg->msg.cops_scan.fn(gsm.msg->msg.cops_scan.ops, gsm.msg->msg.cops_scan.fn_arg) != gsmOK) {
+                    gsm.msg->msg.cops_scan.stop = 1;    /* Cancel remaining scan */
+                    GSM_AT_PORT_SEND_STR("\r");        /* Any character aborts command on modem */
+                    GSM_AT_PORT_SEND_FLUSH();
+                }
+                if (gsm.msg->msg.cops_scan.opf != NULL) {
+                    *gsm.msg->msg.cops_scan.opf = gsm.msg->msg.cops_scan.en;
+                }
+            } else {
+                gsm.msg->msg.cops_scan.opsi++;  /* Increase index */
+                if (gsm.msg->msg.cops_scan.opf != NULL) {
+                    *gsm.msg->msg.cops_scan.opf = gsm.msg->msg.cops_scan.opsi;
+                }
             }
         } else if (ch == ',') {
             u.f.tn++;                           /* Go to next term */
@@ -509,12 +578,18 @@ gsmi_parse_cops_scan(uint8_t ch, uint8_t reset) {
                     gsm.msg->msg.cops_scan.ops[i].num = (10 * gsm.msg->msg.cops_scan.ops[i].num) + (ch - '0');
                     break;
                 }
+                case 4: {                       /*!< Parse access technology */
+                    gsm.msg->msg.cops_scan.ops[i].act = (gsm_operator_act_t)((u.f.tp++ ? 10 * (size_t)gsm.msg->msg.cops_scan.ops[i].act : 0) + (ch - '0'));
+                    break;
+                }
                 default: break;
             }
         }
     } else {
         if (ch == '(') {                        /* Check for opening bracket */
             u.f.bo = 1;
+            memset(&gsm.msg->msg.cops_scan.ops[gsm.msg->msg.cops_scan.opsi], 0x00, sizeof(gsm.msg->msg.cops_scan.ops[0]));
+            gsm.msg->msg.cops_scan.ops[gsm.msg->msg.cops_scan.opsi].act = GSM_OPERATOR_ACT_UNKNOWN;
         } else if (ch == ',' && u.f.ch_prev == ',') {
             u.f.ccd = 1;                        /* 2 commas in a row */
         }
@@ -523,6 +598,29 @@ gsmi_parse_cops_scan(uint8_t ch, uint8_t reset) {
     return 1;
 }
 
+#if GSM_CFG_OPERATOR_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Parse +COPN statement and add it to operator names table
+ * \param[in]       str: Input string
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_copn(const char* str) {
+    char num[8], name[24];
+    const char* n = num;
+
+    if (*str == '+') {
+        str += 7;
+    }
+    gsmi_parse_string(&str, num, sizeof(num), 1);
+    gsmi_parse_string(&str, name, sizeof(name), 1);
+    gsmi_operator_names_add(GSM_U32(gsmi_parse_number(&n)), name);
+    return 1;
+}
+
+#endif /* GSM_CFG_OPERATOR_CACHE || __DOXYGEN__ */
+
 /**
  * \brief           Parse datetime in format dd/mm/yy,hh:mm:ss
  * \param[in]       src: Pointer to pointer to input string
@@ -578,6 +676,7 @@ gsmi_parse_clcc(const char* str, uint8_t send_evt) {
 
 /**
  * \brief           Parse string and check for type of SMS state
+ * \note            Numeric status, used in PDU mode, is also accepted
  * \param[in]       src: Pointer to pointer to string to parse
  * \param[out]      stat: Output status variable
  * \return          1 on success, 0 otherwise
@@ -587,6 +686,20 @@ gsmi_parse_sms_status(const char** src, gsm_sms_status_t* stat) {
     gsm_sms_status_t s;
     char t[11];
 
+    if (GSM_CHARISNUM(**src)) {                 /* Numeric status in PDU mode */
+        switch (gsmi_parse_number(src)) {
+            case 0: s = GSM_SMS_STATUS_UNREAD; break;
+            case 1: s = GSM_SMS_STATUS_READ; break;
+            case 2: s = GSM_SMS_STATUS_UNSENT; break;
+            case 3: s = GSM_SMS_STATUS_SENT; break;
+            default: s = GSM_SMS_STATUS_ALL; break; /* Error! */
+        }
+        if (s != GSM_SMS_STATUS_ALL) {
+            *stat = s;
+            return 1;
+        }
+        return 0;
+    }
     gsmi_parse_string(src, t, sizeof(t), 1);    /* Parse string and advance */
     if (!strcmp(t, "REC UNREAD")) {
         s = GSM_SMS_STATUS_UNREAD;
@@ -620,9 +733,21 @@ gsmi_parse_cmgs(const char* str, uint8_t send_evt) {
     }
 
     num = gsmi_parse_number(&str);              /* Parse number */
+    if (gsm.msg->msg.sms_send.batch != NULL) {  /* Save message reference to batch entry */
+        gsm.msg->msg.sms_send.batch[gsm.msg->msg.sms_send.batch_i].mr = num;
+    }
+#if GSM_CFG_SMS_REPORT
+    if (gsm.sms.report) {                       /* Wait for status report of message */
+        gsmi_sms_report_add((uint8_t)num, gsm.msg->msg.sms_send.tag);
+    }
+#endif /* GSM_CFG_SMS_REPORT */
 
     if (send_evt) {
         gsm.cb.cb.sms_sent.num = num;
+#if GSM_CFG_SMS_PDU
+        gsm.cb.cb.sms_sent.part = gsm.msg->msg.sms_send.part + 1;
+        gsm.cb.cb.sms_sent.parts = gsm.msg->msg.sms_send.parts;
+#endif /* GSM_CFG_SMS_PDU */
         gsmi_send_cb(GSM_CB_SMS_SENT);          /* SIM card event */
     }
     return 1;
@@ -643,9 +768,13 @@ gsmi_parse_cmgr(const char* str) {
     
     e = gsm.msg->msg.sms_read.entry;
     gsmi_parse_sms_status(&str, &e->status);
+#if GSM_CFG_SMS_PDU
+    gsmi_parse_string(&str, e->name, sizeof(e->name), 1);   /* Number and date are part of PDU */
+#else /* GSM_CFG_SMS_PDU */
     gsmi_parse_string(&str, e->number, sizeof(e->number), 1);
     gsmi_parse_string(&str, e->name, sizeof(e->name), 1);
     gsmi_parse_datetime(&str, &e->datetime);
+#endif /* !GSM_CFG_SMS_PDU */
 
     return 1;
 }
@@ -660,7 +789,7 @@ uint8_t
 gsmi_parse_cmgl(const char* str) {
     gsm_sms_entry_t* e;
 
-    if (!CMD_IS_DEF(GSM_CMD_CMGL) ||
+    if (!CMD_IS_DEF(GSM_CMD_CMGL) || gsm.msg->msg.sms_list.stop ||
         gsm.msg->msg.sms_list.ei >= gsm.msg->msg.sms_list.etr) {
         return 0;
     }
@@ -670,16 +799,130 @@ gsmi_parse_cmgl(const char* str) {
     }
 
     e = &gsm.msg->msg.sms_list.entries[gsm.msg->msg.sms_list.ei];
+    if (gsm.msg->msg.sms_list.fn != NULL) {     /* Single entry buffer is reused in streaming mode */
+        memset(e, 0x00, sizeof(*e));
+    }
     e->mem = gsm.msg->msg.sms_list.mem;         /* Manually set memory */
     e->pos = GSM_SZ(gsmi_parse_number(&str));   /* Scan position */
     gsmi_parse_sms_status(&str, &e->status);
+#if GSM_CFG_SMS_PDU
+    gsmi_parse_string(&str, e->name, sizeof(e->name), 1);   /* Number and date are part of PDU */
+#else /* GSM_CFG_SMS_PDU */
     gsmi_parse_string(&str, e->number, sizeof(e->number), 1);
     gsmi_parse_string(&str, e->name, sizeof(e->name), 1);
     gsmi_parse_datetime(&str, &e->datetime);
+#endif /* !GSM_CFG_SMS_PDU */
 
     return 1;
 }
 
+#if GSM_CFG_SMS_DIRECT || __DOXYGEN__
+
+/**
+ * \brief           Parse +CMT header of directly delivered SMS
+ *
+ *                  Header is `+CMT: [<alpha>],<length>` in PDU mode
+ *                  or `+CMT: <oa>,[<alpha>],<scts>` in text mode
+ *
+ * \param[in]       str: Input string
+ * \param[out]      e: Entry to fill with header info
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_cmt(const char* str, gsm_sms_entry_t* e) {
+    if (*str == '+') {
+        str += 6;
+    }
+
+    memset(e, 0x00, sizeof(*e));
+    e->mem = GSM_MEM_UNKNOWN;                   /* Message is not stored to memory */
+    e->status = GSM_SMS_STATUS_UNREAD;
+#if GSM_CFG_SMS_PDU
+    if (*str == '"') {                          /* Number and date are part of PDU */
+        gsmi_parse_string(&str, e->name, sizeof(e->name), 1);
+    }
+#else /* GSM_CFG_SMS_PDU */
+    gsmi_parse_string(&str, e->number, sizeof(e->number), 1);
+    if (str[0] == ',' && str[1] == '"') {       /* Name is optional */
+        gsmi_parse_string(&str, e->name, sizeof(e->name), 1);
+    } else if (*str == ',') {
+        str++;
+    }
+    gsmi_parse_datetime(&str, &e->datetime);
+#endif /* !GSM_CFG_SMS_PDU */
+
+    return 1;
+}
+
+#endif /* GSM_CFG_SMS_DIRECT || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+
+/**
+ * \brief           Parse +CDS status report in text mode
+ *
+ *                  Report is `+CDS: <fo>,<mr>,[<ra>],[<tora>],<scts>,<dt>,<st>`
+ *
+ * \param[in]       str: Input string
+ * \param[out]      r: Report to fill
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_cds(const char* str, gsm_sms_report_t* r) {
+    gsm_datetime_t scts;
+
+    if (*str == '+') {
+        str += 6;
+    }
+
+    memset(r, 0x00, sizeof(*r));
+    gsmi_parse_number(&str);                    /* Skip first octet */
+    r->mr = (uint8_t)gsmi_parse_number(&str);
+    if (*str == '"') {                          /* Recipient address is optional */
+        gsmi_parse_string(&str, r->number, sizeof(r->number), 1);
+    } else if (*str == ',') {
+        str++;
+    }
+    gsmi_parse_number(&str);                    /* Skip type of address */
+    gsmi_parse_datetime(&str, &scts);           /* Skip time when message was received by network */
+    gsmi_parse_datetime(&str, &r->datetime);
+    r->st = (uint8_t)gsmi_parse_number(&str);
+
+    return 1;
+}
+
+/**
+ * \brief           Parse +CSMP statement with text mode parameters
+ *
+ *                  Statement is `+CSMP: <fo>,<vp>,<pid>,<dcs>`. Parameters after first octet
+ *                  are saved as received, to be sent back unchanged
+ *
+ * \param[in]       str: Input string
+ * \return          1 on success, 0 otherwise
+ */
+uint8_t
+gsmi_parse_csmp(const char* str) {
+    char* params = gsm.msg->msg.sms_cnmi.params;
+    size_t i;
+
+    if (*str == '+') {
+        str += 7;
+    }
+
+    gsm.msg->msg.sms_cnmi.fo = (uint8_t)gsmi_parse_number(&str);
+    for (i = 0; str[i] != '\0' && str[i] != '\r' && str[i] != '\n'; i++) {
+        if (i >= sizeof(gsm.msg->msg.sms_cnmi.params) - 1) {
+            params[0] = 0;                      /* Do not send incomplete parameters, device keeps omitted ones */
+            return 0;
+        }
+        params[i] = str[i];
+    }
+    params[i] = 0;
+    return 1;
+}
+
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
+
 /**
  * \brief           Parse received +CMTI with received SMS info
  * \param[in]       str: Input string
@@ -694,6 +937,17 @@ gsmi_parse_cmti(const char* str, uint8_t send_evt) {
 
     gsm.cb.cb.sms_recv.mem = gsmi_parse_memory(&str);   /* Parse memory string */
     gsm.cb.cb.sms_recv.pos = gsmi_parse_number(&str);   /* Parse number */
+#if GSM_CFG_SMS_MIRROR
+    gsmi_sms_mirror_add(gsm.cb.cb.sms_recv.mem, gsm.cb.cb.sms_recv.pos);    /* New message in memory */
+#endif /* GSM_CFG_SMS_MIRROR */
+#if GSM_CFG_SMS_WATERMARK
+    gsmi_sms_watermark_update(gsm.cb.cb.sms_recv.mem, 1);  /* One more message in memory */
+#endif /* GSM_CFG_SMS_WATERMARK */
+#if GSM_CFG_SMS_DRAIN
+    if (gsmi_sms_drain_notify(gsm.cb.cb.sms_recv.mem)) {
+        send_evt = 0;                           /* Message is reported with batch event */
+    }
+#endif /* GSM_CFG_SMS_DRAIN */
 
     if (send_evt) {
         gsmi_send_cb(GSM_CB_SMS_RECV);          /* SIM card event */
@@ -739,6 +993,11 @@ gsmi_parse_cpms(const char* str, uint8_t opt) {
         }
         default: break;
     }
+#if GSM_CFG_SMS_WATERMARK
+    if (opt) {
+        gsmi_sms_watermark_update(gsm.sms.mem[2].current, 0); /* Check usage of memory for received messages */
+    }
+#endif /* GSM_CFG_SMS_WATERMARK */
     return 1;
 }
 
@@ -784,22 +1043,49 @@ gsmi_parse_cpbs(const char* str, uint8_t opt) {
 uint8_t
 gsmi_parse_cpbr(const char* str) {
     gsm_pb_entry_t* e;
-
-    if (!CMD_IS_DEF(GSM_CMD_CPBR) ||
+#if GSM_CFG_PB_SYNC
+    gsm_pb_entry_t se;
+
+    if (CMD_IS_DEF(GSM_CMD_PHONEBOOK_SYNC)) {
+        e = &se;                                /* Entry is only compared, no need to store it */
+    } else
+#endif /* GSM_CFG_PB_SYNC */
+    if (!CMD_IS_DEF(GSM_CMD_CPBR) || gsm.msg->msg.pb_list.stop ||
         gsm.msg->msg.pb_list.ei >= gsm.msg->msg.pb_list.etr) {
         return 0;
+    } else {
+        e = &gsm.msg->msg.pb_list.entries[gsm.msg->msg.pb_list.ei];
+        if (gsm.msg->msg.pb_list.fn != NULL) {  /* Single entry buffer is reused in streaming mode */
+            memset(e, 0x00, sizeof(*e));
+            e->mem = gsmi_pb_get_op_mem(gsm.msg);
+        }
     }
 
     if (*str == '+') {
         str += 7;
     }
     
-    e = &gsm.msg->msg.pb_list.entries[gsm.msg->msg.pb_list.ei];
     e->pos = GSM_SZ(gsmi_parse_number(&str));
     gsmi_parse_string(&str, e->name, sizeof(e->name), 1);
     e->type = (gsm_number_type_t)gsmi_parse_number(&str);
     gsmi_parse_string(&str, e->number, sizeof(e->number), 1);
 
+#if GSM_CFG_PB_SYNC
+    if (e == &se) {
+        gsmi_pb_sync_read(gsm.msg, e);
+        return 1;
+    }
+#endif /* GSM_CFG_PB_SYNC */
+    if (gsm.msg->msg.pb_list.fn != NULL) {      /* Pass entry to user and reuse buffer */
+        gsm.msg->msg.pb_list.en++;
+        if (gsm.msg->msg.pb_list.fn(e, gsm.msg->msg.pb_list.fn_arg) != gsmOK) {
+            gsm.msg->msg.pb_list.stop = 1;      /* Ignore remaining entries */
+        }
+        if (gsm.msg->msg.pb_list.er != NULL) {
+            *gsm.msg->msg.pb_list.er = gsm.msg->msg.pb_list.en;
+        }
+        return 1;
+    }
     gsm.msg->msg.pb_list.ei++;
     if (gsm.msg->msg.pb_list.er != NULL) {
         *gsm.msg->msg.pb_list.er = gsm.msg->msg.pb_list.ei;
@@ -0,0 +1,493 @@
+/**
+ * \file            gsm_pb_cache.c
+ * \brief           Phonebook cache with number and name indexes
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_phonebook.h"
+
+#if GSM_CFG_PB_CACHE || __DOXYGEN__
+
+#define CACHE_HASH_SIZE                 (2 * GSM_CFG_PB_CACHE_SIZE)
+#define CACHE_LOWER(c)                  ((c) >= 'A' && (c) <= 'Z' ? (c) - 'A' + 'a' : (c))
+
+static gsm_pb_entry_t cache_entries[GSM_CFG_PB_CACHE_SIZE]; /*!< Cached entries, entry with position `0` is free */
+static uint16_t cache_num[CACHE_HASH_SIZE];     /*!< Open addressing table of entry indexes plus `1`, hashed by number key */
+static uint16_t cache_name[GSM_CFG_PB_CACHE_SIZE];  /*!< Entry indexes sorted by name */
+static size_t cache_cnt;                        /*!< Number of cached entries */
+static gsm_mem_t cache_mem = GSM_MEM_UNKNOWN;   /*!< Memory of cached entries */
+static uint8_t cache_valid;                     /*!< Flag indicating memory is cached completely */
+static uint8_t cache_load;                      /*!< Flag indicating cache is being loaded */
+
+/**
+ * \brief           Get key of phone number
+ *
+ *                  Key consists of last \ref GSM_CFG_PB_CACHE_MATCH_DIGITS digits only,
+ *                  so number in national and international format gives the same key
+ *
+ * \param[in]       num: Phone number
+ * \param[out]      key: Output buffer of `GSM_CFG_PB_CACHE_MATCH_DIGITS + 1` bytes
+ * \return          Number of digits in key
+ */
+static size_t
+cache_num_key(const char* num, char* key) {
+    const char* p;
+    size_t n = 0, skip = 0;
+
+    for (p = num; *p != '\0'; p++) {
+        if (GSM_CHARISNUM(*p)) {
+            skip++;
+        }
+    }
+    skip = skip > GSM_CFG_PB_CACHE_MATCH_DIGITS ? skip - GSM_CFG_PB_CACHE_MATCH_DIGITS : 0;
+    for (p = num; *p != '\0'; p++) {
+        if (GSM_CHARISNUM(*p)) {
+            if (skip > 0) {
+                skip--;
+            } else {
+                key[n++] = *p;
+            }
+        }
+    }
+    key[n] = '\0';
+    return n;
+}
+
+/**
+ * \brief           Get home slot of number key in hash table
+ * \param[in]       key: Number key
+ * \return          Slot index
+ */
+static size_t
+cache_num_hash(const char* key) {
+    uint32_t h = 2166136261UL;                  /* FNV-1a */
+
+    for (; *key != '\0'; key++) {
+        h = (h ^ (uint8_t)*key) * 16777619UL;
+    }
+    return (size_t)(h % CACHE_HASH_SIZE);
+}
+
+/**
+ * \brief           Find hash slot of entry with number key
+ * \param[in]       key: Number key
+ * \return          Slot index, slot is free when number is not cached
+ */
+static size_t
+cache_num_find(const char* key) {
+    char k[GSM_CFG_PB_CACHE_MATCH_DIGITS + 1];
+    size_t i;
+
+    for (i = cache_num_hash(key); cache_num[i] != 0; i = (i + 1) % CACHE_HASH_SIZE) {
+        cache_num_key(cache_entries[cache_num[i] - 1].number, k);
+        if (!strcmp(k, key)) {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * \brief           Remove entry from number hash table
+ *
+ *                  Following slots of the same probe sequence are moved back,
+ *                  so lookups never stop on a hole
+ *
+ * \param[in]       idx: Entry index
+ */
+static void
+cache_num_remove(size_t idx) {
+    char k[GSM_CFG_PB_CACHE_MATCH_DIGITS + 1];
+    size_t i, j, home;
+
+    if (cache_num_key(cache_entries[idx].number, k) == 0) {
+        return;                                 /* Entry without number is not indexed */
+    }
+    for (i = cache_num_hash(k); cache_num[i] != idx + 1; i = (i + 1) % CACHE_HASH_SIZE) {
+        if (cache_num[i] == 0) {
+            return;
+        }
+    }
+    cache_num[i] = 0;
+    j = i;
+    while (1) {
+        j = (j + 1) % CACHE_HASH_SIZE;
+        if (cache_num[j] == 0) {
+            break;
+        }
+        cache_num_key(cache_entries[cache_num[j] - 1].number, k);
+        home = cache_num_hash(k);
+        if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) {
+            continue;                           /* Entry is still reachable from its home slot */
+        }
+        cache_num[i] = cache_num[j];            /* Move entry to the hole */
+        cache_num[j] = 0;
+        i = j;
+    }
+}
+
+/**
+ * \brief           Compare names without case sensitivity
+ * \param[in]       a: First name
+ * \param[in]       b: Second name
+ * \param[in]       len: Maximal number of characters to compare
+ * \return          Negative, zero or positive value when first name is lower, equal or greater
+ */
+static int
+cache_name_cmp(const char* a, const char* b, size_t len) {
+    int d;
+
+    for (; len > 0; a++, b++, len--) {
+        d = CACHE_LOWER((uint8_t)*a) - CACHE_LOWER((uint8_t)*b);
+        if (d != 0 || *a == '\0') {
+            return d;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Find first position in name index not lower than name
+ * \param[in]       name: Name or name prefix
+ * \param[in]       len: Number of characters to compare
+ * \return          Position in name index
+ */
+static size_t
+cache_name_lower(const char* name, size_t len) {
+    size_t lo = 0, hi = cache_cnt, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (cache_name_cmp(cache_entries[cache_name[mid]].name, name, len) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * \brief           Remove entry at position in memory
+ * \param[in]       pos: Position in memory
+ */
+static void
+cache_del(size_t pos) {
+    size_t idx, i;
+
+    if (pos == 0) {
+        return;
+    }
+    for (idx = 0; idx < GSM_CFG_PB_CACHE_SIZE && cache_entries[idx].pos != pos; idx++) {}
+    if (idx == GSM_CFG_PB_CACHE_SIZE) {
+        return;
+    }
+    cache_num_remove(idx);
+    for (i = 0; cache_name[i] != idx; i++) {}
+    memmove(&cache_name[i], &cache_name[i + 1], (cache_cnt - i - 1) * sizeof(cache_name[0]));
+    cache_cnt--;
+    cache_entries[idx].pos = 0;
+}
+
+/**
+ * \brief           Add entry to cache or replace entry at the same position
+ * \param[in]       e: Entry to add
+ * \return          `1` on success, `0` if cache is full
+ */
+static uint8_t
+cache_put(const gsm_pb_entry_t* e) {
+    char k[GSM_CFG_PB_CACHE_MATCH_DIGITS + 1];
+    size_t idx, i;
+
+    cache_del(e->pos);
+    for (idx = 0; idx < GSM_CFG_PB_CACHE_SIZE && cache_entries[idx].pos != 0; idx++) {}
+    if (idx == GSM_CFG_PB_CACHE_SIZE) {
+        return 0;
+    }
+    memcpy(&cache_entries[idx], e, sizeof(*e));
+    cache_entries[idx].mem = cache_mem;
+    if (cache_num_key(e->number, k) > 0) {
+        for (i = cache_num_hash(k); cache_num[i] != 0; i = (i + 1) % CACHE_HASH_SIZE) {}
+        cache_num[i] = (uint16_t)(idx + 1);
+    }
+    i = cache_name_lower(e->name, sizeof(e->name));
+    memmove(&cache_name[i + 1], &cache_name[i], (cache_cnt - i) * sizeof(cache_name[0]));
+    cache_name[i] = (uint16_t)idx;
+    cache_cnt++;
+    return 1;
+}
+
+/**
+ * \brief           Copy entries with name prefix from cache
+ * \param[in]       name: Name prefix
+ * \param[out]      entries: Pointer to array to save entries
+ * \param[in]       etr: Number of entries to read
+ * \return          Number of entries in array
+ */
+static size_t
+cache_find_name(const char* name, gsm_pb_entry_t* entries, size_t etr) {
+    size_t i, n = 0, len = strlen(name);
+
+    for (i = cache_name_lower(name, len); i < cache_cnt && n < etr
+            && cache_name_cmp(cache_entries[cache_name[i]].name, name, len) == 0; i++) {
+        memcpy(&entries[n++], &cache_entries[cache_name[i]], sizeof(*entries));
+    }
+    return n;
+}
+
+/**
+ * \brief           Replace \ref GSM_MEM_CURRENT with memory currently selected on device
+ * \param[in]       mem: Memory to resolve
+ * \return          Device memory
+ */
+static gsm_mem_t
+cache_resolve_mem(gsm_mem_t mem) {
+    return mem == GSM_MEM_CURRENT ? gsm.pb.mem.current : mem;
+}
+
+/**
+ * \brief           Start loading of memory, all cached entries are removed
+ * \param[in]       mem: Device memory
+ */
+void
+gsmi_pb_cache_load_start(gsm_mem_t mem) {
+    gsmi_pb_cache_invalidate();
+    cache_mem = mem;
+    cache_load = 1;
+}
+
+/**
+ * \brief           Store chunk of entries read with `+CPBR` command and prepare next chunk
+ *
+ *                  Loading is finished when all positions of memory are read
+ *                  or when number of cached entries reaches number of used entries
+ *
+ * \param[in]       msg: Current message with read entries
+ * \param[in]       ok: Set to `1` if chunk was read successfully
+ * \return          \ref gsmCONT if next chunk shall be read, \ref gsmOK when cache is loaded, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsmi_pb_cache_load_chunk(gsm_msg_t* msg, uint8_t ok) {
+    size_t i;
+
+    if (!cache_load) {
+        return gsmERR;                          /* Cache was invalidated during load */
+    }
+    for (i = 0; ok && i < msg->msg.pb_list.ei; i++) {
+        ok = cache_put(&msg->msg.pb_list.entries[i]);   /* Fails when cache is full */
+    }
+    if (ok && gsmi_pb_page_next(&msg->msg.pb_list.start_index, msg->msg.pb_list.etr, cache_cnt)) {
+        msg->msg.pb_list.ei = 0;
+        return gsmCONT;
+    }
+    cache_load = 0;
+    cache_valid = ok;
+    msg->msg.pb_list.ei = cache_cnt;            /* Report number of cached entries */
+    return ok ? gsmOK : gsmERR;
+}
+
+/**
+ * \brief           Get free position in cached memory for new entry
+ * \param[in]       mem: Device memory
+ * \return          Lowest free position or `0` if memory is not cached or is full
+ */
+size_t
+gsmi_pb_cache_free_pos(gsm_mem_t mem) {
+    size_t pos, i;
+
+    if (!cache_valid || mem != cache_mem) {
+        return 0;
+    }
+    for (pos = 1; pos <= gsm.pb.mem.total; pos++) {
+        for (i = 0; i < GSM_CFG_PB_CACHE_SIZE && cache_entries[i].pos != pos; i++) {}
+        if (i == GSM_CFG_PB_CACHE_SIZE) {
+            return pos;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Update cache after entry was written or deleted on device
+ * \param[in]       mem: Device memory
+ * \param[in]       pos: Written position or `0` if position was selected by device
+ * \param[in]       name: Entry name or `NULL` when entry was deleted
+ * \param[in]       num: Entry phone number
+ * \param[in]       type: Entry phone number type
+ */
+void
+gsmi_pb_cache_update(gsm_mem_t mem, size_t pos, const char* name, const char* num, gsm_number_type_t type) {
+    gsm_pb_entry_t e;
+
+    if (!(cache_valid || cache_load) || mem != cache_mem) {
+        return;
+    }
+    if (pos == 0) {                             /* Position selected by device is not known */
+        gsmi_pb_cache_invalidate();
+    } else if (name == NULL) {
+        cache_del(pos);
+    } else {
+        memset(&e, 0x00, sizeof(e));
+        e.pos = pos;
+        strncpy(e.name, name, sizeof(e.name) - 1);
+        strncpy(e.number, num, sizeof(e.number) - 1);
+        e.type = type;
+        if (!cache_put(&e)) {
+            gsmi_pb_cache_invalidate();         /* Memory does not fit to cache anymore */
+        }
+    }
+}
+
+/**
+ * \brief           Invalidate complete cache
+ * \note            Must be called when device is reset
+ */
+void
+gsmi_pb_cache_invalidate(void) {
+    memset(cache_entries, 0x00, sizeof(cache_entries));
+    memset(cache_num, 0x00, sizeof(cache_num));
+    cache_cnt = 0;
+    cache_mem = GSM_MEM_UNKNOWN;
+    cache_valid = 0;
+    cache_load = 0;
+}
+
+/**
+ * \brief           Search entries in cache instead of device
+ * \param[in]       mem: Memory to search
+ * \param[in]       search: Name prefix to search for
+ * \param[out]      entries: Pointer to array to save entries
+ * \param[in]       etr: Number of entries to read
+ * \param[out]      er: Pointer to output variable to save number of entries in array
+ * \return          \ref gsmOK if entries were found in cache and \ref GSM_CB_PB_SEARCH event sent, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsmi_pb_cache_search(gsm_mem_t mem, const char* search, gsm_pb_entry_t* entries, size_t etr, size_t* er) {
+    gsmr_t res = gsmERR;
+    size_t n;
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    mem = cache_resolve_mem(mem);
+    if (cache_valid && mem == cache_mem) {
+        n = cache_find_name(search, entries, etr);
+        if (er != NULL) {
+            *er = n;
+        }
+        gsm.cb.cb.pb_search.mem = mem;
+        gsm.cb.cb.pb_search.search = search;
+        gsm.cb.cb.pb_search.entries = entries;
+        gsm.cb.cb.pb_search.size = n;
+        gsm.cb.cb.pb_search.err = gsmOK;
+        gsmi_send_cb(GSM_CB_PB_SEARCH);         /* Send to user */
+        res = gsmOK;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Check if phonebook memory is cached completely
+ * \param[in]       mem: Memory to check. Use \ref GSM_MEM_CURRENT to check current memory
+ * \return          `1` if cache is valid, `0` otherwise
+ */
+uint8_t
+gsm_pb_cache_is_valid(gsm_mem_t mem) {
+    uint8_t res;
+    GSM_CORE_PROTECT();                         /* Protect core */
+    res = cache_valid && cache_resolve_mem(mem) == cache_mem;
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Find entry by phone number in cache without communication with device
+ *
+ *                  Numbers are compared by last \ref GSM_CFG_PB_CACHE_MATCH_DIGITS digits,
+ *                  formatting characters and international prefix are ignored
+ *
+ * \param[in]       num: Phone number to find
+ * \param[out]      entry: Pointer to entry to fill
+ * \return          \ref gsmOK if entry was found, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_pb_cache_find_number(const char* num, gsm_pb_entry_t* entry) {
+    char k[GSM_CFG_PB_CACHE_MATCH_DIGITS + 1];
+    gsmr_t res = gsmERR;
+    size_t i;
+
+    GSM_ASSERT("num != NULL", num != NULL);     /* Assert input parameters */
+    GSM_ASSERT("entry != NULL", entry != NULL); /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    if (cache_valid && cache_num_key(num, k) > 0) {
+        i = cache_num_find(k);
+        if (cache_num[i] != 0) {
+            memcpy(entry, &cache_entries[cache_num[i] - 1], sizeof(*entry));
+            res = gsmOK;
+        }
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Find entries by name prefix in cache without communication with device
+ *
+ *                  Names are compared without case sensitivity
+ *                  and entries are returned in alphabetical order
+ *
+ * \param[in]       name: Name prefix to find. Use empty string to get all entries
+ * \param[out]      entries: Pointer to array to save entries
+ * \param[in]       etr: Number of entries to read
+ * \param[out]      er: Pointer to output variable to save number of entries in array
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_pb_cache_find_name(const char* name, gsm_pb_entry_t* entries, size_t etr, size_t* er) {
+    gsmr_t res = gsmERR;
+    size_t n;
+
+    GSM_ASSERT("name != NULL", name != NULL);   /* Assert input parameters */
+    GSM_ASSERT("entries != NULL", entries != NULL); /* Assert input parameters */
+    GSM_ASSERT("etr > 0", etr > 0);             /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    if (cache_valid) {
+        n = cache_find_name(name, entries, etr);
+        if (er != NULL) {
+            *er = n;
+        }
+        res = gsmOK;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+#endif /* GSM_CFG_PB_CACHE || __DOXYGEN__ */
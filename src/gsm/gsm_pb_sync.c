@@ -0,0 +1,211 @@
+/**
+ * \file            gsm_pb_sync.c
+ * \brief           Phonebook synchronization with target entry set
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_phonebook.h"
+
+#if GSM_CFG_PB_SYNC || __DOXYGEN__
+
+#define BIT_GET(b, i)                   ((b)[(i) >> 3] & (1 << ((i) & 0x07)))
+#define BIT_SET(b, i)                   ((b)[(i) >> 3] |= (1 << ((i) & 0x07)))
+
+static uint8_t sync_matched[(GSM_CFG_PB_SYNC_SIZE + 7) / 8];   /*!< Bit per target entry already stored on device */
+static uint8_t sync_used[(GSM_CFG_PB_SYNC_SIZE + 8) / 8];  /*!< Bit per memory position used on device */
+static uint8_t sync_done[(GSM_CFG_PB_SYNC_SIZE + 8) / 8];  /*!< Bit per memory position holding target entry or already deleted */
+
+/**
+ * \brief           Send progress event to user
+ * \param[in]       msg: Current message
+ * \param[in]       done: Set to `1` when sync is finished
+ */
+static void
+sync_send_evt(gsm_msg_t* msg, uint8_t done) {
+    gsm.cb.cb.pb_sync.mem = gsmi_pb_get_op_mem(msg);
+    gsm.cb.cb.pb_sync.read = msg->msg.pb_sync.read;
+    gsm.cb.cb.pb_sync.kept = msg->msg.pb_sync.kept;
+    gsm.cb.cb.pb_sync.written = msg->msg.pb_sync.written;
+    gsm.cb.cb.pb_sync.writes = msg->msg.pb_sync.writes;
+    gsm.cb.cb.pb_sync.done = done;
+    gsm.cb.cb.pb_sync.res = msg->msg.pb_sync.res;
+    gsmi_send_cb(GSM_CB_PB_SYNC);               /* Send to user */
+}
+
+/**
+ * \brief           Finish sync and report result
+ * \param[in]       msg: Current message
+ * \param[in]       res: Final result
+ * \return          \ref GSM_CMD_IDLE
+ */
+static gsm_cmd_t
+sync_finish(gsm_msg_t* msg, gsmr_t res) {
+    msg->msg.pb_sync.res = res;
+    sync_send_evt(msg, 1);
+    return GSM_CMD_IDLE;
+}
+
+/**
+ * \brief           Find first memory position for write
+ * \param[in]       stale: Set to `1` to find position with entry not in target set or `0` to find free position
+ * \return          Position or `0` if not found
+ */
+static size_t
+sync_find_pos(uint8_t stale) {
+    size_t pos;
+
+    for (pos = 1; pos <= gsm.pb.mem.total; pos++) {
+        if (stale ? (BIT_GET(sync_used, pos) && !BIT_GET(sync_done, pos)) : !BIT_GET(sync_used, pos)) {
+            return pos;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Select next write of diff
+ *
+ *                  Missing target entries overwrite entries not in target set first
+ *                  and use free positions after. Remaining entries not in target set are deleted
+ *
+ * \param[in]       msg: Current message
+ * \return          \ref GSM_CMD_CPBW_SET for next write or \ref GSM_CMD_IDLE when finished
+ */
+static gsm_cmd_t
+sync_write_next(gsm_msg_t* msg) {
+    size_t i, pos;
+
+    for (i = 0; i < msg->msg.pb_sync.len && BIT_GET(sync_matched, i); i++) {}
+    pos = sync_find_pos(1);
+    if (i < msg->msg.pb_sync.len) {             /* Target entry is missing on device */
+        if (pos == 0 && (pos = sync_find_pos(0)) == 0) {
+            return sync_finish(msg, gsmERRMEM);
+        }
+        BIT_SET(sync_matched, i);
+        msg->msg.pb_sync.ti = i;
+        msg->msg.pb_sync.del = 0;
+    } else if (pos != 0) {                      /* Entry is not in target set */
+        msg->msg.pb_sync.del = 1;
+    } else {
+        return sync_finish(msg, gsmOK);
+    }
+    BIT_SET(sync_used, pos);
+    BIT_SET(sync_done, pos);
+    msg->msg.pb_sync.pos = pos;
+    return GSM_CMD_CPBW_SET;
+}
+
+/**
+ * \brief           Start sync, called before first entries are read
+ * \param[in]       msg: Current message
+ */
+void
+gsmi_pb_sync_start(gsm_msg_t* msg) {
+    memset(sync_matched, 0x00, sizeof(sync_matched));
+    memset(sync_used, 0x00, sizeof(sync_used));
+    memset(sync_done, 0x00, sizeof(sync_done));
+    msg->msg.pb_sync.read = 0;
+    msg->msg.pb_sync.kept = 0;
+    msg->msg.pb_sync.written = 0;
+    msg->msg.pb_sync.writes = 0;
+}
+
+/**
+ * \brief           Compare entry read from device with target set
+ * \param[in]       msg: Current message
+ * \param[in]       e: Entry read with `+CPBR`
+ */
+void
+gsmi_pb_sync_read(gsm_msg_t* msg, const gsm_pb_entry_t* e) {
+    const gsm_pb_entry_t* t;
+    size_t i;
+
+    if (e->pos == 0 || e->pos > GSM_CFG_PB_SYNC_SIZE) {
+        return;
+    }
+    msg->msg.pb_sync.read++;
+    BIT_SET(sync_used, e->pos);
+    for (i = 0; i < msg->msg.pb_sync.len; i++) {
+        t = &msg->msg.pb_sync.entries[i];
+        if (!BIT_GET(sync_matched, i) && t->type == e->type
+            && !strcmp(t->number, e->number) && !strcmp(t->name, e->name)) {
+            BIT_SET(sync_matched, i);           /* Entry is kept as is */
+            BIT_SET(sync_done, e->pos);
+            msg->msg.pb_sync.kept++;
+            break;
+        }
+    }
+}
+
+/**
+ * \brief           Process finished command of sync and get next command
+ * \param[in]       msg: Current message
+ * \param[in]       ok: Set to `1` if command finished successfully
+ * \return          Next command or \ref GSM_CMD_IDLE when sync is finished
+ */
+gsm_cmd_t
+gsmi_pb_sync_next(gsm_msg_t* msg, uint8_t ok) {
+    size_t missing, stale;
+
+    if (!ok) {
+        return sync_finish(msg, gsmERR);
+    }
+    if (CMD_IS_CUR(GSM_CMD_CPBR)) {
+        if (gsm.pb.mem.total > GSM_CFG_PB_SYNC_SIZE) {
+            return sync_finish(msg, gsmERRMEM); /* Positions cannot be tracked */
+        }
+        if (gsmi_pb_page_next(&msg->msg.pb_sync.start_index, GSM_CFG_PB_SYNC_CHUNK, msg->msg.pb_sync.read)) {
+            sync_send_evt(msg, 0);
+            return GSM_CMD_CPBR;                /* Read next range */
+        }
+
+        /* Read pass is finished, check diff fits to memory */
+        missing = msg->msg.pb_sync.len - msg->msg.pb_sync.kept;
+        stale = msg->msg.pb_sync.read - msg->msg.pb_sync.kept;
+        if (missing > stale + (gsm.pb.mem.total - msg->msg.pb_sync.read)) {
+            return sync_finish(msg, gsmERRMEM);
+        }
+        msg->msg.pb_sync.writes = missing + (stale > missing ? stale - missing : 0);
+    } else if (CMD_IS_CUR(GSM_CMD_CPBW_SET)) {
+        msg->msg.pb_sync.written++;
+#if GSM_CFG_PB_CACHE
+        if (msg->msg.pb_sync.del) {             /* Keep cache coherent with device */
+            gsmi_pb_cache_update(gsmi_pb_get_op_mem(msg), msg->msg.pb_sync.pos, NULL, NULL, GSM_NUMBER_TYPE_NATIONAL);
+        } else {
+            const gsm_pb_entry_t* t = &msg->msg.pb_sync.entries[msg->msg.pb_sync.ti];
+            gsmi_pb_cache_update(gsmi_pb_get_op_mem(msg), msg->msg.pb_sync.pos, t->name, t->number, t->type);
+        }
+#endif /* GSM_CFG_PB_CACHE */
+    }
+    sync_send_evt(msg, 0);
+    return sync_write_next(msg);
+}
+
+#endif /* GSM_CFG_PB_SYNC || __DOXYGEN__ */
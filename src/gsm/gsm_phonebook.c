@@ -71,6 +71,108 @@ check_mem(gsm_mem_t mem, uint8_t can_curr) {
     return res;
 }
 
+/**
+ * \brief           Get timeout for operation reading whole memory in pages
+ *
+ *                  Memory size of last selected memory is used, but not less than
+ *                  typical SIM phonebook size as memory may not be selected yet
+ *
+ * \param[in]       page: Number of positions read with single command
+ * \param[in]       writes: Maximal number of write commands after read
+ * \return          Timeout in units of milliseconds, `60000` for every command
+ */
+static uint32_t
+get_pages_timeout(size_t page, size_t writes) {
+    size_t size;
+    GSM_CORE_PROTECT();                     /* Protect core */
+    size = GSM_MAX(gsm.pb.mem.total, 250);
+    GSM_CORE_UNPROTECT();                   /* Unprotect core */
+    return 60000 * (uint32_t)(2 + (size + page - 1) / page + writes); /* Memory select, reads and writes */
+}
+
+/**
+ * \brief           Check if phonebook memory for operation is known
+ * \param[in]       msg: Current message
+ * \return          `1` if `CPBS_GET` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_mem_known(gsm_msg_t* msg) {
+    return gsmi_pb_get_op_mem(msg) != GSM_MEM_UNKNOWN;
+}
+
+/**
+ * \brief           Check if phonebook memory for operation is already selected on device
+ * \param[in]       msg: Current message
+ * \return          `1` if `CPBS_SET` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_mem_selected(gsm_msg_t* msg) {
+    gsm_mem_t mem = gsmi_pb_get_op_mem(msg);
+    return mem != GSM_MEM_UNKNOWN && mem == gsm.pb.mem.current;
+}
+
+/**
+ * \brief           Steps to write, edit or delete phonebook entry
+ */
+static const gsm_cmd_step_t
+pb_write_steps[] = {
+    { GSM_CMD_CPBS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPBS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CPBW_SET, NULL },                 /* Write entry to phonebook */
+};
+
+/**
+ * \brief           Steps to list phonebook entries
+ */
+static const gsm_cmd_step_t
+pb_list_steps[] = {
+    { GSM_CMD_CPBS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPBS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CPBR, NULL },                     /* Read entries */
+};
+
+/**
+ * \brief           Steps to list phonebook entries in pages until end of memory
+ */
+static const gsm_cmd_step_t
+pb_paged_steps[] = {
+    { GSM_CMD_CPBS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPBS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CPBS_GET, NULL },                 /* Get number of used and total entries */
+    { GSM_CMD_CPBR, NULL },                     /* Read entries in pages */
+};
+
+/**
+ * \brief           Steps to search phonebook entries
+ */
+static const gsm_cmd_step_t
+pb_search_steps[] = {
+    { GSM_CMD_CPBS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPBS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CPBF, NULL },                     /* Search entries */
+};
+
+#if GSM_CFG_PB_CACHE || __DOXYGEN__
+
+static gsm_pb_entry_t pb_cache_chunk[GSM_CFG_PB_CACHE_CHUNK];   /*!< Entries buffer for single chunk of cache load */
+
+#endif /* GSM_CFG_PB_CACHE || __DOXYGEN__ */
+
+#if GSM_CFG_PB_SYNC || __DOXYGEN__
+
+/**
+ * \brief           Steps to synchronize phonebook, writes follow read of last range
+ */
+static const gsm_cmd_step_t
+pb_sync_steps[] = {
+    { GSM_CMD_CPBS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPBS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CPBS_GET, NULL },                 /* Get number of used and total entries */
+    { GSM_CMD_CPBR, NULL },                     /* Read entries in ranges */
+};
+
+#endif /* GSM_CFG_PB_SYNC || __DOXYGEN__ */
+
 /**
  * \brief           Enable phonebook functionality
  * \param[in]       blocking: Status whether command should be blocking or not
@@ -121,11 +223,8 @@ gsm_pb_add(gsm_mem_t mem, const char* name, const char* num, gsm_number_type_t t
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
     
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPBW_SET;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).steps = pb_write_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(pb_write_steps);
 
     GSM_MSG_VAR_REF(msg).msg.pb_write.pos = 0;
     GSM_MSG_VAR_REF(msg).msg.pb_write.mem = mem;
@@ -158,11 +257,8 @@ gsm_pb_edit(gsm_mem_t mem, size_t pos, const char* name, const char* num, gsm_nu
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
 
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPBW_SET;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).steps = pb_write_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(pb_write_steps);
 
     GSM_MSG_VAR_REF(msg).msg.pb_write.pos = pos;
     GSM_MSG_VAR_REF(msg).msg.pb_write.mem = mem;
@@ -191,11 +287,8 @@ gsm_pb_delete(gsm_mem_t mem, size_t pos, uint32_t blocking) {
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
 
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPBW_SET;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).steps = pb_write_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(pb_write_steps);
 
     GSM_MSG_VAR_REF(msg).msg.pb_write.mem = mem;
     GSM_MSG_VAR_REF(msg).msg.pb_write.pos = pos;
@@ -231,11 +324,8 @@ gsm_pb_list(gsm_mem_t mem, size_t start_index, gsm_pb_entry_t* entries, size_t e
     }
     memset(entries, 0x00, sizeof(*entries) * etr);  /* Reset data structure */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPBR;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).steps = pb_list_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(pb_list_steps);
 
     GSM_MSG_VAR_REF(msg).msg.pb_list.mem = mem;
     GSM_MSG_VAR_REF(msg).msg.pb_list.start_index = start_index;
@@ -246,6 +336,55 @@ gsm_pb_list(gsm_mem_t mem, size_t start_index, gsm_pb_entry_t* entries, size_t e
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+/**
+ * \brief           List all entries from specific memory with callback function for every entry
+ *
+ *                  Memory is read in pages of `page` positions until all used entries are received
+ *                  or last position is reached. Single entry buffer is reused for all entries,
+ *                  so that memory use does not depend on phonebook size
+ *
+ * \note            Callback function is called from processing thread
+ *                  and must not call blocking API functions
+ * \param[in]       mem: Memory to list entries from. Use \ref GSM_MEM_CURRENT to use current memory
+ * \param[in]       page: Number of positions read with single command
+ * \param[in]       entry: Pointer to entry buffer used for every listed entry. Must stay valid until operation finishes
+ * \param[in]       fn: Callback function called for every entry. Return other than \ref gsmOK to stop listing
+ * \param[in]       arg: User argument passed to callback function
+ * \param[out]      er: Pointer to output variable to save number of entries passed to callback function
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_pb_list_stream(gsm_mem_t mem, size_t page, gsm_pb_entry_t* entry, gsm_pb_list_fn fn, void* arg, size_t* er, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("page > 0", page > 0);           /* Assert input parameters */
+    GSM_ASSERT("entry != NULL", entry != NULL); /* Assert input parameters */
+    GSM_ASSERT("fn != NULL", fn != NULL);       /* Assert input parameters */
+    CHECK_ENABLED();                            /* Check if enabled */
+    GSM_ASSERT("mem", check_mem(mem, 1) == gsmOK);  /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+
+    if (er != NULL) {
+        *er = 0;
+    }
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPBR;
+    GSM_MSG_VAR_REF(msg).steps = pb_paged_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(pb_paged_steps);
+
+    GSM_MSG_VAR_REF(msg).msg.pb_list.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.start_index = 1;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.entries = entry;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.etr = 1;   /* Single entry is reused */
+    GSM_MSG_VAR_REF(msg).msg.pb_list.er = er;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.page = page;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.fn = fn;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.fn_arg = arg;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, get_pages_timeout(page, 0));   /* Send message to producer queue */
+}
+
 /**
  * \brief           Search for entires with specific name from specific memory
  * \note            Search works by entry name only. Phone number search is not available
@@ -267,6 +406,12 @@ gsm_pb_search(gsm_mem_t mem, const char* search, gsm_pb_entry_t* entries, size_t
     CHECK_ENABLED();                            /* Check if enabled */
     GSM_ASSERT("mem", check_mem(mem, 1) == gsmOK);  /* Assert input parameters */
 
+#if GSM_CFG_PB_CACHE
+    if (gsmi_pb_cache_search(mem, search, entries, etr, er) == gsmOK) {
+        return gsmOK;                           /* Entries found in local cache */
+    }
+#endif /* GSM_CFG_PB_CACHE */
+
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
 
     if (er != NULL) {
@@ -274,11 +419,8 @@ gsm_pb_search(gsm_mem_t mem, const char* search, gsm_pb_entry_t* entries, size_t
     }
     memset(entries, 0x00, sizeof(*entries) * etr);  /* Reset data structure */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPBF;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPBS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).steps = pb_search_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(pb_search_steps);
 
     GSM_MSG_VAR_REF(msg).msg.pb_search.mem = mem;
     GSM_MSG_VAR_REF(msg).msg.pb_search.search = search;
@@ -289,4 +431,85 @@ gsm_pb_search(gsm_mem_t mem, const char* search, gsm_pb_entry_t* entries, size_t
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+#if GSM_CFG_PB_CACHE || __DOXYGEN__
+
+/**
+ * \brief           Load all entries of phonebook memory to local cache
+ *
+ *                  Entries are read in chunks of \ref GSM_CFG_PB_CACHE_CHUNK entries.
+ *                  When finished, \ref GSM_CB_PB_LIST event is sent with number of cached entries
+ *                  and \ref gsm_pb_search is served from cache
+ *
+ * \param[in]       mem: Memory to load. Use \ref GSM_MEM_CURRENT to load current memory
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_pb_cache_load(gsm_mem_t mem, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    CHECK_ENABLED();                            /* Check if enabled */
+    GSM_ASSERT("mem", check_mem(mem, 1) == gsmOK);  /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPBR;
+    GSM_MSG_VAR_REF(msg).steps = pb_paged_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(pb_paged_steps);
+
+    GSM_MSG_VAR_REF(msg).msg.pb_list.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.start_index = 1;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.entries = pb_cache_chunk;
+    GSM_MSG_VAR_REF(msg).msg.pb_list.etr = GSM_ARRAYSIZE(pb_cache_chunk);
+    GSM_MSG_VAR_REF(msg).msg.pb_list.cache = 1;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, get_pages_timeout(GSM_CFG_PB_CACHE_CHUNK, 0));   /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_PB_CACHE || __DOXYGEN__ */
+
+#if GSM_CFG_PB_SYNC || __DOXYGEN__
+
+/**
+ * \brief           Synchronize phonebook memory with target set of entries
+ *
+ *                  Memory is selected once and read in ranges of \ref GSM_CFG_PB_SYNC_CHUNK positions.
+ *                  Entries equal to target entry by name, number and type are kept.
+ *                  Missing target entries overwrite other entries first and use free positions after,
+ *                  remaining other entries are deleted. Unchanged memory needs no write.
+ *
+ *                  Progress is reported with \ref GSM_CB_PB_SYNC event
+ *
+ * \param[in]       mem: Memory to synchronize. Use \ref GSM_MEM_CURRENT to use current memory
+ * \param[in]       entries: Target entries, `mem` and `pos` fields are ignored. Array must be valid until sync is finished
+ * \param[in]       len: Number of target entries
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_pb_sync(gsm_mem_t mem, const gsm_pb_entry_t* entries, size_t len, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("entries != NULL || len == 0", entries != NULL || len == 0); /* Assert input parameters */
+    GSM_ASSERT("len <= GSM_CFG_PB_SYNC_SIZE", len <= GSM_CFG_PB_SYNC_SIZE);   /* Assert input parameters */
+    CHECK_ENABLED();                            /* Check if enabled */
+    GSM_ASSERT("mem", check_mem(mem, 1) == gsmOK);  /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_PHONEBOOK_SYNC;
+    GSM_MSG_VAR_REF(msg).steps = pb_sync_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(pb_sync_steps);
+
+    GSM_MSG_VAR_REF(msg).msg.pb_sync.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.pb_sync.entries = entries;
+    GSM_MSG_VAR_REF(msg).msg.pb_sync.len = len;
+    GSM_MSG_VAR_REF(msg).msg.pb_sync.start_index = 1;
+
+    /* Every position is written or deleted at most once, sync fails for larger memory */
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, get_pages_timeout(GSM_CFG_PB_SYNC_CHUNK, GSM_CFG_PB_SYNC_SIZE));   /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_PB_SYNC || __DOXYGEN__ */
+
 #endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
@@ -130,7 +130,7 @@ gsm_sim_enter_puk(const char* puk, const char* pin, uint32_t blocking) {
     GSM_ASSERT("pin != NULL", pin != NULL);     /* Assert input parameters */
 
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
-    GSM_MSG_VAR_REF(msg).cmd_def = GMM_CMD_CPUK_SET;
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPUK_SET;
     GSM_MSG_VAR_REF(msg).msg.cpuk_enter.puk = puk;
     GSM_MSG_VAR_REF(msg).msg.cpuk_enter.pin = pin;
 
@@ -33,6 +33,7 @@
 #include "gsm/gsm_private.h"
 #include "gsm/gsm_sms.h"
 #include "gsm/gsm_mem.h"
+#include "gsm/gsm_timeout.h"
 
 #if GSM_CFG_SMS || __DOXYGEN__
 
@@ -88,6 +89,204 @@ check_sms_mem(gsm_mem_t mem, uint8_t can_curr) {
     return res;
 }
 
+/**
+ * \brief           Check if text fits to single message
+ * \param[in]       text: Text to check
+ * \return          `1` if text fits, `0` otherwise
+ */
+static uint8_t
+is_text_single(const char* text) {
+#if GSM_CFG_SMS_PDU
+    size_t len = strlen(text);
+    gsm_sms_coding_t coding = gsm_sms_pdu_get_coding(text, len);
+    return gsm_sms_pdu_get_text_len(text, len, coding) <= (coding == GSM_SMS_CODING_UCS2 ? 70 : 160);
+#else /* GSM_CFG_SMS_PDU */
+    return strlen(text) <= 160;
+#endif /* !GSM_CFG_SMS_PDU */
+}
+
+/**
+ * \brief           Check if SMS memory for operation is known
+ * \param[in]       msg: Current message
+ * \return          `1` if `CPMS_GET` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_mem_known(gsm_msg_t* msg) {
+    return gsmi_sms_get_op_mem(msg) != GSM_MEM_UNKNOWN;
+}
+
+/**
+ * \brief           Check if SMS memory for operation is already selected on device
+ * \param[in]       msg: Current message
+ * \return          `1` if `CPMS_SET` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_mem_selected(gsm_msg_t* msg) {
+    gsm_mem_t mem = gsmi_sms_get_op_mem(msg);
+    return mem != GSM_MEM_UNKNOWN && mem == gsm.sms.mem[GSM_SMS_OPERATION_IDX].current;
+}
+
+/**
+ * \brief           Check if SMS message format for operation is already set on device
+ * \param[in]       msg: Current message
+ * \return          `1` if `CMGF` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_format_set(gsm_msg_t* msg) {
+    return gsm.sms.format == gsmi_sms_get_op_format(msg);
+}
+
+/**
+ * \brief           Check if all memories needed for preferred storage are known
+ * \param[in]       msg: Current message
+ * \return          `1` if `CPMS_GET` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_pref_mem_known(gsm_msg_t* msg) {
+    size_t i;
+    for (i = 0; i < GSM_ARRAYSIZE(msg->msg.sms_memory.mem); i++) {
+        if (msg->msg.sms_memory.mem[i] == GSM_MEM_CURRENT && gsm.sms.mem[i].current == GSM_MEM_UNKNOWN) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Steps to send SMS
+ */
+static const gsm_cmd_step_t
+sms_send_steps[] = {
+    { GSM_CMD_CMGF, is_format_set },            /* Set message format */
+    { GSM_CMD_CMGS, NULL },                     /* Send actual message */
+};
+
+/**
+ * \brief           Check if batch has single message only
+ * \param[in]       msg: Current message
+ * \return          `1` if `CMMS_SET` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_single_batch_entry(gsm_msg_t* msg) {
+    return msg->msg.sms_send.batch_len <= 1;
+}
+
+/**
+ * \brief           Steps to send batch of SMS
+ */
+static const gsm_cmd_step_t
+sms_send_batch_steps[] = {
+    { GSM_CMD_CMGF, is_format_set },            /* Set message format */
+    { GSM_CMD_CMMS_SET, is_single_batch_entry },/* Keep link open between messages */
+    { GSM_CMD_CMGS, NULL },                     /* Send messages */
+};
+
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+/**
+ * \brief           Check if message is sent as single part
+ * \param[in]       msg: Current message
+ * \return          `1` if `CMMS_SET` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_single_part(gsm_msg_t* msg) {
+    return msg->msg.sms_send.parts <= 1;
+}
+
+/**
+ * \brief           Steps to send concatenated SMS
+ */
+static const gsm_cmd_step_t
+sms_send_long_steps[] = {
+    { GSM_CMD_CMGF, is_format_set },            /* Set message format */
+    { GSM_CMD_CMMS_SET, is_single_part },       /* Keep link open between parts */
+    { GSM_CMD_CMGS, NULL },                     /* Send parts */
+};
+
+static uint8_t sms_concat_ref;                  /*!< Reference number of last concatenated message */
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
+
+/**
+ * \brief           Steps to read SMS
+ */
+static const gsm_cmd_step_t
+sms_read_steps[] = {
+    { GSM_CMD_CPMS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPMS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CMGF, is_format_set },            /* Set message format */
+    { GSM_CMD_CMGR, NULL },                     /* Read message */
+};
+
+/**
+ * \brief           Steps to delete SMS
+ */
+static const gsm_cmd_step_t
+sms_delete_steps[] = {
+    { GSM_CMD_CPMS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPMS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CMGD, NULL },                     /* Delete message */
+};
+
+/**
+ * \brief           Steps to delete group of SMS with delete flag
+ */
+static const gsm_cmd_step_t
+sms_delete_all_steps[] = {
+    { GSM_CMD_CPMS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPMS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CMGD, NULL },                     /* Delete messages */
+    { GSM_CMD_CPMS_GET, NULL },                 /* Update memory usage */
+};
+
+/**
+ * \brief           Steps to delete group of SMS with device specific command
+ */
+static const gsm_cmd_step_t
+sms_delete_cmgda_steps[] = {
+    { GSM_CMD_CPMS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPMS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CMGF, is_format_set },            /* Set message format, type is encoded accordingly */
+    { GSM_CMD_CMGDA, NULL },                    /* Delete messages */
+    { GSM_CMD_CPMS_GET, NULL },                 /* Update memory usage */
+};
+
+/**
+ * \brief           Steps to list SMS
+ */
+static const gsm_cmd_step_t
+sms_list_steps[] = {
+    { GSM_CMD_CPMS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPMS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CMGF, is_format_set },            /* Set message format */
+    { GSM_CMD_CMGL, NULL },                     /* List messages */
+};
+
+#if GSM_CFG_SMS_DRAIN || __DOXYGEN__
+
+/**
+ * \brief           Steps to list unread SMS in drain mode
+ */
+static const gsm_cmd_step_t
+sms_drain_steps[] = {
+    { GSM_CMD_CPMS_GET, is_mem_known },         /* Get current memory */
+    { GSM_CMD_CPMS_SET, is_mem_selected },      /* Set memory for operation */
+    { GSM_CMD_CMGF, is_format_set },            /* Set message format */
+    { GSM_CMD_CPMS_GET, NULL },                 /* Update memory usage */
+    { GSM_CMD_CMGL, NULL },                     /* List messages */
+};
+
+#endif /* GSM_CFG_SMS_DRAIN || __DOXYGEN__ */
+
+/**
+ * \brief           Steps to set preferred storage
+ */
+static const gsm_cmd_step_t
+sms_memory_steps[] = {
+    { GSM_CMD_CPMS_GET, is_pref_mem_known },    /* Get current memories */
+    { GSM_CMD_CPMS_SET, NULL },                 /* Set memories */
+};
+
 /**
  * \brief           Enable SMS functionality
  * \param[in]       blocking: Status whether command should be blocking or not
@@ -118,33 +317,283 @@ gsm_sms_disable(uint32_t blocking) {
 }
 
 /**
- * \brief           Send SMS text to phone number
+ * \brief           Send single SMS text with tag
  * \param[in]       num: String number
- * \param[in]       text: Text to send. Maximal `160` characters
+ * \param[in]       text: Text to send
+ * \param[in]       tag: Tag reported with status report or `0` if not used
  * \param[in]       blocking: Status whether command should be blocking or not
  * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
  */
-gsmr_t
-gsm_sms_send(const char* num, const char* text, uint32_t blocking) {
+static gsmr_t
+sms_send_single(const char* num, const char* text, uint32_t tag, uint32_t blocking) {
     GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+#if GSM_CFG_SMS_PDU
+    gsm_sms_coding_t coding;
+#endif /* GSM_CFG_SMS_PDU */
 
     GSM_ASSERT("num != NULL", num != NULL);     /* Assert input parameters */
+#if GSM_CFG_SMS_PDU
+    GSM_ASSERT("text != NULL", text != NULL);   /* Assert input parameters */
+    coding = gsm_sms_pdu_get_coding(text, strlen(text));
+    GSM_ASSERT("text fits single message",
+        gsm_sms_pdu_get_text_len(text, strlen(text), coding) <= (coding == GSM_SMS_CODING_UCS2 ? 70 : 160));
+#else /* GSM_CFG_SMS_PDU */
     GSM_ASSERT("text != NULL && strlen(text) <= 160", 
         num != NULL && strlen(text) <= 160);    /* Assert input parameters */
+#endif /* !GSM_CFG_SMS_PDU */
     CHECK_ENABLED();                            /* Check if enabled */
 
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGS;
-    GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CMGF;
+    GSM_MSG_VAR_REF(msg).steps = sms_send_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_send_steps);
     GSM_MSG_VAR_REF(msg).msg.sms_send.num = num;
     GSM_MSG_VAR_REF(msg).msg.sms_send.text = text;
+#if GSM_CFG_SMS_REPORT
+    GSM_MSG_VAR_REF(msg).msg.sms_send.tag = tag;
+#else /* GSM_CFG_SMS_REPORT */
+    GSM_UNUSED(tag);
+#endif /* !GSM_CFG_SMS_REPORT */
+#if GSM_CFG_SMS_PDU
+    GSM_MSG_VAR_REF(msg).msg.sms_send.format = 0;   /* Send in PDU mode */
+    GSM_MSG_VAR_REF(msg).msg.sms_send.len = strlen(text);
+    GSM_MSG_VAR_REF(msg).msg.sms_send.coding = coding;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.parts = 1;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.part_len = strlen(text);
+#else /* GSM_CFG_SMS_PDU */
     GSM_MSG_VAR_REF(msg).msg.sms_send.format = 1;   /* Send as plain text */
+#endif /* !GSM_CFG_SMS_PDU */
 
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+/**
+ * \brief           Send SMS text to phone number
+ *
+ *                  When \ref GSM_CFG_SMS_PDU is enabled, text is UTF-8 encoded and sent
+ *                  with GSM 7-bit alphabet if possible or as UCS2 otherwise
+ *
+ * \param[in]       num: String number
+ * \param[in]       text: Text to send. Maximal `160` characters or `70` characters in UCS2 coding
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_send(const char* num, const char* text, uint32_t blocking) {
+    return sms_send_single(num, text, 0, blocking);
+}
+
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+
+/**
+ * \brief           Send SMS text to phone number with tag for status report
+ *
+ *                  When status reports are enabled with \ref gsm_sms_set_report,
+ *                  tag is reported with \ref GSM_CB_SMS_REPORT event once message is delivered or failed
+ *
+ * \param[in]       num: String number
+ * \param[in]       text: Text to send. Maximal `160` characters or `70` characters in UCS2 coding
+ * \param[in]       tag: User tag to identify message in status report
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_send_tagged(const char* num, const char* text, uint32_t tag, uint32_t blocking) {
+    return sms_send_single(num, text, tag, blocking);
+}
+
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+/**
+ * \brief           Send binary data as 8-bit SMS to phone number
+ * \note            Available only when \ref GSM_CFG_SMS_PDU is enabled
+ * \param[in]       num: String number
+ * \param[in]       data: Data to send
+ * \param[in]       len: Length of data in units of bytes. Maximal `140` bytes
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_send_data(const char* num, const void* data, size_t len, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("num != NULL", num != NULL);     /* Assert input parameters */
+    GSM_ASSERT("data != NULL", data != NULL);   /* Assert input parameters */
+    GSM_ASSERT("len <= 140", len > 0 && len <= GSM_SMS_PDU_UD_MAX_LEN); /* Assert input parameters */
+    CHECK_ENABLED();                            /* Check if enabled */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGS;
+    GSM_MSG_VAR_REF(msg).steps = sms_send_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_send_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_send.num = num;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.text = data;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.format = 0;   /* Send in PDU mode */
+    GSM_MSG_VAR_REF(msg).msg.sms_send.len = len;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.coding = GSM_SMS_CODING_8BIT;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.parts = 1;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.part_len = len;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+/**
+ * \brief           Send long SMS text with tag
+ * \param[in]       num: String number
+ * \param[in]       text: UTF-8 encoded text to send
+ * \param[in]       tag: Tag reported with status report of every part or `0` if not used
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+static gsmr_t
+sms_send_long(const char* num, const char* text, uint32_t tag, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    gsm_sms_coding_t coding;
+    size_t len, max_units, parts, pos;
+
+    GSM_ASSERT("num != NULL", num != NULL);     /* Assert input parameters */
+    GSM_ASSERT("text != NULL", text != NULL);   /* Assert input parameters */
+    CHECK_ENABLED();                            /* Check if enabled */
+
+    len = strlen(text);
+    coding = gsm_sms_pdu_get_coding(text, len);
+    max_units = coding == GSM_SMS_CODING_UCS2 ? 70 : 160;
+    parts = 1;                                  /* Try with single message first */
+    if (gsm_sms_pdu_get_text_len(text, len, coding) > max_units) {
+        max_units = coding == GSM_SMS_CODING_UCS2 ? GSM_SMS_PDU_CONCAT_UCS2_LEN : GSM_SMS_PDU_CONCAT_7BIT_LEN;
+        for (parts = 0, pos = 0; pos < len; parts++) {
+            pos += gsm_sms_pdu_get_text_fit(&text[pos], len - pos, coding, max_units);
+        }
+    }
+    GSM_ASSERT("parts <= 255", parts > 0 && parts <= 255);  /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGS;
+    GSM_MSG_VAR_REF(msg).steps = sms_send_long_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_send_long_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_send.num = num;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.text = text;
+#if GSM_CFG_SMS_REPORT
+    GSM_MSG_VAR_REF(msg).msg.sms_send.tag = tag;    /* Every part is reported with the same tag */
+#else /* GSM_CFG_SMS_REPORT */
+    GSM_UNUSED(tag);
+#endif /* !GSM_CFG_SMS_REPORT */
+    GSM_MSG_VAR_REF(msg).msg.sms_send.format = 0;   /* Send in PDU mode */
+    GSM_MSG_VAR_REF(msg).msg.sms_send.len = len;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.coding = coding;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.parts = (uint8_t)parts;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.is_long = 1;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.cmms = parts > 1;   /* Keep link open until last part is sent */
+    GSM_MSG_VAR_REF(msg).msg.sms_send.part_len = gsm_sms_pdu_get_text_fit(text, len, coding, max_units);
+    GSM_CORE_PROTECT();
+    GSM_MSG_VAR_REF(msg).msg.sms_send.ref = ++sms_concat_ref;   /* Unique reference for parts */
+    GSM_CORE_UNPROTECT();
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000 * (uint32_t)parts);  /* Send message to producer queue */
+}
+
+/**
+ * \brief           Send long SMS text to phone number
+ *
+ *                  Text is split to concatenated parts of `153` characters in GSM 7-bit alphabet
+ *                  or `67` characters in UCS2 coding, which are sent back to back
+ *                  with radio link kept open between parts.
+ *                  Text which fits single message is sent as normal SMS.
+ *
+ *                  \ref GSM_CB_SMS_SENT event is sent for every part
+ *                  and \ref GSM_CB_SMS_SEND_LONG event when operation finishes,
+ *                  also when text is sent as single message.
+ *                  Failed link control (`AT+CMMS`) is not treated as error
+ *
+ * \note            Available only when \ref GSM_CFG_SMS_PDU is enabled
+ * \param[in]       num: String number
+ * \param[in]       text: UTF-8 encoded text to send. Must stay valid until operation finishes
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_send_long(const char* num, const char* text, uint32_t blocking) {
+    return sms_send_long(num, text, 0, blocking);
+}
+
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+
+/**
+ * \brief           Send long SMS text to phone number with tag for status report
+ *
+ *                  Message is sent as with \ref gsm_sms_send_long. When status reports are enabled
+ *                  with \ref gsm_sms_set_report, \ref GSM_CB_SMS_REPORT event with tag is sent for every part
+ *
+ * \note            Available only when \ref GSM_CFG_SMS_PDU is enabled
+ * \param[in]       num: String number
+ * \param[in]       text: UTF-8 encoded text to send. Must stay valid until operation finishes
+ * \param[in]       tag: User tag to identify message in status reports
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_send_long_tagged(const char* num, const char* text, uint32_t tag, uint32_t blocking) {
+    return sms_send_long(num, text, tag, blocking);
+}
+
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
+
+/**
+ * \brief           Send batch of SMS messages
+ *
+ *                  Message format is set once and link to network is kept open
+ *                  while messages are sent back to back.
+ *                  Failed message does not stop the batch, result of every message
+ *                  is written to its `res` field and \ref GSM_CB_SMS_SENT
+ *                  or \ref GSM_CB_SMS_SEND_ERROR event is sent for every message.
+ *                  This applies to batch with single message too,
+ *                  function does not return error of individual message.
+ *                  Message which cannot be encoded is skipped with \ref gsmPARERR result
+ *
+ * \param[in,out]   entries: Array of messages to send. Must stay valid until operation finishes
+ * \param[in]       count: Number of messages in array
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK when batch was processed, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_send_batch(gsm_sms_batch_entry_t* entries, size_t count, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    size_t i;
+
+    GSM_ASSERT("entries != NULL", entries != NULL); /* Assert input parameters */
+    GSM_ASSERT("count > 0", count > 0);         /* Assert input parameters */
+    for (i = 0; i < count; i++) {
+        GSM_ASSERT("num != NULL", entries[i].num != NULL);  /* Assert input parameters */
+        GSM_ASSERT("text != NULL", entries[i].text != NULL);/* Assert input parameters */
+        GSM_ASSERT("text fits single message", is_text_single(entries[i].text));   /* Assert input parameters */
+        entries[i].res = gsmERR;                /* Not sent yet */
+        entries[i].mr = 0;
+    }
+    CHECK_ENABLED();                            /* Check if enabled */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGS;
+    GSM_MSG_VAR_REF(msg).steps = sms_send_batch_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_send_batch_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_send.batch = entries;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.batch_len = count;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.format = !GSM_CFG_SMS_PDU;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.cmms = 2; /* Keep link open until disabled */
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000 * (uint32_t)count);  /* Send message to producer queue */
+}
+
 /**
  * \brief           Read SMS entry at specific memory and position
+ *
+ * \note            When \ref GSM_CFG_SMS_MIRROR is enabled and entry is answered from mirror,
+ *                  \ref GSM_CB_SMS_READ event is sent from calling thread before function returns,
+ *                  not from processing thread
+ *
  * \param[in]       mem: Memory used to read message from
  * \param[in]       pos: Position number in memory to read
  * \param[out]      entry: Pointer to SMS entry structure to fill data to
@@ -160,6 +609,12 @@ gsm_sms_read(gsm_mem_t mem, size_t pos, gsm_sms_entry_t* entry, uint8_t update,
     CHECK_ENABLED();                            /* Check if enabled */
     GSM_ASSERT("mem", check_sms_mem(mem, 1) == gsmOK);  /* Assert input parameters */
 
+#if GSM_CFG_SMS_MIRROR
+    if (gsmi_sms_mirror_read(mem, pos, entry, update) == gsmOK) {
+        return gsmOK;                           /* Entry read from local mirror */
+    }
+#endif /* GSM_CFG_SMS_MIRROR */
+
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
 
     memset(entry, 0x00, sizeof(*entry));        /* Reset data structure */
@@ -167,16 +622,13 @@ gsm_sms_read(gsm_mem_t mem, size_t pos, gsm_sms_entry_t* entry, uint8_t update,
     entry->mem = mem;                           /* Set memory */
     entry->pos = pos;                           /* Set device position */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGR;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).steps = sms_read_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_read_steps);
     GSM_MSG_VAR_REF(msg).msg.sms_read.mem = mem;
     GSM_MSG_VAR_REF(msg).msg.sms_read.pos = pos;
     GSM_MSG_VAR_REF(msg).msg.sms_read.entry = entry;
     GSM_MSG_VAR_REF(msg).msg.sms_read.update = update;
-    GSM_MSG_VAR_REF(msg).msg.sms_read.format = 1;   /* Send as plain text */
+    GSM_MSG_VAR_REF(msg).msg.sms_read.format = !GSM_CFG_SMS_PDU;   /* Read in PDU mode if enabled or as plain text */
 
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
@@ -197,19 +649,68 @@ gsm_sms_delete(gsm_mem_t mem, size_t pos, uint32_t blocking) {
 
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGD;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_GET;    /* First get memory */
+    GSM_MSG_VAR_REF(msg).steps = sms_delete_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_delete_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.pos = pos;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+/**
+ * \brief           Delete all SMS entries with specific status from memory
+ *
+ *                  Messages are deleted with single command. `AT+CMGDA` is used when supported
+ *                  by device driver, otherwise `AT+CMGD` with delete flag, which supports
+ *                  \ref GSM_SMS_STATUS_READ and \ref GSM_SMS_STATUS_ALL only.
+ *                  Memory usage is updated when operation finishes
+ *
+ * \param[in]       mem: Memory to delete messages from. Use \ref GSM_MEM_CURRENT to use current memory
+ * \param[in]       status: Status of messages to delete or \ref GSM_SMS_STATUS_ALL to delete all messages
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_delete_all(gsm_mem_t mem, gsm_sms_status_t status, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    uint8_t cmgda;
+
+    CHECK_ENABLED();                            /* Check if enabled */
+    GSM_ASSERT("mem", check_sms_mem(mem, 1) == gsmOK);  /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    cmgda = gsm.driver != NULL && (gsm.driver->features & GSM_DEVICE_FEATURE_SMS_CMGDA);
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    if (!cmgda && status != GSM_SMS_STATUS_READ && status != GSM_SMS_STATUS_ALL) {
+        return gsmPARERR;                       /* Status cannot be expressed with delete flag */
+    }
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    if (cmgda) {
+        GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGDA;
+        GSM_MSG_VAR_REF(msg).steps = sms_delete_cmgda_steps;
+        GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_delete_cmgda_steps);
     } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_SET;    /* First set memory */
+        GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGD;
+        GSM_MSG_VAR_REF(msg).steps = sms_delete_all_steps;
+        GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_delete_all_steps);
     }
     GSM_MSG_VAR_REF(msg).msg.sms_delete.mem = mem;
-    GSM_MSG_VAR_REF(msg).msg.sms_delete.pos = pos;
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.pos = 1;    /* Position is ignored with delete flag */
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.delflag = status == GSM_SMS_STATUS_ALL ? 4 : 1;
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.status = status;
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.format = !GSM_CFG_SMS_PDU;
 
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
 /**
  * \brief           List SMS from SMS memory
+ *
+ * \note            When \ref GSM_CFG_SMS_MIRROR is enabled and entries are answered from mirror,
+ *                  \ref GSM_CB_SMS_LIST event is sent from calling thread before function returns,
+ *                  not from processing thread
+ *
  * \param[in]       mem: Memory to read entries from. Use \ref GSM_MEM_CURRENT to read from current memory
  * \param[in]       stat: SMS status to read, either `read`, `unread`, `sent`, `unsent` or `all`
  * \param[out]      entries: Pointer to array to save SMS entries
@@ -228,6 +729,12 @@ gsm_sms_list(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entries, siz
     CHECK_ENABLED();                            /* Check if enabled */
     GSM_ASSERT("mem", check_sms_mem(mem, 1) == gsmOK);  /* Assert input parameters */
 
+#if GSM_CFG_SMS_MIRROR
+    if (gsmi_sms_mirror_list(mem, stat, entries, etr, er, update) == gsmOK) {
+        return gsmOK;                           /* Entries listed from local mirror */
+    }
+#endif /* GSM_CFG_SMS_MIRROR */
+
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
 
     if (er != NULL) {
@@ -235,22 +742,120 @@ gsm_sms_list(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entries, siz
     }
     memset(entries, 0x00, sizeof(*entries) * etr);  /* Reset data structure */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGL;
-    if (mem == GSM_MEM_CURRENT) {               /* Should be always false */
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_GET;    /* First get memory */
-    } else {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_SET;    /* First set memory */
-    }
+    GSM_MSG_VAR_REF(msg).steps = sms_list_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_list_steps);
     GSM_MSG_VAR_REF(msg).msg.sms_list.mem = mem;
     GSM_MSG_VAR_REF(msg).msg.sms_list.status = stat;
     GSM_MSG_VAR_REF(msg).msg.sms_list.entries = entries;
     GSM_MSG_VAR_REF(msg).msg.sms_list.etr = etr;
     GSM_MSG_VAR_REF(msg).msg.sms_list.er = er;
     GSM_MSG_VAR_REF(msg).msg.sms_list.update = update;
-    GSM_MSG_VAR_REF(msg).msg.sms_list.format = 1;   /* Send as plain text */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.format = !GSM_CFG_SMS_PDU;   /* Read in PDU mode if enabled or as plain text */
 
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+/**
+ * \brief           List SMS from SMS memory with callback function for every entry
+ *
+ *                  Single entry buffer is reused for all entries, so that memory use
+ *                  does not depend on number of messages in memory
+ *
+ * \note            Callback function is called from processing thread
+ *                  and must not call blocking API functions
+ * \param[in]       mem: Memory to read entries from. Use \ref GSM_MEM_CURRENT to read from current memory
+ * \param[in]       stat: SMS status to read, either `read`, `unread`, `sent`, `unsent` or `all`
+ * \param[in]       entry: Pointer to entry buffer used for every listed entry. Must stay valid until operation finishes
+ * \param[in]       fn: Callback function called for every entry. Return other than \ref gsmOK to stop listing
+ * \param[in]       arg: User argument passed to callback function
+ * \param[out]      er: Pointer to output variable to save number of entries passed to callback function
+ * \param[in]       update: Flag indicates update. Set to `1` to change `UNREAD` messages to `READ` or `0` to leave as is
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_list_stream(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entry, gsm_sms_list_fn fn, void* arg, size_t* er, uint8_t update, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    GSM_ASSERT("entry != NULL", entry != NULL); /* Assert input parameters */
+    GSM_ASSERT("fn != NULL", fn != NULL);       /* Assert input parameters */
+    CHECK_ENABLED();                            /* Check if enabled */
+    GSM_ASSERT("mem", check_sms_mem(mem, 1) == gsmOK);  /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+
+    if (er != NULL) {
+        *er = 0;
+    }
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGL;
+    GSM_MSG_VAR_REF(msg).steps = sms_list_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_list_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_list.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.status = stat;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.entries = entry;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.etr = 1;  /* Single entry is reused */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.er = er;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.update = update;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.format = !GSM_CFG_SMS_PDU;   /* Read in PDU mode if enabled or as plain text */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.fn = fn;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.fn_arg = arg;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+#if GSM_CFG_SMS_MIRROR || __DOXYGEN__
+
+static gsm_sms_entry_t sms_mirror_entry;        /*!< Entry buffer used during mirror synchronization */
+
+/**
+ * \brief           Callback for listed entries during mirror synchronization
+ * \param[in]       entry: Listed entry, already stored to mirror
+ * \param[in]       arg: Unused argument
+ * \return          \ref gsmOK to continue listing
+ */
+static gsmr_t
+sms_mirror_list_fn(const gsm_sms_entry_t* entry, void* arg) {
+    GSM_UNUSED(entry);
+    GSM_UNUSED(arg);
+    return gsmOK;
+}
+
+/**
+ * \brief           Synchronize local mirror with all messages in SMS memory
+ *
+ *                  All messages are listed from device without changing their status.
+ *                  When finished successfully, \ref gsm_sms_read and \ref gsm_sms_list
+ *                  are served from mirror where possible
+ *
+ * \param[in]       mem: Memory to synchronize. Use \ref GSM_MEM_CURRENT to synchronize current memory
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_mirror_sync(gsm_mem_t mem, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    CHECK_ENABLED();                            /* Check if enabled */
+    GSM_ASSERT("mem", check_sms_mem(mem, 1) == gsmOK);  /* Assert input parameters */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGL;
+    GSM_MSG_VAR_REF(msg).steps = sms_list_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_list_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_list.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.status = GSM_SMS_STATUS_ALL;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.entries = &sms_mirror_entry;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.etr = 1;  /* Single entry is reused */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.update = 0;   /* Do not change status of messages */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.format = !GSM_CFG_SMS_PDU;   /* Read in PDU mode if enabled or as plain text */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.fn = sms_mirror_list_fn;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.mirror = 1;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_SMS_MIRROR || __DOXYGEN__ */
+
 /**
  * \brief           Set preferred storage for SMS
  * \param[in]       mem1: Preferred memory for read/delete SMS operations. Use \ref GSM_MEM_CURRENT to keep it as is
@@ -270,11 +875,8 @@ gsm_sms_set_preferred_storage(gsm_mem_t mem1, gsm_mem_t mem2, gsm_mem_t mem3, ui
 
     GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
     GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CPMS_SET;
-
-    /* In case any of memories is set to current, read current status first from device */
-    if (mem1 == GSM_MEM_CURRENT || mem2 == GSM_MEM_CURRENT || mem3 == GSM_MEM_CURRENT) {
-        GSM_MSG_VAR_REF(msg).cmd = GSM_CMD_CPMS_GET;
-    }
+    GSM_MSG_VAR_REF(msg).steps = sms_memory_steps;  /* Current memories are read first if not known */
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_memory_steps);
     GSM_MSG_VAR_REF(msg).msg.sms_memory.mem[0] = mem1;
     GSM_MSG_VAR_REF(msg).msg.sms_memory.mem[1] = mem2;
     GSM_MSG_VAR_REF(msg).msg.sms_memory.mem[2] = mem3;
@@ -282,4 +884,611 @@ gsm_sms_set_preferred_storage(gsm_mem_t mem1, gsm_mem_t mem2, gsm_mem_t mem3, ui
     return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
 }
 
+#if GSM_CFG_SMS_DIRECT || __DOXYGEN__
+
+/**
+ * \brief           Check if message service for acknowledgement is not needed
+ * \param[in]       msg: Current message
+ * \return          `1` if `CSMS_SET_1` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_ack_not_used(gsm_msg_t* msg) {
+    return !GSM_CFG_SMS_DIRECT_ACK || msg->msg.sms_cnmi.mt != 2;
+}
+
+/**
+ * \brief           Steps to set new message indications
+ */
+static const gsm_cmd_step_t
+sms_direct_steps[] = {
+    { GSM_CMD_CSMS_SET_1, is_ack_not_used },    /* Enable acknowledgement of new messages */
+    { GSM_CMD_CMGF, is_format_set },            /* Set format of delivered messages */
+    { GSM_CMD_CNMI, NULL },                     /* Set indications */
+};
+
+/**
+ * \brief           Enable or disable direct delivery of received SMS
+ *
+ *                  When enabled, received messages are not stored to device memory.
+ *                  Message is reported with \ref GSM_CB_SMS_RECV_DIRECT event instead of
+ *                  \ref GSM_CB_SMS_RECV event and there is no need to read and delete it.
+ *                  When disabled, received messages are stored and reported with \ref GSM_CB_SMS_RECV event
+ *
+ * \note            Device restores indications on reset, call function again after reset
+ * \param[in]       enable: Set to `1` to deliver messages directly or `0` to store them to memory
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_set_direct(uint8_t enable, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    CHECK_ENABLED();                            /* Check if enabled */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CNMI;
+    GSM_MSG_VAR_REF(msg).steps = sms_direct_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_direct_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_cnmi.mt = enable ? 2 : 1;
+#if GSM_CFG_SMS_REPORT
+    GSM_MSG_VAR_REF(msg).msg.sms_cnmi.ds = gsm.sms.report;  /* Keep status reports setting */
+#endif /* GSM_CFG_SMS_REPORT */
+    GSM_MSG_VAR_REF(msg).msg.sms_cnmi.format = !GSM_CFG_SMS_PDU;   /* Receive in PDU mode if enabled or as plain text */
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_SMS_DIRECT || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+
+/**
+ * \brief           Check if status report request is part of PDU
+ * \param[in]       msg: Current message
+ * \return          `1` if `CSMP` step can be skipped, `0` otherwise
+ */
+static uint8_t
+is_report_in_pdu(gsm_msg_t* msg) {
+    GSM_UNUSED(msg);
+    return GSM_CFG_SMS_PDU;
+}
+
+/**
+ * \brief           Steps to set status reports
+ */
+static const gsm_cmd_step_t
+sms_report_steps[] = {
+    { GSM_CMD_CSMP_GET, is_report_in_pdu },     /* Get text mode parameters */
+    { GSM_CMD_CSMP, is_report_in_pdu },         /* Request status report in text mode */
+    { GSM_CMD_CMGF, is_format_set },            /* Set format of status reports */
+    { GSM_CMD_CNMI, NULL },                     /* Set indications */
+};
+
+/**
+ * \brief           Enable or disable delivery status reports of sent messages
+ *
+ *                  When enabled, network reports delivery of every sent message.
+ *                  Result is reported with \ref GSM_CB_SMS_REPORT event, together with tag
+ *                  of message sent with \ref gsm_sms_send_tagged or \ref gsm_sms_send_long_tagged.
+ *                  In text mode, only status report request of current text mode parameters is changed
+ *
+ * \note            Device restores settings on reset, call function again after reset
+ * \param[in]       enable: Set to `1` to request status reports or `0` to disable them
+ * \param[in]       blocking: Status whether command should be blocking or not
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_set_report(uint8_t enable, uint32_t blocking) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    CHECK_ENABLED();                            /* Check if enabled */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CNMI;
+    GSM_MSG_VAR_REF(msg).steps = sms_report_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_report_steps);
+#if GSM_CFG_SMS_DIRECT
+    GSM_MSG_VAR_REF(msg).msg.sms_cnmi.mt = gsm.sms.direct ? 2 : 1;  /* Keep delivery of received messages */
+#else /* GSM_CFG_SMS_DIRECT */
+    GSM_MSG_VAR_REF(msg).msg.sms_cnmi.mt = 1;
+#endif /* !GSM_CFG_SMS_DIRECT */
+    GSM_MSG_VAR_REF(msg).msg.sms_cnmi.ds = !!enable;
+    GSM_MSG_VAR_REF(msg).msg.sms_cnmi.fo = 17;  /* SMS-SUBMIT with relative validity period, if not reported by device */
+    GSM_MSG_VAR_REF(msg).msg.sms_cnmi.format = !GSM_CFG_SMS_PDU;   /* Receive in PDU mode if enabled or as plain text */
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, blocking, 60000);   /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_DRAIN || __DOXYGEN__
+
+static uint8_t sms_drain_enabled;               /*!< Flag indicating drain mode is enabled */
+static uint8_t sms_drain_timeout_active;        /*!< Flag indicating drain timeout is scheduled */
+static uint32_t sms_drain_mem;                  /*!< Bit mask of memories with new messages */
+static uint32_t sms_drain_active;               /*!< Bit mask of memories with drain list queued or in progress */
+static uint32_t sms_drain_again;                /*!< Bit mask of memories to drain again when active drain finishes */
+static uint32_t sms_drain_time;                 /*!< Time of last `+CMTI` notification */
+static gsm_sms_entry_t sms_drain_entry;         /*!< Entry buffer for list operation */
+static gsm_sms_entry_t sms_drain_entries[GSM_CFG_SMS_DRAIN_SIZE];   /*!< Entries reported with batch event */
+static size_t sms_drain_cnt;                    /*!< Number of entries waiting for batch event */
+static size_t sms_drain_listed;                 /*!< Number of entries listed by active drain */
+
+/**
+ * \brief           Delete reported entries of batch from memory
+ *
+ *                  All positions are deleted by single message, memory is selected
+ *                  only once for all of them
+ *
+ * \param[in]       mem: Memory entries were listed from
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+static gsmr_t
+sms_drain_delete(gsm_mem_t mem) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    size_t i;
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGD;
+    GSM_MSG_VAR_REF(msg).steps = sms_delete_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_delete_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.mem = mem;
+    for (i = 0; i < sms_drain_cnt; i++) {
+        GSM_MSG_VAR_REF(msg).msg.sms_delete.drain_pos[i] = sms_drain_entries[i].pos;
+    }
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.drain_cnt = sms_drain_cnt;
+    GSM_MSG_VAR_REF(msg).msg.sms_delete.pos = sms_drain_entries[0].pos;
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, 0, 60000 * (uint32_t)sms_drain_cnt);  /* Send message to producer queue */
+}
+
+/**
+ * \brief           Report collected entries with batch event and delete them
+ *
+ *                  When drained entries were the only messages in memory when list started,
+ *                  last batch deletes all read messages with single command
+ *
+ * \param[in]       mem: Memory entries were listed from
+ * \param[in]       last: Set to `1` for last batch of drain list
+ */
+static void
+sms_drain_flush(gsm_mem_t mem, uint8_t last) {
+    const gsm_sms_mem_t* m = &gsm.sms.mem[GSM_SMS_OPERATION_IDX];
+    size_t i;
+
+    gsm.cb.cb.sms_recv_batch.mem = mem;
+    gsm.cb.cb.sms_recv_batch.entries = sms_drain_entries;
+    gsm.cb.cb.sms_recv_batch.size = sms_drain_cnt;
+    gsmi_send_cb(GSM_CB_SMS_RECV_BATCH);        /* Send to user */
+#if GSM_CFG_SMS_ROUTER
+    for (i = 0; i < sms_drain_cnt; i++) {
+        gsm_sms_router_dispatch(&sms_drain_entries[i]); /* Send to handler of sender route */
+    }
+#endif /* GSM_CFG_SMS_ROUTER */
+
+    /* Reported messages are not needed anymore */
+    sms_drain_listed += sms_drain_cnt;
+    if (last && m->current == mem && m->used == sms_drain_listed) {
+        gsm_sms_delete_all(mem, GSM_SMS_STATUS_READ, 0);    /* Drained messages are all read messages */
+    } else {
+        sms_drain_delete(mem);
+    }
+    sms_drain_cnt = 0;
+}
+
+/**
+ * \brief           Collect listed entry to batch
+ * \param[in]       entry: Listed entry
+ * \param[in]       arg: Unused argument
+ * \return          \ref gsmOK to continue listing
+ */
+static gsmr_t
+sms_drain_list_fn(const gsm_sms_entry_t* entry, void* arg) {
+    memcpy(&sms_drain_entries[sms_drain_cnt++], entry, sizeof(*entry));
+    if (sms_drain_cnt == GSM_ARRAYSIZE(sms_drain_entries)) {
+        sms_drain_flush(entry->mem, 0);         /* Batch is full, report and start new one */
+    }
+    GSM_UNUSED(arg);
+    return gsmOK;
+}
+
+/**
+ * \brief           Start listing of unread messages in memory
+ *
+ *                  When memory is already being drained, it is drained again
+ *                  after active list finishes, so only one list per memory is queued
+ *
+ * \param[in]       mem: Memory to drain
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+static gsmr_t
+sms_drain_start(gsm_mem_t mem) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+    gsmr_t res;
+
+    if (sms_drain_active & ((uint32_t)1 << (uint32_t)mem)) {
+        sms_drain_again |= (uint32_t)1 << (uint32_t)mem;
+        return gsmOK;
+    }
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGL;
+    GSM_MSG_VAR_REF(msg).steps = sms_drain_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_drain_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_list.mem = mem;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.status = GSM_SMS_STATUS_UNREAD;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.entries = &sms_drain_entry;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.etr = 1;  /* Single entry is reused */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.update = 1;   /* Mark messages as read */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.format = !GSM_CFG_SMS_PDU;   /* Read in PDU mode if enabled or as plain text */
+    GSM_MSG_VAR_REF(msg).msg.sms_list.fn = sms_drain_list_fn;
+    GSM_MSG_VAR_REF(msg).msg.sms_list.drain = 1;
+
+    res = gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, 0, 60000);  /* Send message to producer queue */
+    if (res == gsmOK) {
+        sms_drain_active |= (uint32_t)1 << (uint32_t)mem;
+    }
+    return res;
+}
+
+/**
+ * \brief           Drain memories when no new message was received for configured time
+ * \param[in]       arg: Unused
+ */
+static void
+sms_drain_timeout_fn(void* arg) {
+    uint32_t age;
+    size_t i;
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    sms_drain_timeout_active = 0;
+    age = gsm_sys_now() - sms_drain_time;
+    if (age < GSM_CFG_SMS_DRAIN_DELAY) {        /* New message received in the meantime */
+        if (gsm_timeout_add(GSM_CFG_SMS_DRAIN_DELAY - age, sms_drain_timeout_fn, NULL) == gsmOK) {
+            sms_drain_timeout_active = 1;
+        }
+    } else {
+        for (i = 0; i < GSM_MEM_END; i++) {
+            if (sms_drain_mem & ((uint32_t)1 << i)) {
+                sms_drain_start((gsm_mem_t)i);
+            }
+        }
+        sms_drain_mem = 0;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    GSM_UNUSED(arg);
+}
+
+/**
+ * \brief           Process `+CMTI` notification in drain mode
+ * \param[in]       mem: Memory of received message
+ * \return          `1` if message is reported later with batch event, `0` otherwise
+ */
+uint8_t
+gsmi_sms_drain_notify(gsm_mem_t mem) {
+    if (!sms_drain_enabled || mem >= GSM_MEM_END) {
+        return 0;
+    }
+    sms_drain_mem |= (uint32_t)1 << (uint32_t)mem;
+    sms_drain_time = gsm_sys_now();             /* Restart quiet window */
+    if (!sms_drain_timeout_active
+        && gsm_timeout_add(GSM_CFG_SMS_DRAIN_DELAY, sms_drain_timeout_fn, NULL) == gsmOK) {
+        sms_drain_timeout_active = 1;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Finish drain list operation
+ *
+ *                  Remaining entries are reported and deleted,
+ *                  also when list operation failed or timed out
+ *
+ * \param[in]       mem: Memory entries were listed from
+ */
+void
+gsmi_sms_drain_finish(gsm_mem_t mem) {
+    uint32_t bit = (uint32_t)1 << (uint32_t)mem;
+
+    if (sms_drain_cnt > 0) {
+        sms_drain_flush(mem, 1);
+    }
+    sms_drain_listed = 0;
+    sms_drain_active &= ~bit;
+    if (sms_drain_again & bit) {                /* Drain was requested while list was active */
+        sms_drain_again &= ~bit;
+        sms_drain_start(mem);
+    }
+}
+
+/**
+ * \brief           Enable or disable inbox drain mode
+ *
+ *                  When enabled, \ref GSM_CB_SMS_RECV event is not sent for new messages.
+ *                  Messages are listed after burst of `+CMTI` notifications and reported
+ *                  with \ref GSM_CB_SMS_RECV_BATCH events instead. Afterwards reported
+ *                  messages are deleted from memory, with single command when they were
+ *                  the only messages in memory, otherwise with one operation per batch
+ *                  without selecting memory again for every message. Other messages in memory are kept
+ *
+ * \note            When \ref GSM_CFG_SMS_CONCAT is enabled, parts of concatenated messages
+ *                  are deleted too, their data is kept for reassembly in local memory
+ * \param[in]       enable: Set to `1` to enable or `0` to disable drain mode
+ * \return          \ref gsmOK on success, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsm_sms_set_drain(uint8_t enable) {
+    GSM_CORE_PROTECT();                         /* Protect core */
+    sms_drain_enabled = !!enable;
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return gsmOK;
+}
+
+#endif /* GSM_CFG_SMS_DRAIN || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_WATERMARK || __DOXYGEN__
+
+static uint8_t sms_watermark_high;              /*!< Flag indicating high watermark was reached */
+
+/**
+ * \brief           Update usage of memory and check watermarks of memory for received messages
+ *
+ *                  \ref GSM_CB_SMS_STORAGE event is sent when watermark is crossed.
+ *                  On high watermark, read messages are deleted from memory
+ *                  and unread messages are drained when drain mode is enabled
+ *
+ * \param[in]       mem: Memory where number of messages changed
+ * \param[in]       diff: Change of number of messages, `1` for received, `-1` for deleted message
+ *                      or `0` when usage was read from device
+ */
+void
+gsmi_sms_watermark_update(gsm_mem_t mem, int8_t diff) {
+    gsm_sms_mem_t* m;
+    size_t i;
+
+    for (i = 0; i < GSM_ARRAYSIZE(gsm.sms.mem); i++) {
+        m = &gsm.sms.mem[i];
+        if (diff != 0 && mem < GSM_MEM_END && m->current == mem) {
+            if (diff > 0 && m->used < m->total) {
+                m->used++;
+            } else if (diff < 0 && m->used > 0) {
+                m->used--;
+            }
+        }
+    }
+
+    m = &gsm.sms.mem[GSM_SMS_RECEIVE_IDX];
+    if (m->current >= GSM_MEM_END || m->total == 0) {
+        return;                                 /* Usage not known */
+    }
+    if (!sms_watermark_high && m->used * 100 >= m->total * GSM_CFG_SMS_WATERMARK_HIGH) {
+        sms_watermark_high = 1;
+    } else if (sms_watermark_high && m->used * 100 <= m->total * GSM_CFG_SMS_WATERMARK_LOW) {
+        sms_watermark_high = 0;
+    } else {
+        return;                                 /* No transition */
+    }
+    gsm.cb.cb.sms_storage.mem = m->current;
+    gsm.cb.cb.sms_storage.used = m->used;
+    gsm.cb.cb.sms_storage.total = m->total;
+    gsm.cb.cb.sms_storage.high = sms_watermark_high;
+    gsmi_send_cb(GSM_CB_SMS_STORAGE);           /* Send to user */
+    if (sms_watermark_high) {
+        gsm_sms_delete_all(m->current, GSM_SMS_STATUS_READ, 0); /* Free memory occupied by read messages */
+#if GSM_CFG_SMS_DRAIN
+        if (sms_drain_enabled) {
+            sms_drain_start(m->current);        /* Report and delete unread messages too */
+        }
+#endif /* GSM_CFG_SMS_DRAIN */
+    }
+}
+
+#endif /* GSM_CFG_SMS_WATERMARK || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_OUTBOX || __DOXYGEN__
+
+/**
+ * \brief           Send single outbox message
+ *
+ *                  Result is reported with \ref gsmi_sms_outbox_result function
+ *                  when command finishes
+ *
+ * \param[in]       num: String number
+ * \param[in]       text: Text to send, must fit single message
+ * \param[in]       id: Outbox message ID
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsmi_sms_outbox_send_msg(const char* num, const char* text, uint32_t id) {
+    GSM_MSG_VAR_DEFINE(msg);                    /* Define variable for message */
+
+    CHECK_ENABLED();                            /* Check if enabled */
+
+    GSM_MSG_VAR_ALLOC(msg);                     /* Allocate memory for variable */
+    GSM_MSG_VAR_REF(msg).cmd_def = GSM_CMD_CMGS;
+    GSM_MSG_VAR_REF(msg).steps = sms_send_steps;
+    GSM_MSG_VAR_REF(msg).steps_len = GSM_ARRAYSIZE(sms_send_steps);
+    GSM_MSG_VAR_REF(msg).msg.sms_send.num = num;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.text = text;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.outbox_id = id;
+#if GSM_CFG_SMS_REPORT
+    GSM_MSG_VAR_REF(msg).msg.sms_send.tag = id; /* Status report is reported with outbox message ID */
+#endif /* GSM_CFG_SMS_REPORT */
+#if GSM_CFG_SMS_PDU
+    GSM_MSG_VAR_REF(msg).msg.sms_send.format = 0;   /* Send in PDU mode */
+    GSM_MSG_VAR_REF(msg).msg.sms_send.len = strlen(text);
+    GSM_MSG_VAR_REF(msg).msg.sms_send.coding = gsm_sms_pdu_get_coding(text, strlen(text));
+    GSM_MSG_VAR_REF(msg).msg.sms_send.parts = 1;
+    GSM_MSG_VAR_REF(msg).msg.sms_send.part_len = strlen(text);
+#else /* GSM_CFG_SMS_PDU */
+    GSM_MSG_VAR_REF(msg).msg.sms_send.format = 1;   /* Send as plain text */
+#endif /* !GSM_CFG_SMS_PDU */
+
+    return gsmi_send_msg_to_producer_mbox(&GSM_MSG_VAR_REF(msg), gsmi_initiate_cmd, 0, 60000);  /* Send message to producer queue */
+}
+
+#endif /* GSM_CFG_SMS_OUTBOX || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_CONCAT || __DOXYGEN__
+
+#define GSM_SMS_CONCAT_PART_LEN         (sizeof(((gsm_sms_entry_t *)0)->data) - 1)  /*!< Maximal length of single part data */
+
+/**
+ * \brief           Concatenated message being assembled
+ */
+typedef struct {
+    uint8_t total;                              /*!< Total number of parts. Set to `0` when slot is not used */
+    uint16_t ref;                               /*!< Reference number of message */
+    char number[26];                            /*!< Sender phone number */
+    gsm_datetime_t datetime;                    /*!< Date and time of first part */
+    gsm_sms_coding_t coding;                    /*!< Data coding of parts */
+    uint32_t received;                          /*!< Bit mask of received parts */
+    uint32_t time;                              /*!< Time when last part was received */
+    uint8_t truncated;                          /*!< Set to `1` when text of any part was truncated */
+    size_t len[GSM_CFG_SMS_CONCAT_PARTS];       /*!< Data length of each part */
+    char data[GSM_CFG_SMS_CONCAT_PARTS * GSM_SMS_CONCAT_PART_LEN + 1];  /*!< Data of all parts, one slot per part */
+} gsm_sms_concat_set_t;
+
+static gsm_sms_concat_set_t sms_concat_sets[GSM_CFG_SMS_CONCAT_SETS];   /*!< Messages being assembled */
+static uint8_t sms_concat_timeout_active;       /*!< Flag indicating expiry timeout is scheduled */
+
+/**
+ * \brief           Drop incomplete messages whose parts were not received in time
+ * \param[in]       arg: Unused
+ */
+static void
+sms_concat_timeout_fn(void* arg) {
+    gsm_sms_concat_set_t* s;
+    uint32_t now, age, next = 0xFFFFFFFF;
+    size_t i;
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    sms_concat_timeout_active = 0;
+    now = gsm_sys_now();
+    for (i = 0; i < GSM_ARRAYSIZE(sms_concat_sets); i++) {
+        s = &sms_concat_sets[i];
+        if (s->total) {
+            age = now - s->time;
+            if (age >= GSM_CFG_SMS_CONCAT_TIMEOUT) {
+                s->total = 0;                   /* Drop message, parts were already deleted from device memory */
+            } else {
+                next = GSM_MIN(next, GSM_CFG_SMS_CONCAT_TIMEOUT - age);
+            }
+        }
+    }
+    if (next != 0xFFFFFFFF && gsm_timeout_add(next, sms_concat_timeout_fn, NULL) == gsmOK) {
+        sms_concat_timeout_active = 1;          /* Check again when next message expires */
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    GSM_UNUSED(arg);
+}
+
+/**
+ * \brief           Get slot for concatenated message part
+ * \param[in]       entry: Received message part
+ * \return          Slot with matching sender, reference and number of parts,
+ *                  otherwise new slot, reusing the oldest one when all are in use
+ */
+static gsm_sms_concat_set_t*
+sms_concat_get_set(const gsm_sms_entry_t* entry) {
+    gsm_sms_concat_set_t *s, *free_set = NULL, *oldest = NULL;
+    size_t i;
+
+    for (i = 0; i < GSM_ARRAYSIZE(sms_concat_sets); i++) {
+        s = &sms_concat_sets[i];
+        if (!s->total) {
+            if (free_set == NULL) {
+                free_set = s;
+            }
+        } else if (s->ref == entry->concat.ref && s->total == entry->concat.total
+            && !strncmp(s->number, entry->number, sizeof(s->number))) {
+            return s;                           /* Part of existing message */
+        } else if (oldest == NULL || (int32_t)(s->time - oldest->time) < 0) {
+            oldest = s;
+        }
+    }
+    s = free_set != NULL ? free_set : oldest;
+    memset(s, 0x00, sizeof(*s));
+    s->total = entry->concat.total;
+    s->ref = entry->concat.ref;
+    s->coding = entry->coding;
+    strncpy(s->number, entry->number, sizeof(s->number) - 1);
+    return s;
+}
+
+/**
+ * \brief           Check if entry is part of concatenated message handled by reassembly
+ * \param[in]       entry: Received entry
+ * \return          `1` if entry is received part of concatenated message, `0` otherwise
+ */
+static uint8_t
+sms_concat_is_part(const gsm_sms_entry_t* entry) {
+    return entry->concat.total >= 2 && entry->concat.total <= GSM_CFG_SMS_CONCAT_PARTS
+        && entry->concat.seq > 0 && entry->concat.seq <= entry->concat.total
+        && (entry->status == GSM_SMS_STATUS_UNREAD || entry->status == GSM_SMS_STATUS_READ);
+}
+
+/**
+ * \brief           Add received SMS entry to concatenated message reassembly
+ *
+ *                  Called only for received messages, either delivered directly
+ *                  or drained from device memory. When all parts are received,
+ *                  \ref GSM_CB_SMS_CONCAT event is sent
+ *
+ * \note            Entries which are not part of concatenated message are ignored
+ * \param[in]       entry: Received entry
+ */
+void
+gsmi_sms_concat_process(const gsm_sms_entry_t* entry) {
+    gsm_sms_concat_set_t* s;
+    size_t i, len, idx;
+    uint32_t all;
+
+    if (!sms_concat_is_part(entry)) {
+        return;                                 /* Not a received part we can handle */
+    }
+
+    s = sms_concat_get_set(entry);
+    idx = entry->concat.seq - 1;
+    s->len[idx] = GSM_MIN(entry->length, GSM_SMS_CONCAT_PART_LEN);
+    memcpy(&s->data[idx * GSM_SMS_CONCAT_PART_LEN], entry->data, s->len[idx]);
+    if (entry->truncated || entry->length > GSM_SMS_CONCAT_PART_LEN) {
+        s->truncated = 1;
+    }
+    if (idx == 0) {
+        s->datetime = entry->datetime;          /* Message time is time of first part */
+    }
+    s->received |= (uint32_t)1 << idx;
+    s->time = gsm_sys_now();
+
+    all = s->total >= 32 ? 0xFFFFFFFF : (((uint32_t)1 << s->total) - 1);
+    if (s->received != all) {
+        if (!sms_concat_timeout_active
+            && gsm_timeout_add(GSM_CFG_SMS_CONCAT_TIMEOUT, sms_concat_timeout_fn, NULL) == gsmOK) {
+            sms_concat_timeout_active = 1;      /* Start expiry timeout */
+        }
+        return;
+    }
+
+    /* Move parts together, destination is never after source */
+    for (i = 0, len = 0; i < s->total; i++) {
+        memmove(&s->data[len], &s->data[i * GSM_SMS_CONCAT_PART_LEN], s->len[i]);
+        len += s->len[i];
+    }
+    s->data[len] = 0;
+
+    gsm.cb.cb.sms_concat.number = s->number;
+    gsm.cb.cb.sms_concat.datetime = &s->datetime;
+    gsm.cb.cb.sms_concat.ref = s->ref;
+    gsm.cb.cb.sms_concat.total = s->total;
+    gsm.cb.cb.sms_concat.coding = s->coding;
+    gsm.cb.cb.sms_concat.data = s->data;
+    gsm.cb.cb.sms_concat.length = len;
+    gsm.cb.cb.sms_concat.truncated = s->truncated;
+    gsmi_send_cb(GSM_CB_SMS_CONCAT);            /* Send to user */
+    s->total = 0;                               /* Release slot */
+}
+
+#endif /* GSM_CFG_SMS_CONCAT || __DOXYGEN__ */
+
 #endif /* GSM_CFG_SMS || __DOXYGEN__ */
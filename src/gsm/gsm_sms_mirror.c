@@ -0,0 +1,524 @@
+/**	
+ * \file            gsm_sms_mirror.c
+ * \brief           Local mirror of SMS storage
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_sms.h"
+
+#if GSM_CFG_SMS_MIRROR || __DOXYGEN__
+
+#define MEM_BIT(mem)                    ((uint32_t)1 << (uint32_t)(mem))
+#define MIRROR_BUCKETS                  16      /*!< Number of sender hash buckets per memory */
+#define MIRROR_STATUSES                 (GSM_SMS_STATUS_UNSENT + 1) /*!< Number of status values */
+
+/**
+ * \brief           Mirrored storage slot
+ */
+typedef struct {
+    gsm_sms_entry_t entry;                      /*!< Message entry, `mem` and `pos` identify slot */
+    uint32_t hash;                              /*!< Hash of sender number */
+    uint8_t complete;                           /*!< Flag indicating entry content is known */
+} gsm_sms_mirror_rec_t;
+
+static gsm_sms_mirror_rec_t mirror_recs[GSM_CFG_SMS_MIRROR_SIZE];   /*!< Records sorted by memory and position */
+static size_t mirror_cnt;                       /*!< Number of used records */
+static uint32_t mirror_valid;                   /*!< Bit mask of memories mirrored completely */
+static uint32_t mirror_sync;                    /*!< Bit mask of memories being synchronized */
+static uint16_t mirror_status_cnt[GSM_MEM_END][MIRROR_STATUSES];    /*!< Number of records per memory and status */
+static uint16_t mirror_bucket_cnt[GSM_MEM_END][MIRROR_BUCKETS]; /*!< Number of records per memory and sender hash bucket */
+
+/**
+ * \brief           Calculate hash of sender number
+ * \param[in]       number: Sender number
+ * \return          Hash value
+ */
+static uint32_t
+mirror_hash(const char* number) {
+    uint32_t hash = 2166136261UL;               /* FNV-1a */
+    for (; *number; number++) {
+        hash = (hash ^ (uint8_t)*number) * 16777619UL;
+    }
+    return hash;
+}
+
+/**
+ * \brief           Add record to or remove it from status and sender index
+ * \param[in]       r: Record with valid memory, status and hash
+ * \param[in]       add: Set to `1` to add record or `0` to remove it
+ */
+static void
+mirror_index(const gsm_sms_mirror_rec_t* r, uint8_t add) {
+    uint16_t* s = &mirror_status_cnt[r->entry.mem][r->entry.status < MIRROR_STATUSES ? r->entry.status : GSM_SMS_STATUS_ALL];
+    uint16_t* b = &mirror_bucket_cnt[r->entry.mem][r->hash % MIRROR_BUCKETS];
+
+    if (add) {
+        ++*s;
+        ++*b;
+    } else {
+        --*s;
+        --*b;
+    }
+}
+
+/**
+ * \brief           Replace \ref GSM_MEM_CURRENT with memory currently selected on device
+ * \param[in]       mem: Memory to resolve
+ * \return          Device memory
+ */
+static gsm_mem_t
+mirror_resolve_mem(gsm_mem_t mem) {
+    return mem == GSM_MEM_CURRENT ? gsm.sms.mem[0].current : mem;
+}
+
+/**
+ * \brief           Find record index for slot with binary search
+ * \param[in]       mem: Device memory
+ * \param[in]       pos: Position in memory
+ * \param[out]      found: Set to `1` if record exists, `0` otherwise
+ * \return          Index of record or index where new record must be inserted
+ */
+static size_t
+mirror_search(gsm_mem_t mem, size_t pos, uint8_t* found) {
+    const gsm_sms_entry_t* e;
+    size_t lo = 0, hi = mirror_cnt, mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        e = &mirror_recs[mid].entry;
+        if (e->mem < mem || (e->mem == mem && e->pos < pos)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    *found = lo < mirror_cnt && mirror_recs[lo].entry.mem == mem && mirror_recs[lo].entry.pos == pos;
+    return lo;
+}
+
+/**
+ * \brief           Get index of first record of memory
+ *
+ *                  Records are sorted by memory, records of memory end
+ *                  at first record with different memory
+ *
+ * \param[in]       mem: Device memory
+ * \return          Index of first record of memory or index where it would be inserted
+ */
+static size_t
+mirror_first(gsm_mem_t mem) {
+    uint8_t found;
+    return mirror_search(mem, 0, &found);       /* Lowest possible position */
+}
+
+/**
+ * \brief           Get record for slot and optionally create new one
+ *
+ *                  When there is no free record, memory cannot be mirrored completely anymore
+ *                  and is marked as not valid
+ *
+ * \param[in]       mem: Device memory
+ * \param[in]       pos: Position in memory
+ * \param[in]       create: Set to `1` to create record if it does not exist
+ * \return          Pointer to record or `NULL` if not available
+ */
+static gsm_sms_mirror_rec_t*
+mirror_get_rec(gsm_mem_t mem, size_t pos, uint8_t create) {
+    gsm_sms_mirror_rec_t* r;
+    uint8_t found;
+    size_t i;
+
+    i = mirror_search(mem, pos, &found);
+    if (found) {
+        return &mirror_recs[i];
+    } else if (!create) {
+        return NULL;
+    }
+    if (mirror_cnt >= GSM_ARRAYSIZE(mirror_recs)) {
+        mirror_valid &= ~MEM_BIT(mem);          /* Memory does not fit to mirror */
+        mirror_sync &= ~MEM_BIT(mem);
+        return NULL;
+    }
+    memmove(&mirror_recs[i + 1], &mirror_recs[i], (mirror_cnt - i) * sizeof(mirror_recs[0]));
+    mirror_cnt++;
+    r = &mirror_recs[i];
+    memset(r, 0x00, sizeof(*r));
+    r->entry.mem = mem;
+    r->entry.pos = pos;
+    r->hash = mirror_hash(r->entry.number);
+    mirror_index(r, 1);
+    return r;
+}
+
+/**
+ * \brief           Remove record at specific index
+ * \param[in]       i: Record index
+ */
+static void
+mirror_remove(size_t i) {
+    mirror_index(&mirror_recs[i], 0);
+    memmove(&mirror_recs[i], &mirror_recs[i + 1], (mirror_cnt - i - 1) * sizeof(mirror_recs[0]));
+    mirror_cnt--;
+}
+
+/**
+ * \brief           Check if entry matches status and sender filter
+ * \param[in]       e: Entry to check
+ * \param[in]       status: Status to match or \ref GSM_SMS_STATUS_ALL for any status
+ * \param[in]       number: Sender number to match or `NULL` for any sender
+ * \return          `1` on match, `0` otherwise
+ */
+static uint8_t
+mirror_match(const gsm_sms_entry_t* e, gsm_sms_status_t status, const char* number) {
+    return (status == GSM_SMS_STATUS_ALL || e->status == status)
+        && (number == NULL || !strcmp(e->number, number));
+}
+
+/**
+ * \brief           Check if memory is mirrored or being synchronized
+ * \param[in]       mem: Device memory
+ * \return          `1` if records for memory are kept, `0` otherwise
+ */
+static uint8_t
+mirror_is_tracked(gsm_mem_t mem) {
+    return mem < GSM_MEM_END && ((mirror_valid | mirror_sync) & MEM_BIT(mem));
+}
+
+/**
+ * \brief           Start synchronization of memory, all its records are removed
+ * \param[in]       mem: Device memory
+ */
+void
+gsmi_sms_mirror_sync_start(gsm_mem_t mem) {
+    size_t i;
+
+    mem = mirror_resolve_mem(mem);
+    if (mem >= GSM_MEM_END) {
+        return;
+    }
+    for (i = mirror_cnt; i > 0; i--) {
+        if (mirror_recs[i - 1].entry.mem == mem) {
+            mirror_remove(i - 1);
+        }
+    }
+    mirror_valid &= ~MEM_BIT(mem);
+    mirror_sync |= MEM_BIT(mem);
+}
+
+/**
+ * \brief           Finish synchronization of memory
+ * \param[in]       mem: Device memory
+ * \param[in]       ok: Set to `1` if all entries were listed successfully
+ */
+void
+gsmi_sms_mirror_sync_finish(gsm_mem_t mem, uint8_t ok) {
+    mem = mirror_resolve_mem(mem);
+    if (mem >= GSM_MEM_END) {
+        return;
+    }
+    if (ok && (mirror_sync & MEM_BIT(mem))) {
+        mirror_valid |= MEM_BIT(mem);
+    }
+    mirror_sync &= ~MEM_BIT(mem);
+}
+
+/**
+ * \brief           Update mirror with entry read or listed from device
+ * \param[in]       entry: Entry received from device
+ * \param[in]       update: Flag indicating device changed `UNREAD` status to `READ`
+ */
+void
+gsmi_sms_mirror_update(const gsm_sms_entry_t* entry, uint8_t update) {
+    gsm_sms_mirror_rec_t* r;
+    gsm_mem_t mem = mirror_resolve_mem(entry->mem);
+
+    if (mirror_is_tracked(mem) && (r = mirror_get_rec(mem, entry->pos, 1)) != NULL) {
+        mirror_index(r, 0);
+        memcpy(&r->entry, entry, sizeof(r->entry));
+        r->entry.mem = mem;
+        if (update && r->entry.status == GSM_SMS_STATUS_UNREAD) {
+            r->entry.status = GSM_SMS_STATUS_READ;
+        }
+        r->hash = mirror_hash(r->entry.number);
+        r->complete = 1;
+        mirror_index(r, 1);
+    }
+}
+
+/**
+ * \brief           Add new received message to mirror, content is read on first use
+ * \param[in]       mem: Device memory
+ * \param[in]       pos: Position in memory
+ */
+void
+gsmi_sms_mirror_add(gsm_mem_t mem, size_t pos) {
+    gsm_sms_mirror_rec_t* r;
+
+    mem = mirror_resolve_mem(mem);
+    if (mirror_is_tracked(mem) && (r = mirror_get_rec(mem, pos, 1)) != NULL) {
+        mirror_index(r, 0);
+        memset(&r->entry, 0x00, sizeof(r->entry));
+        r->entry.mem = mem;
+        r->entry.pos = pos;
+        r->entry.status = GSM_SMS_STATUS_UNREAD;
+        r->hash = mirror_hash(r->entry.number);
+        r->complete = 0;
+        mirror_index(r, 1);
+    }
+}
+
+/**
+ * \brief           Remove deleted message from mirror
+ * \param[in]       mem: Device memory
+ * \param[in]       pos: Position in memory
+ */
+void
+gsmi_sms_mirror_delete(gsm_mem_t mem, size_t pos) {
+    uint8_t found;
+    size_t i;
+
+    mem = mirror_resolve_mem(mem);
+    i = mirror_search(mem, pos, &found);
+    if (found) {
+        mirror_remove(i);
+    }
+}
+
+/**
+ * \brief           Remove group of deleted messages from mirror
+ * \param[in]       mem: Device memory
+ * \param[in]       status: Status of deleted messages or \ref GSM_SMS_STATUS_ALL for all messages
+ */
+void
+gsmi_sms_mirror_delete_status(gsm_mem_t mem, gsm_sms_status_t status) {
+    size_t i;
+
+    mem = mirror_resolve_mem(mem);
+    for (i = mirror_cnt; i > 0; i--) {
+        if (mirror_recs[i - 1].entry.mem == mem && mirror_match(&mirror_recs[i - 1].entry, status, NULL)) {
+            mirror_remove(i - 1);
+        }
+    }
+}
+
+/**
+ * \brief           Invalidate complete mirror
+ * \note            Must be called when device is reset
+ */
+void
+gsmi_sms_mirror_invalidate(void) {
+    mirror_cnt = 0;
+    mirror_valid = 0;
+    mirror_sync = 0;
+    memset(mirror_status_cnt, 0x00, sizeof(mirror_status_cnt));
+    memset(mirror_bucket_cnt, 0x00, sizeof(mirror_bucket_cnt));
+}
+
+/**
+ * \brief           Read entry from mirror instead of device
+ *
+ *                  Entry is available when content is known and status does not need update on device
+ *
+ * \param[in]       mem: Memory to read from
+ * \param[in]       pos: Position in memory
+ * \param[out]      entry: Pointer to entry to fill
+ * \param[in]       update: Flag indicating `UNREAD` status shall change to `READ`
+ * \return          \ref gsmOK if entry was read from mirror and \ref GSM_CB_SMS_READ event sent, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsmi_sms_mirror_read(gsm_mem_t mem, size_t pos, gsm_sms_entry_t* entry, uint8_t update) {
+    gsm_sms_mirror_rec_t* r;
+    gsmr_t res = gsmERR;
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    mem = mirror_resolve_mem(mem);
+    if (mem < GSM_MEM_END && (mirror_valid & MEM_BIT(mem))
+        && (r = mirror_get_rec(mem, pos, 0)) != NULL && r->complete
+        && !(update && r->entry.status == GSM_SMS_STATUS_UNREAD)) {
+        memcpy(entry, &r->entry, sizeof(*entry));
+        gsm.cb.cb.sms_read.entry = entry;
+        gsmi_send_cb(GSM_CB_SMS_READ);          /* Send to user */
+        res = gsmOK;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           List entries from mirror instead of device
+ *
+ *                  Entries are available when content of all matching entries is known
+ *                  and no status needs update on device
+ *
+ * \param[in]       mem: Memory to list
+ * \param[in]       stat: Status to list
+ * \param[out]      entries: Pointer to array to save entries
+ * \param[in]       etr: Number of entries to read
+ * \param[out]      er: Pointer to output variable to save number of entries in array
+ * \param[in]       update: Flag indicating `UNREAD` status shall change to `READ`
+ * \return          \ref gsmOK if entries were listed from mirror and \ref GSM_CB_SMS_LIST event sent, member of \ref gsmr_t otherwise
+ */
+gsmr_t
+gsmi_sms_mirror_list(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entries, size_t etr, size_t* er, uint8_t update) {
+    const gsm_sms_mirror_rec_t* r;
+    size_t i, n = 0;
+    gsmr_t res = gsmERR;
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    mem = mirror_resolve_mem(mem);
+    if (mem < GSM_MEM_END && (mirror_valid & MEM_BIT(mem))) {
+        res = gsmOK;
+        for (i = mirror_first(mem); i < mirror_cnt && mirror_recs[i].entry.mem == mem; i++) {  /* Check all entries can be listed locally */
+            r = &mirror_recs[i];
+            if (mirror_match(&r->entry, stat, NULL)
+                && (!r->complete || (update && r->entry.status == GSM_SMS_STATUS_UNREAD))) {
+                res = gsmERR;
+                break;
+            }
+        }
+    }
+    if (res == gsmOK) {
+        for (i = mirror_first(mem); i < mirror_cnt && mirror_recs[i].entry.mem == mem && n < etr; i++) {
+            r = &mirror_recs[i];
+            if (mirror_match(&r->entry, stat, NULL)) {
+                memcpy(&entries[n++], &r->entry, sizeof(*entries));
+            }
+        }
+        if (er != NULL) {
+            *er = n;
+        }
+        gsm.cb.cb.sms_list.mem = mem;
+        gsm.cb.cb.sms_list.entries = entries;
+        gsm.cb.cb.sms_list.size = n;
+        gsm.cb.cb.sms_list.err = gsmOK;
+        gsmi_send_cb(GSM_CB_SMS_LIST);          /* Send to user */
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Check if SMS memory is mirrored completely
+ * \param[in]       mem: Memory to check. Use \ref GSM_MEM_CURRENT to check current memory
+ * \return          `1` if mirror is valid, `0` otherwise
+ */
+uint8_t
+gsm_sms_mirror_is_valid(gsm_mem_t mem) {
+    uint8_t res;
+    GSM_CORE_PROTECT();                         /* Protect core */
+    mem = mirror_resolve_mem(mem);
+    res = mem < GSM_MEM_END && (mirror_valid & MEM_BIT(mem));
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Get entry from mirror without communication with device
+ * \param[in]       mem: Memory of entry. Use \ref GSM_MEM_CURRENT to use current memory
+ * \param[in]       pos: Position in memory
+ * \param[out]      entry: Pointer to entry to fill
+ * \return          \ref gsmOK on success, \ref gsmERR if slot is empty or content is not known,
+ *                  \ref gsmERRMEM if memory is not mirrored
+ */
+gsmr_t
+gsm_sms_mirror_get(gsm_mem_t mem, size_t pos, gsm_sms_entry_t* entry) {
+    gsm_sms_mirror_rec_t* r;
+    gsmr_t res = gsmERRMEM;
+
+    GSM_ASSERT("entry != NULL", entry != NULL); /* Assert input parameters */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    mem = mirror_resolve_mem(mem);
+    if (mem < GSM_MEM_END && (mirror_valid & MEM_BIT(mem))) {
+        res = gsmERR;
+        if ((r = mirror_get_rec(mem, pos, 0)) != NULL && r->complete) {
+            memcpy(entry, &r->entry, sizeof(*entry));
+            res = gsmOK;
+        }
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Find positions of stored messages by status and sender
+ *                  without communication with device
+ *
+ *                  Number of messages per status and per sender hash bucket is indexed.
+ *                  Counting by status is answered from index directly, search returns early
+ *                  when status or sender bucket is empty and stops after last possible match.
+ *                  Sender is compared by hash first and by number only on equal hash
+ *
+ * \note            New received messages are reported with \ref GSM_SMS_STATUS_UNREAD status
+ *                  and empty sender until they are read
+ * \param[in]       mem: Memory to search. Use \ref GSM_MEM_CURRENT to use current memory
+ * \param[in]       status: Status to match or \ref GSM_SMS_STATUS_ALL for any status
+ * \param[in]       number: Sender number to match or `NULL` for any sender
+ * \param[out]      pos: Array to save positions of matching messages. Set to `NULL` to count messages only
+ * \param[in]       posl: Length of positions array
+ * \return          Number of matching messages, may be more than array length
+ */
+size_t
+gsm_sms_mirror_find(gsm_mem_t mem, gsm_sms_status_t status, const char* number, size_t* pos, size_t posl) {
+    const gsm_sms_mirror_rec_t* r;
+    uint32_t hash = 0;
+    size_t i, n = 0, max = 0;
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    mem = mirror_resolve_mem(mem);
+    if (mem < GSM_MEM_END && status < MIRROR_STATUSES) {
+        if (status == GSM_SMS_STATUS_ALL) {     /* Number of all records of memory */
+            for (i = 0; i < MIRROR_STATUSES; i++) {
+                max += mirror_status_cnt[mem][i];
+            }
+        } else {
+            max = mirror_status_cnt[mem][status];
+        }
+        if (number != NULL) {
+            hash = mirror_hash(number);
+            max = GSM_MIN(max, mirror_bucket_cnt[mem][hash % MIRROR_BUCKETS]);
+        } else if (pos == NULL) {
+            n = max;                            /* Count by status only, answered from index */
+        }
+        for (i = mirror_first(mem); n < max && i < mirror_cnt && mirror_recs[i].entry.mem == mem; i++) {
+            r = &mirror_recs[i];
+            if ((number == NULL || r->hash == hash) && mirror_match(&r->entry, status, number)) {
+                if (pos != NULL && n < posl) {
+                    pos[n] = r->entry.pos;
+                }
+                n++;
+            }
+        }
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return n;
+}
+
+#endif /* GSM_CFG_SMS_MIRROR || __DOXYGEN__ */
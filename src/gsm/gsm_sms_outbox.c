@@ -0,0 +1,559 @@
+/**
+ * \file            gsm_sms_outbox.c
+ * \brief           SMS outbox with journal, rate limits and retries
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_sms.h"
+#include "gsm/gsm_timeout.h"
+
+#if GSM_CFG_SMS_OUTBOX || __DOXYGEN__
+
+#define OUTBOX_RETRY_DELAY              1000    /*!< Delay before next try when journal or producer queue is not available */
+
+/**
+ * \brief           Outbox message
+ */
+typedef struct {
+    uint32_t id;                                /*!< Message ID, `0` when slot is free */
+    char num[26];                               /*!< Phone number */
+    char text[GSM_CFG_SMS_OUTBOX_TEXT_LEN + 1]; /*!< Text to send */
+    uint32_t hash;                              /*!< Phone number hash for destination rate limit */
+    uint32_t next;                              /*!< Time when message may be sent again after failure */
+    uint16_t cms_err;                           /*!< Error code of last `+CMS ERROR` response */
+    uint8_t tries;                              /*!< Number of send attempts */
+    uint8_t pending;                            /*!< Flag indicating send command still uses message */
+} gsm_sms_outbox_msg_t;
+
+/**
+ * \brief           Recently used destination
+ */
+typedef struct {
+    uint32_t hash;                              /*!< Phone number hash, `0` when not used */
+    uint32_t time;                              /*!< Time of last send attempt */
+} gsm_sms_outbox_dest_t;
+
+static gsm_sms_outbox_msg_t outbox_msgs[GSM_CFG_SMS_OUTBOX_SIZE];   /*!< Messages waiting to be sent */
+static gsm_sms_outbox_dest_t outbox_dests[GSM_CFG_SMS_OUTBOX_SIZE]; /*!< Recently used destinations */
+static size_t outbox_dests_i;                   /*!< Next destination slot to overwrite */
+static gsm_sms_outbox_msg_t* outbox_active;     /*!< Message currently being sent, cleared on device reset */
+static const gsm_sms_outbox_journal_t* outbox_journal;  /*!< Application journal or `NULL` if not used */
+static uint8_t outbox_uncommitted;              /*!< Flag indicating journal has records not committed yet */
+static uint32_t outbox_id_next = 1;             /*!< ID for next added message */
+static uint32_t outbox_last_time;               /*!< Time of last send attempt */
+static uint8_t outbox_last_valid;               /*!< Flag indicating `outbox_last_time` is valid */
+
+static void outbox_timeout_fn(void* arg);
+static void outbox_pump(void);
+
+/**
+ * \brief           Calculate hash of phone number
+ * \param[in]       num: Phone number
+ * \return          Non-zero hash value
+ */
+static uint32_t
+outbox_hash(const char* num) {
+    uint32_t hash = 2166136261UL;               /* FNV-1a hash */
+
+    for (; *num != '\0'; num++) {
+        hash = (hash ^ (uint8_t)*num) * 16777619UL;
+    }
+    return hash != 0 ? hash : 1;
+}
+
+/**
+ * \brief           Get later of 2 time values, wrap-around safe
+ * \param[in]       t1: First time
+ * \param[in]       t2: Second time
+ * \return          Later time
+ */
+static uint32_t
+outbox_time_later(uint32_t t1, uint32_t t2) {
+    return (int32_t)(t2 - t1) > 0 ? t2 : t1;
+}
+
+/**
+ * \brief           Get time of last send attempt to destination
+ * \param[in]       hash: Phone number hash
+ * \param[out]      time: Pointer to output time
+ * \return          `1` if destination was used recently, `0` otherwise
+ */
+static uint8_t
+outbox_dest_get(uint32_t hash, uint32_t* time) {
+    size_t i;
+
+    for (i = 0; i < GSM_CFG_SMS_OUTBOX_SIZE; i++) {
+        if (outbox_dests[i].hash == hash) {
+            *time = outbox_dests[i].time;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Save time of send attempt to destination
+ * \param[in]       hash: Phone number hash
+ * \param[in]       time: Time of send attempt
+ */
+static void
+outbox_dest_set(uint32_t hash, uint32_t time) {
+    size_t i;
+
+    for (i = 0; i < GSM_CFG_SMS_OUTBOX_SIZE; i++) {
+        if (outbox_dests[i].hash == hash) {
+            outbox_dests[i].time = time;
+            return;
+        }
+    }
+    outbox_dests[outbox_dests_i].hash = hash;   /* Overwrite oldest destination */
+    outbox_dests[outbox_dests_i].time = time;
+    outbox_dests_i = (outbox_dests_i + 1) % GSM_CFG_SMS_OUTBOX_SIZE;
+}
+
+/**
+ * \brief           Find message by ID
+ * \param[in]       id: Message ID
+ * \return          Pointer to message or `NULL` if not found
+ */
+static gsm_sms_outbox_msg_t*
+outbox_find(uint32_t id) {
+    size_t i;
+
+    if (id == 0) {
+        return NULL;
+    }
+    for (i = 0; i < GSM_CFG_SMS_OUTBOX_SIZE; i++) {
+        if (outbox_msgs[i].id == id) {
+            return &outbox_msgs[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Get number of messages in outbox
+ * \return          Number of messages
+ */
+static size_t
+outbox_count(void) {
+    size_t i, cnt = 0;
+
+    for (i = 0; i < GSM_CFG_SMS_OUTBOX_SIZE; i++) {
+        if (outbox_msgs[i].id != 0) {
+            cnt++;
+        }
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Append record to journal
+ * \param[in]       type: Record type
+ * \param[in]       m: Message to write record for
+ * \param[in]       res: Final result for \ref GSM_SMS_OUTBOX_REC_DONE record
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+outbox_journal_append(gsm_sms_outbox_rec_type_t type, const gsm_sms_outbox_msg_t* m, gsmr_t res) {
+    gsm_sms_outbox_rec_t rec;
+
+    if (outbox_journal == NULL) {
+        return gsmOK;
+    }
+    rec.type = type;
+    rec.id = m->id;
+    rec.num = m->num;
+    rec.text = m->text;
+    rec.res = res;
+    if (outbox_journal->append(&rec, outbox_journal->arg) != gsmOK) {
+        return gsmERR;
+    }
+    outbox_uncommitted = 1;
+    return gsmOK;
+}
+
+/**
+ * \brief           Commit all appended journal records at once
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+static gsmr_t
+outbox_journal_commit(void) {
+    if (!outbox_uncommitted) {
+        return gsmOK;
+    }
+    if (outbox_journal != NULL && outbox_journal->commit(outbox_journal->arg) != gsmOK) {
+        return gsmERR;
+    }
+    outbox_uncommitted = 0;
+    return gsmOK;
+}
+
+/**
+ * \brief           Start timeout to process outbox
+ * \param[in]       time: Time to wait in units of milliseconds
+ */
+static void
+outbox_schedule(uint32_t time) {
+    gsm_timeout_remove(outbox_timeout_fn);      /* Only single timeout is active */
+    gsm_timeout_add(time, outbox_timeout_fn, NULL);
+}
+
+/**
+ * \brief           Add message to outbox
+ * \param[in]       num: Phone number
+ * \param[in]       text: Text to send
+ * \param[in]       id: Message ID
+ * \return          Pointer to message or `NULL` if outbox is full
+ */
+static gsm_sms_outbox_msg_t*
+outbox_add(const char* num, const char* text, uint32_t id) {
+    size_t i;
+
+    for (i = 0; i < GSM_CFG_SMS_OUTBOX_SIZE; i++) {
+        if (outbox_msgs[i].id == 0) {
+            gsm_sms_outbox_msg_t* m = &outbox_msgs[i];
+
+            memset(m, 0x00, sizeof(*m));
+            m->id = id;
+            strcpy(m->num, num);
+            strcpy(m->text, text);
+            m->hash = outbox_hash(num);
+            m->next = gsm_sys_now();
+            return m;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Finish message and release its slot
+ * \param[in]       m: Message to finish
+ * \param[in]       res: Final result
+ */
+static void
+outbox_finish(gsm_sms_outbox_msg_t* m, gsmr_t res) {
+    outbox_journal_append(GSM_SMS_OUTBOX_REC_DONE, m, res); /* On failure, message is sent again after restart */
+
+    gsm.cb.cb.sms_outbox.id = m->id;
+    gsm.cb.cb.sms_outbox.num = m->num;
+    gsm.cb.cb.sms_outbox.res = res;
+    gsm.cb.cb.sms_outbox.cms_err = m->cms_err;
+    gsm.cb.cb.sms_outbox.tries = m->tries;
+    gsm.cb.cb.sms_outbox.pending = outbox_count() - 1;
+    gsmi_send_cb(GSM_CB_SMS_OUTBOX);            /* Send to user */
+
+    m->id = 0;                                  /* Release slot */
+}
+
+/**
+ * \brief           Check if error code is temporary and message may be sent again
+ * \note            Plain `ERROR` response without error code is permanent
+ * \param[in]       cms_err: Error code of `+CMS ERROR` response
+ * \return          `1` if error is temporary, `0` otherwise
+ */
+static uint8_t
+outbox_is_temporary(uint16_t cms_err) {
+    switch (cms_err) {
+        case 38:                                /* Network out of order */
+        case 41:                                /* Temporary failure */
+        case 42:                                /* Congestion */
+        case 47:                                /* Resources unavailable */
+        case 331:                               /* No network service */
+        case 332:                               /* Network timeout */
+        case 500:                               /* Unknown error */
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * \brief           Process result of send attempt
+ * \param[in]       m: Message
+ * \param[in]       res: Send result
+ * \param[in]       cms_err: Error code of `+CMS ERROR` response or `0` if not received
+ */
+static void
+outbox_attempt_done(gsm_sms_outbox_msg_t* m, gsmr_t res, uint16_t cms_err) {
+    m->cms_err = cms_err;
+    if (res == gsmOK) {
+        outbox_finish(m, gsmOK);
+    } else if (m->tries < GSM_CFG_SMS_OUTBOX_RETRIES
+        && (res == gsmTIMEOUT || (cms_err != 0 && outbox_is_temporary(cms_err)))) {
+        m->next = gsm_sys_now() + ((uint32_t)GSM_CFG_SMS_OUTBOX_BACKOFF << (m->tries - 1));   /* Exponential backoff */
+    } else {
+        outbox_finish(m, res);
+    }
+}
+
+/**
+ * \brief           Commit journal and send next message allowed by rate limits
+ *
+ *                  Only one message is active at a time. When no message may be sent now,
+ *                  timeout is started for the earliest one
+ */
+static void
+outbox_pump(void) {
+    gsm_sms_outbox_msg_t* m = NULL;
+    uint32_t now, ready, time, wait = 0xFFFFFFFF;
+    size_t i;
+
+    if (outbox_active != NULL || !gsm.sms.enabled) {
+        return;                                 /* Continue when message finishes or SMS is enabled */
+    }
+    if (outbox_journal_commit() != gsmOK) {     /* Commit all records collected so far */
+        outbox_schedule(OUTBOX_RETRY_DELAY);
+        return;
+    }
+
+    now = gsm_sys_now();
+    for (i = 0; i < GSM_CFG_SMS_OUTBOX_SIZE; i++) {
+        if (outbox_msgs[i].id == 0 || outbox_msgs[i].pending) {
+            continue;
+        }
+        ready = outbox_msgs[i].next;
+        if (outbox_last_valid) {
+            ready = outbox_time_later(ready, outbox_last_time + GSM_CFG_SMS_OUTBOX_INTERVAL);
+        }
+        if (outbox_dest_get(outbox_msgs[i].hash, &time)) {
+            ready = outbox_time_later(ready, time + GSM_CFG_SMS_OUTBOX_DEST_INTERVAL);
+        }
+        if ((int32_t)(ready - now) <= 0) {      /* Oldest message wins */
+            if (m == NULL || outbox_msgs[i].id < m->id) {
+                m = &outbox_msgs[i];
+            }
+        } else if (ready - now < wait) {
+            wait = ready - now;
+        }
+    }
+
+    if (m != NULL) {
+        if (gsmi_sms_outbox_send_msg(m->num, m->text, m->id) == gsmOK) {
+            outbox_active = m;
+            m->pending = 1;                     /* Keep slot until send command finishes */
+            m->tries++;
+            outbox_last_time = now;
+            outbox_last_valid = 1;
+            outbox_dest_set(m->hash, now);
+            return;
+        }
+        wait = OUTBOX_RETRY_DELAY;              /* Producer queue is full, try again later */
+    }
+    if (wait != 0xFFFFFFFF) {
+        outbox_schedule(wait);
+    }
+}
+
+/**
+ * \brief           Process outbox from timeout
+ * \param[in]       arg: Unused
+ */
+static void
+outbox_timeout_fn(void* arg) {
+    GSM_CORE_PROTECT();                         /* Protect core */
+    outbox_pump();
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    GSM_UNUSED(arg);
+}
+
+/**
+ * \brief           Process result of outbox message send command
+ * \note            Called when core message finishes, including timeout,
+ *                  message text is not used by stack anymore
+ * \param[in]       id: Message ID
+ * \param[in]       res: Command result
+ * \param[in]       cms_err: Error code of `+CMS ERROR` response or `0` if not received
+ */
+void
+gsmi_sms_outbox_result(uint32_t id, gsmr_t res, uint16_t cms_err) {
+    gsm_sms_outbox_msg_t* m;
+
+    m = outbox_find(id);
+    if (m == NULL) {                            /* Message already finished */
+        return;
+    }
+    if (m == outbox_active) {
+        outbox_active = NULL;
+    }
+    m->pending = 0;
+    outbox_attempt_done(m, res, cms_err);
+    outbox_pump();
+}
+
+/**
+ * \brief           Send all waiting messages again without backoff delay
+ * \note            Called after device reset or when SMS is enabled
+ * \param[in]       reset: Set to `1` when called after device reset
+ */
+void
+gsmi_sms_outbox_resume(uint8_t reset) {
+    uint32_t now;
+    size_t i;
+
+    if (reset) {
+        outbox_active = NULL;                   /* Message which is still pending is not sent again */
+    }
+    now = gsm_sys_now();
+    for (i = 0; i < GSM_CFG_SMS_OUTBOX_SIZE; i++) {
+        if (outbox_msgs[i].id != 0) {
+            outbox_msgs[i].next = now;
+        }
+    }
+    outbox_pump();
+}
+
+/**
+ * \brief           Set journal for outbox persistence
+ *
+ *                  Every added message is appended to journal and committed before it is sent.
+ *                  After restart, application must replay journal records with \ref gsm_sms_outbox_replay
+ *
+ * \param[in]       journal: Journal functions or `NULL` to disable journal.
+ *                      Structure must stay valid while it is used
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sms_outbox_set_journal(const gsm_sms_outbox_journal_t* journal) {
+    GSM_ASSERT("journal == NULL || (journal->append != NULL && journal->commit != NULL)",
+        journal == NULL || (journal->append != NULL && journal->commit != NULL));
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    outbox_journal = journal;
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return gsmOK;
+}
+
+/**
+ * \brief           Replay journal record after restart
+ *
+ *                  Records must be replayed in order they were appended.
+ *                  Replayed records are not written to journal again
+ *
+ * \param[in]       rec: Journal record
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sms_outbox_replay(const gsm_sms_outbox_rec_t* rec) {
+    gsm_sms_outbox_msg_t* m;
+    gsmr_t res = gsmOK;
+
+    GSM_ASSERT("rec != NULL && rec->id > 0", rec != NULL && rec->id > 0);
+    GSM_ASSERT("rec->type != GSM_SMS_OUTBOX_REC_ADD || (rec->num != NULL && rec->text != NULL)",
+        rec->type != GSM_SMS_OUTBOX_REC_ADD || (rec->num != NULL && rec->text != NULL));
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    m = outbox_find(rec->id);
+    if (rec->type == GSM_SMS_OUTBOX_REC_ADD) {
+        if (m == NULL) {
+            if (strlen(rec->num) >= sizeof(m->num) || strlen(rec->text) > GSM_CFG_SMS_OUTBOX_TEXT_LEN) {
+                res = gsmPARERR;
+            } else if (outbox_add(rec->num, rec->text, rec->id) != NULL) {
+                outbox_schedule(GSM_CFG_SMS_OUTBOX_COMMIT_DELAY);
+            } else {
+                res = gsmERRMEM;
+            }
+        }
+    } else if (rec->type == GSM_SMS_OUTBOX_REC_DONE) {
+        if (m != NULL && !m->pending) {
+            m->id = 0;                          /* Message finished before restart */
+        }
+    }
+    if (rec->id >= outbox_id_next) {
+        outbox_id_next = rec->id + 1;           /* Never reuse ID from journal */
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Add SMS to outbox
+ *
+ *                  Message is sent by stack when rate limits allow it and is retried
+ *                  on temporary errors. Final result is reported with \ref GSM_CB_SMS_OUTBOX event
+ *
+ * \note            Messages added within \ref GSM_CFG_SMS_OUTBOX_COMMIT_DELAY are committed to journal together
+ * \param[in]       num: String number
+ * \param[in]       text: Text to send, must fit single message
+ * \param[out]      id: Pointer to output message ID. Set to `NULL` if not used
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sms_outbox_send(const char* num, const char* text, uint32_t* id) {
+    gsm_sms_outbox_msg_t* m;
+    gsmr_t res = gsmOK;
+#if GSM_CFG_SMS_PDU
+    gsm_sms_coding_t coding;
+#endif /* GSM_CFG_SMS_PDU */
+
+    GSM_ASSERT("num != NULL && strlen(num) < 26", num != NULL && strlen(num) < 26);
+    GSM_ASSERT("text != NULL && strlen(text) <= GSM_CFG_SMS_OUTBOX_TEXT_LEN",
+        text != NULL && strlen(text) <= GSM_CFG_SMS_OUTBOX_TEXT_LEN);
+#if GSM_CFG_SMS_PDU
+    coding = gsm_sms_pdu_get_coding(text, strlen(text));
+    GSM_ASSERT("text fits single message",
+        gsm_sms_pdu_get_text_len(text, strlen(text), coding) <= (coding == GSM_SMS_CODING_UCS2 ? 70 : 160));
+#else /* GSM_CFG_SMS_PDU */
+    GSM_ASSERT("strlen(text) <= 160", strlen(text) <= 160);
+#endif /* !GSM_CFG_SMS_PDU */
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    m = outbox_add(num, text, outbox_id_next);
+    if (m == NULL) {
+        res = gsmERRMEM;                        /* Outbox is full */
+    } else if (outbox_journal_append(GSM_SMS_OUTBOX_REC_ADD, m, gsmOK) != gsmOK) {
+        m->id = 0;                              /* Message is not persistent, do not accept it */
+        res = gsmERR;
+    } else {
+        if (id != NULL) {
+            *id = m->id;
+        }
+        outbox_id_next++;
+        outbox_schedule(GSM_CFG_SMS_OUTBOX_COMMIT_DELAY);   /* Collect more records before commit */
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Get number of messages waiting in outbox
+ * \return          Number of messages, including message being sent
+ */
+size_t
+gsm_sms_outbox_get_pending(void) {
+    size_t cnt;
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    cnt = outbox_count();
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return cnt;
+}
+
+#endif /* GSM_CFG_SMS_OUTBOX || __DOXYGEN__ */
@@ -0,0 +1,735 @@
+/**	
+ * \file            gsm_sms_pdu.c
+ * \brief           SMS PDU encoder and decoder
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_sms_pdu.h"
+
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+
+#define GSM7_ESC                        0x1B    /*!< Escape to extension table */
+#define GSM7_UNKNOWN                    0x3F    /*!< Character used when input cannot be represented, `?` */
+
+/**
+ * \brief           GSM 03.38 default alphabet
+ *
+ *                  Index in table is GSM code, value is unicode code point
+ */
+static const uint16_t
+gsm7_table[128] = {
+    0x0040, 0x00A3, 0x0024, 0x00A5, 0x00E8, 0x00E9, 0x00F9, 0x00EC,  /* 0x00 */
+    0x00F2, 0x00C7, 0x000A, 0x00D8, 0x00F8, 0x000D, 0x00C5, 0x00E5,
+    0x0394, 0x005F, 0x03A6, 0x0393, 0x039B, 0x03A9, 0x03A0, 0x03A8,  /* 0x10 */
+    0x03A3, 0x0398, 0x039E, 0x00A0, 0x00C6, 0x00E6, 0x00DF, 0x00C9,
+    0x0020, 0x0021, 0x0022, 0x0023, 0x00A4, 0x0025, 0x0026, 0x0027,  /* 0x20 */
+    0x0028, 0x0029, 0x002A, 0x002B, 0x002C, 0x002D, 0x002E, 0x002F,
+    0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,  /* 0x30 */
+    0x0038, 0x0039, 0x003A, 0x003B, 0x003C, 0x003D, 0x003E, 0x003F,
+    0x00A1, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,  /* 0x40 */
+    0x0048, 0x0049, 0x004A, 0x004B, 0x004C, 0x004D, 0x004E, 0x004F,
+    0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,  /* 0x50 */
+    0x0058, 0x0059, 0x005A, 0x00C4, 0x00D6, 0x00D1, 0x00DC, 0x00A7,
+    0x00BF, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,  /* 0x60 */
+    0x0068, 0x0069, 0x006A, 0x006B, 0x006C, 0x006D, 0x006E, 0x006F,
+    0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,  /* 0x70 */
+    0x0078, 0x0079, 0x007A, 0x00E4, 0x00F6, 0x00F1, 0x00FC, 0x00E0,
+};
+
+/**
+ * \brief           GSM 03.38 extension table entry
+ */
+typedef struct {
+    uint8_t code;                               /*!< GSM code after escape character */
+    uint16_t ch;                                /*!< Unicode code point */
+} gsm7_ext_t;
+
+/**
+ * \brief           GSM 03.38 extension table
+ */
+static const gsm7_ext_t
+gsm7_ext_table[] = {
+    { 0x0A, 0x000C },                           /* Form feed */
+    { 0x14, 0x005E },                           /* ^ */
+    { 0x28, 0x007B },                           /* { */
+    { 0x29, 0x007D },                           /* } */
+    { 0x2F, 0x005C },                           /* Backslash */
+    { 0x3C, 0x005B },                           /* [ */
+    { 0x3D, 0x007E },                           /* ~ */
+    { 0x3E, 0x005D },                           /* ] */
+    { 0x40, 0x007C },                           /* | */
+    { 0x65, 0x20AC },                           /* Euro sign */
+};
+
+/**
+ * \brief           Get next unicode code point from UTF-8 string
+ * \param[in,out]   str: Pointer to pointer to input string. Pointer is advanced after read
+ * \param[in,out]   len: Pointer to remaining length of string. Value is decreased after read
+ * \return          Unicode code point, `?` on invalid sequence
+ */
+static uint32_t
+utf8_get(const char** str, size_t* len) {
+    const uint8_t* s = (const void *)*str;
+    uint32_t cp;
+    size_t i, n;
+
+    if (s[0] < 0x80) {
+        cp = s[0];
+        n = 1;
+    } else if ((s[0] & 0xE0) == 0xC0) {
+        cp = s[0] & 0x1F;
+        n = 2;
+    } else if ((s[0] & 0xF0) == 0xE0) {
+        cp = s[0] & 0x0F;
+        n = 3;
+    } else if ((s[0] & 0xF8) == 0xF0) {
+        cp = s[0] & 0x07;
+        n = 4;
+    } else {
+        cp = '?';                               /* Invalid first byte */
+        n = 1;
+    }
+    for (i = 1; i < n; i++) {
+        if (i >= *len || (s[i] & 0xC0) != 0x80) {   /* Truncated or invalid sequence */
+            cp = '?';
+            break;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
+    }
+    *str += i;
+    *len -= i;
+    return cp;
+}
+
+/**
+ * \brief           Write unicode code point as UTF-8 sequence
+ * \param[out]      dst: Destination memory
+ * \param[in]       dst_len: Available length of destination memory
+ * \param[in]       cp: Unicode code point
+ * \return          Number of bytes written, `0` if there is no memory
+ */
+static size_t
+utf8_put(char* dst, size_t dst_len, uint32_t cp) {
+    uint8_t* d = (void *)dst;
+    size_t n;
+
+    n = cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+    if (n > dst_len) {
+        return 0;
+    }
+    switch (n) {
+        case 1: d[0] = (uint8_t)cp; break;
+        case 2: d[0] = (uint8_t)(0xC0 | (cp >> 6)); break;
+        case 3: d[0] = (uint8_t)(0xE0 | (cp >> 12)); break;
+        default: d[0] = (uint8_t)(0xF0 | (cp >> 18)); break;
+    }
+    if (n > 3) {
+        *++d = (uint8_t)(0x80 | ((cp >> 12) & 0x3F));
+    }
+    if (n > 2) {
+        *++d = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+    }
+    if (n > 1) {
+        *++d = (uint8_t)(0x80 | (cp & 0x3F));
+    }
+    return n;
+}
+
+/**
+ * \brief           Get GSM 7-bit code for unicode code point
+ * \param[in]       cp: Unicode code point
+ * \param[out]      code: Output array of `2` elements to write GSM codes to
+ * \return          Number of septets, `1` or `2` (extension table), `0` if not representable
+ */
+static uint8_t
+gsm7_from_unicode(uint32_t cp, uint8_t* code) {
+    size_t i;
+
+    /* Most characters have the same position as in ASCII table */
+    if ((cp >= 0x20 && cp <= 0x5A && cp != 0x24 && cp != 0x40) ||
+        (cp >= 0x61 && cp <= 0x7A) || cp == '\n' || cp == '\r') {
+        code[0] = (uint8_t)cp;
+        return 1;
+    }
+    for (i = 0; i < GSM_ARRAYSIZE(gsm7_table); i++) {
+        if (gsm7_table[i] == cp && i != GSM7_ESC) {
+            code[0] = (uint8_t)i;
+            return 1;
+        }
+    }
+    for (i = 0; i < GSM_ARRAYSIZE(gsm7_ext_table); i++) {
+        if (gsm7_ext_table[i].ch == cp) {
+            code[0] = GSM7_ESC;
+            code[1] = gsm7_ext_table[i].code;
+            return 2;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Get unicode code point for GSM 7-bit extension code
+ * \param[in]       code: GSM code after escape character
+ * \return          Unicode code point, space if code is not in extension table
+ */
+static uint32_t
+gsm7_ext_to_unicode(uint8_t code) {
+    size_t i;
+    for (i = 0; i < GSM_ARRAYSIZE(gsm7_ext_table); i++) {
+        if (gsm7_ext_table[i].code == code) {
+            return gsm7_ext_table[i].ch;
+        }
+    }
+    return ' ';
+}
+
+/**
+ * \brief           Write septet to packed 7-bit user data
+ * \param[out]      d: User data memory, must be zeroed before first call
+ * \param[in]       bit: Bit position of septet in user data
+ * \param[in]       s: Septet to write
+ */
+static void
+pack_septet(uint8_t* d, size_t bit, uint8_t s) {
+    size_t idx = bit >> 3;
+    uint8_t sh = bit & 0x07;
+
+    d[idx] |= (uint8_t)(s << sh);
+    if (sh > 1) {
+        d[idx + 1] |= (uint8_t)(s >> (8 - sh));
+    }
+}
+
+/**
+ * \brief           Read septet from packed 7-bit user data
+ * \param[in]       d: User data memory
+ * \param[in]       d_len: Length of user data memory in units of bytes
+ * \param[in]       bit: Bit position of septet in user data
+ * \return          Septet value
+ */
+static uint8_t
+unpack_septet(const uint8_t* d, size_t d_len, size_t bit) {
+    size_t idx = bit >> 3;
+    uint8_t sh = bit & 0x07;
+    uint16_t v;
+
+    v = d[idx] >> sh;
+    if (sh > 1 && idx + 1 < d_len) {
+        v |= d[idx + 1] << (8 - sh);
+    }
+    return v & 0x7F;
+}
+
+/**
+ * \brief           Encode phone number to address field
+ * \param[out]      d: Output memory, must be at least `12` bytes long
+ * \param[in]       num: Phone number. Leading `+` sets international format
+ * \return          Number of bytes written, `0` on failure
+ */
+static size_t
+encode_addr(uint8_t* d, const char* num) {
+    size_t digits = 0;
+    uint8_t v;
+
+    d[1] = 0x81;                                /* Unknown type, ISDN numbering plan */
+    if (*num == '+') {
+        d[1] = 0x91;                            /* International number */
+        num++;
+    }
+    for (; *num != '\0'; num++) {
+        if (GSM_CHARISNUM(*num)) {
+            v = GSM_CHARTONUM(*num);
+        } else if (*num == '*') {
+            v = 0x0A;
+        } else if (*num == '#') {
+            v = 0x0B;
+        } else {
+            continue;                           /* Ignore formatting characters */
+        }
+        if (digits >= 20) {
+            return 0;                           /* Number too long */
+        }
+        if (digits & 0x01) {
+            d[2 + digits / 2] = (d[2 + digits / 2] & 0x0F) | (v << 4);
+        } else {
+            d[2 + digits / 2] = 0xF0 | v;       /* Fill high nibble with padding */
+        }
+        digits++;
+    }
+    if (!digits) {
+        return 0;
+    }
+    d[0] = (uint8_t)digits;
+    return 2 + (digits + 1) / 2;
+}
+
+/**
+ * \brief           Decode address field to phone number
+ * \param[in]       d: Address field memory
+ * \param[in]       d_len: Available length of address field memory
+ * \param[out]      num: Output string
+ * \param[in]       num_len: Length of output string memory including `NULL` termination
+ * \return          Number of bytes used by address field, `0` on failure
+ */
+static size_t
+decode_addr(const uint8_t* d, size_t d_len, char* num, size_t num_len) {
+    size_t digits, octets, i, k = 0, n;
+    uint8_t v;
+
+    if (d_len < 2) {
+        return 0;
+    }
+    digits = d[0];
+    octets = (digits + 1) / 2;
+    if (d_len < 2 + octets) {
+        return 0;
+    }
+    if ((d[1] & 0x70) == 0x50) {                /* Alphanumeric address, 7-bit packed */
+        for (i = 0; i < digits * 4 / 7; i++) {
+            n = utf8_put(&num[k], num_len - 1 - k, gsm7_table[unpack_septet(&d[2], octets, i * 7)]);
+            if (!n) {
+                break;
+            }
+            k += n;
+        }
+    } else {
+        if ((d[1] & 0x70) == 0x10 && k + 1 < num_len) {
+            num[k++] = '+';                     /* International number */
+        }
+        for (i = 0; i < digits && k + 1 < num_len; i++) {
+            v = (i & 0x01) ? (d[2 + i / 2] >> 4) : (d[2 + i / 2] & 0x0F);
+            num[k++] = v < 10 ? ('0' + v) : v == 0x0A ? '*' : v == 0x0B ? '#' : (char)('a' + v - 0x0C);
+        }
+    }
+    num[k] = '\0';
+    return 2 + octets;
+}
+
+/**
+ * \brief           Decode service center time stamp
+ * \param[in]       d: Time stamp memory, `7` bytes long
+ * \param[out]      dt: Output date and time structure
+ */
+static void
+decode_scts(const uint8_t* d, gsm_datetime_t* dt) {
+#define BCD_SWAPPED(x)          (((x) & 0x0F) * 10 + ((x) >> 4))
+    dt->year = 2000 + BCD_SWAPPED(d[0]);
+    dt->month = BCD_SWAPPED(d[1]);
+    dt->date = BCD_SWAPPED(d[2]);
+    dt->hours = BCD_SWAPPED(d[3]);
+    dt->minutes = BCD_SWAPPED(d[4]);
+    dt->seconds = BCD_SWAPPED(d[5]);
+    dt->day = 0;                                /* Day in a week is not known */
+#undef BCD_SWAPPED
+}
+
+/**
+ * \brief           Get user data coding from data coding scheme
+ * \param[in]       dcs: Data coding scheme byte
+ * \return          Member of \ref gsm_sms_coding_t enumeration
+ */
+static gsm_sms_coding_t
+dcs_to_coding(uint8_t dcs) {
+    if ((dcs & 0x80) == 0x00) {                 /* General data coding groups */
+        switch ((dcs >> 2) & 0x03) {
+            case 1: return GSM_SMS_CODING_8BIT;
+            case 2: return GSM_SMS_CODING_UCS2;
+            default: return GSM_SMS_CODING_7BIT;
+        }
+    } else if ((dcs & 0xF0) == 0xE0) {          /* Message waiting group with UCS2 */
+        return GSM_SMS_CODING_UCS2;
+    } else if ((dcs & 0xF0) == 0xF0) {          /* Data coding and message class group */
+        return (dcs & 0x04) ? GSM_SMS_CODING_8BIT : GSM_SMS_CODING_7BIT;
+    }
+    return GSM_SMS_CODING_7BIT;
+}
+
+/**
+ * \brief           Parse user data header and get concatenation information
+ * \param[in]       d: Information elements memory, after header length byte
+ * \param[in]       len: Length of information elements
+ * \param[out]      concat: Output concatenation information
+ */
+static void
+parse_udh(const uint8_t* d, size_t len, gsm_sms_concat_t* concat) {
+    size_t i = 0;
+
+    while (i + 2 <= len && i + 2 + d[i + 1] <= len) {
+        if (d[i] == 0x00 && d[i + 1] == 3) {    /* Concatenated message, 8-bit reference */
+            concat->ref = d[i + 2];
+            concat->total = d[i + 3];
+            concat->seq = d[i + 4];
+        } else if (d[i] == 0x08 && d[i + 1] == 4) { /* Concatenated message, 16-bit reference */
+            concat->ref = (d[i + 2] << 8) | d[i + 3];
+            concat->total = d[i + 4];
+            concat->seq = d[i + 5];
+        }
+        i += 2 + d[i + 1];                      /* Go to next information element */
+    }
+}
+
+/**
+ * \brief           Write character to entry data as UTF-8 sequence
+ * \param[in,out]   e: SMS entry
+ * \param[in]       cp: Unicode code point
+ * \return          `1` on success, `0` if entry data memory is full
+ */
+static uint8_t
+entry_put(gsm_sms_entry_t* e, uint32_t cp) {
+    size_t n = utf8_put(&e->data[e->length], sizeof(e->data) - 1 - e->length, cp);
+    e->length += n;
+    return n > 0;
+}
+
+/**
+ * \brief           Get user data coding required to send text
+ * \param[in]       text: UTF-8 encoded text
+ * \param[in]       len: Length of text in units of bytes
+ * \return          \ref GSM_SMS_CODING_7BIT if all characters exist in GSM alphabet, \ref GSM_SMS_CODING_UCS2 otherwise
+ */
+gsm_sms_coding_t
+gsm_sms_pdu_get_coding(const char* text, size_t len) {
+    uint8_t code[2];
+
+    while (len) {
+        if (!gsm7_from_unicode(utf8_get(&text, &len), code)) {
+            return GSM_SMS_CODING_UCS2;
+        }
+    }
+    return GSM_SMS_CODING_7BIT;
+}
+
+/**
+ * \brief           Get length of text in units of encoding
+ * \param[in]       text: UTF-8 encoded text or binary data for \ref GSM_SMS_CODING_8BIT
+ * \param[in]       len: Length of text in units of bytes
+ * \param[in]       coding: Coding to use
+ * \return          Number of septets for 7-bit, number of 16-bit units for UCS2 or bytes for 8-bit coding
+ */
+size_t
+gsm_sms_pdu_get_text_len(const char* text, size_t len, gsm_sms_coding_t coding) {
+    size_t units = 0;
+    uint32_t cp;
+    uint8_t code[2], n;
+
+    if (coding == GSM_SMS_CODING_8BIT) {
+        return len;
+    }
+    while (len) {
+        cp = utf8_get(&text, &len);
+        if (coding == GSM_SMS_CODING_UCS2) {
+            units += cp > 0xFFFF ? 2 : 1;       /* Surrogate pair for characters outside basic plane */
+        } else {
+            n = gsm7_from_unicode(cp, code);
+            units += n ? n : 1;                 /* Unknown characters are replaced */
+        }
+    }
+    return units;
+}
+
+/**
+ * \brief           Get number of bytes from beginning of text which fit to maximal number of units
+ *
+ *                  Text is never split in the middle of character or GSM 7-bit escape sequence
+ *
+ * \param[in]       text: UTF-8 encoded text or binary data for \ref GSM_SMS_CODING_8BIT
+ * \param[in]       len: Length of text in units of bytes
+ * \param[in]       coding: Coding to use
+ * \param[in]       max_units: Maximal number of units, see \ref gsm_sms_pdu_get_text_len for unit description
+ * \return          Number of bytes from text which fit to maximal number of units
+ */
+size_t
+gsm_sms_pdu_get_text_fit(const char* text, size_t len, gsm_sms_coding_t coding, size_t max_units) {
+    const char* start = text;
+    const char* prev;
+    size_t units = 0;
+    uint32_t cp;
+    uint8_t code[2], n;
+
+    if (coding == GSM_SMS_CODING_8BIT) {
+        return GSM_MIN(len, max_units);
+    }
+    while (len) {
+        prev = text;
+        cp = utf8_get(&text, &len);
+        if (coding == GSM_SMS_CODING_UCS2) {
+            n = cp > 0xFFFF ? 2 : 1;
+        } else {
+            n = gsm7_from_unicode(cp, code);
+            n = n ? n : 1;
+        }
+        if (units + n > max_units) {
+            return prev - start;                /* Character does not fit anymore */
+        }
+        units += n;
+    }
+    return text - start;
+}
+
+/**
+ * \brief           Encode SMS-SUBMIT PDU
+ * \param[out]      pdu: Output memory, must be at least \ref GSM_SMS_PDU_MAX_LEN bytes long
+ * \param[in]       num: Destination phone number
+ * \param[in]       data: UTF-8 encoded text or binary data for \ref GSM_SMS_CODING_8BIT
+ * \param[in]       len: Length of data in units of bytes
+ * \param[in]       coding: User data coding
+ * \param[in]       concat: Concatenation information to write to user data header. Set to `NULL` if not used
+ * \return          Number of bytes written including SMSC information byte, `0` if data do not fit to single PDU
+ */
+size_t
+gsm_sms_pdu_encode_submit(uint8_t* pdu, const char* num, const void* data, size_t len, gsm_sms_coding_t coding, const gsm_sms_concat_t* concat) {
+    const char* text = data;
+    uint8_t* ud;
+    uint8_t code[2], n, k;
+    size_t i = 0, udl_pos, udhl = 0, o;
+    uint32_t cp;
+    uint16_t hs;
+
+    pdu[i++] = 0x00;                            /* Use SMSC stored in device */
+    pdu[i++] = 0x01 | (concat != NULL ? 0x40 : 0x00);   /* SMS-SUBMIT with optional user data header */
+    pdu[i++] = 0x00;                            /* Message reference is set by device */
+    if ((o = encode_addr(&pdu[i], num)) == 0) {
+        return 0;
+    }
+    i += o;
+    pdu[i++] = 0x00;                            /* Protocol identifier */
+    pdu[i++] = (uint8_t)coding;                 /* Data coding scheme */
+    udl_pos = i++;
+    ud = &pdu[i];
+    memset(ud, 0x00, GSM_SMS_PDU_UD_MAX_LEN);
+
+    if (concat != NULL) {                       /* Write concatenation header */
+        if (concat->ref > 0xFF) {
+            ud[udhl++] = 6;
+            ud[udhl++] = 0x08;
+            ud[udhl++] = 4;
+            ud[udhl++] = (uint8_t)(concat->ref >> 8);
+        } else {
+            ud[udhl++] = 5;
+            ud[udhl++] = 0x00;
+            ud[udhl++] = 3;
+        }
+        ud[udhl++] = (uint8_t)concat->ref;
+        ud[udhl++] = concat->total;
+        ud[udhl++] = concat->seq;
+    }
+
+    if (coding == GSM_SMS_CODING_7BIT) {
+        o = (udhl * 8 + 6) / 7;                 /* Septets used by header, including fill bits */
+        while (len) {
+            cp = utf8_get(&text, &len);
+            if ((n = gsm7_from_unicode(cp, code)) == 0) {
+                code[0] = GSM7_UNKNOWN;
+                n = 1;
+            }
+            for (k = 0; k < n; k++, o++) {
+                if (o >= 160) {
+                    return 0;
+                }
+                pack_septet(ud, o * 7, code[k]);
+            }
+        }
+        pdu[udl_pos] = (uint8_t)o;              /* Length in units of septets */
+        i += (o * 7 + 7) / 8;
+    } else if (coding == GSM_SMS_CODING_UCS2) {
+        o = udhl;
+        while (len) {
+            cp = utf8_get(&text, &len);
+            if (cp > 0xFFFF) {                  /* Encode as surrogate pair */
+                if (o + 4 > GSM_SMS_PDU_UD_MAX_LEN) {
+                    return 0;
+                }
+                cp -= 0x10000;
+                hs = (uint16_t)(0xD800 | (cp >> 10));   /* High surrogate */
+                ud[o++] = (uint8_t)(hs >> 8);
+                ud[o++] = (uint8_t)hs;
+                cp = 0xDC00 | (cp & 0x3FF);     /* Low surrogate */
+            }
+            if (o + 2 > GSM_SMS_PDU_UD_MAX_LEN) {
+                return 0;
+            }
+            ud[o++] = (uint8_t)(cp >> 8);
+            ud[o++] = (uint8_t)cp;
+        }
+        pdu[udl_pos] = (uint8_t)o;
+        i += o;
+    } else {
+        if (udhl + len > GSM_SMS_PDU_UD_MAX_LEN) {
+            return 0;
+        }
+        memcpy(&ud[udhl], data, len);
+        o = udhl + len;
+        pdu[udl_pos] = (uint8_t)o;
+        i += o;
+    }
+    return i;
+}
+
+/**
+ * \brief           Decode SMS-DELIVER or SMS-SUBMIT PDU to SMS entry
+ *
+ *                  Number, date and time, coding, concatenation information and data are set.
+ *                  Text is written as UTF-8 string, 8-bit data are copied as is
+ *
+ * \param[in]       pdu: PDU memory, starting with SMSC information
+ * \param[in]       len: Length of PDU in units of bytes
+ * \param[out]      entry: SMS entry to fill
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gsm_sms_pdu_decode(const uint8_t* pdu, size_t len, gsm_sms_entry_t* entry) {
+    const uint8_t* p = pdu;
+    const uint8_t* end = pdu + len;
+    uint8_t fo, dcs, udl, s;
+    size_t i, n, udhl = 0, ud_len;
+    uint32_t cp;
+
+#define PDU_CHECK_LEN(x)        if ((size_t)(end - p) < (size_t)(x)) { return 0; }
+    PDU_CHECK_LEN(1);
+    n = *p++;                                   /* SMSC information length */
+    PDU_CHECK_LEN(n + 1);
+    p += n;
+    fo = *p++;                                  /* First octet */
+    if ((fo & 0x03) == 0x01) {                  /* SMS-SUBMIT, stored outgoing message */
+        PDU_CHECK_LEN(1);
+        p++;                                    /* Skip message reference */
+    } else if ((fo & 0x03) != 0x00) {           /* Only SMS-DELIVER is supported otherwise */
+        return 0;
+    }
+    if ((n = decode_addr(p, end - p, entry->number, sizeof(entry->number))) == 0) {
+        return 0;
+    }
+    p += n;
+    PDU_CHECK_LEN(2);
+    p++;                                        /* Skip protocol identifier */
+    dcs = *p++;
+    if ((fo & 0x03) == 0x00) {                  /* SMS-DELIVER has time stamp */
+        PDU_CHECK_LEN(7);
+        decode_scts(p, &entry->datetime);
+        p += 7;
+    } else {                                    /* SMS-SUBMIT may have validity period */
+        n = ((fo >> 3) & 0x03) == 0x02 ? 1 : ((fo >> 3) & 0x03) ? 7 : 0;
+        PDU_CHECK_LEN(n);
+        p += n;
+    }
+    PDU_CHECK_LEN(1);
+    udl = *p++;
+    ud_len = end - p;
+#undef PDU_CHECK_LEN
+
+    entry->coding = dcs_to_coding(dcs);
+    memset(&entry->concat, 0x00, sizeof(entry->concat));
+    if ((fo & 0x40) && ud_len) {                /* User data header is present */
+        udhl = p[0] + 1;
+        if (udhl > ud_len) {
+            return 0;
+        }
+        parse_udh(&p[1], p[0], &entry->concat);
+    }
+
+    entry->length = 0;
+    entry->truncated = 0;
+    if (entry->coding == GSM_SMS_CODING_7BIT) {
+        for (i = (udhl * 8 + 6) / 7; i < udl && ((i * 7) >> 3) < ud_len; i++) {
+            s = unpack_septet(p, ud_len, i * 7);
+            if (s == GSM7_ESC && i + 1 < udl && (((i + 1) * 7) >> 3) < ud_len) {
+                i++;
+                cp = gsm7_ext_to_unicode(unpack_septet(p, ud_len, i * 7));
+            } else {
+                cp = gsm7_table[s];
+            }
+            if (!entry_put(entry, cp)) {
+                entry->truncated = 1;           /* UTF-8 text does not fit data memory */
+                break;
+            }
+        }
+    } else if (entry->coding == GSM_SMS_CODING_UCS2) {
+        n = GSM_MIN(udl, ud_len);
+        for (i = udhl; i + 1 < n; i += 2) {
+            cp = (p[i] << 8) | p[i + 1];
+            if (cp >= 0xD800 && cp <= 0xDBFF && i + 3 < n) {    /* Surrogate pair */
+                cp = 0x10000 + (((cp & 0x3FF) << 10) | (((p[i + 2] << 8) | p[i + 3]) & 0x3FF));
+                i += 2;
+            }
+            if (!entry_put(entry, cp)) {
+                entry->truncated = 1;           /* UTF-8 text does not fit data memory */
+                break;
+            }
+        }
+    } else {
+        n = GSM_MIN(udl, ud_len);
+        n = n > udhl ? n - udhl : 0;
+        if (n > sizeof(entry->data) - 1) {
+            n = sizeof(entry->data) - 1;
+            entry->truncated = 1;
+        }
+        memcpy(entry->data, &p[udhl], n);
+        entry->length = n;
+    }
+    entry->data[entry->length] = '\0';
+    return 1;
+}
+
+/**
+ * \brief           Decode SMS-STATUS-REPORT PDU
+ * \param[in]       pdu: PDU memory, starting with SMSC information
+ * \param[in]       len: Length of PDU in units of bytes
+ * \param[out]      report: Status report to fill
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+gsm_sms_pdu_decode_report(const uint8_t* pdu, size_t len, gsm_sms_report_t* report) {
+    const uint8_t* p = pdu;
+    const uint8_t* end = pdu + len;
+    size_t n;
+
+#define PDU_CHECK_LEN(x)        if ((size_t)(end - p) < (size_t)(x)) { return 0; }
+    PDU_CHECK_LEN(1);
+    n = *p++;                                   /* SMSC information length */
+    PDU_CHECK_LEN(n + 2);
+    p += n;
+    if ((*p++ & 0x03) != 0x02) {                /* First octet must be SMS-STATUS-REPORT */
+        return 0;
+    }
+    report->mr = *p++;
+    if ((n = decode_addr(p, end - p, report->number, sizeof(report->number))) == 0) {
+        return 0;
+    }
+    p += n;
+    PDU_CHECK_LEN(15);
+    p += 7;                                     /* Skip time when message was received by network */
+    decode_scts(p, &report->datetime);          /* Discharge time */
+    p += 7;
+    report->st = *p;
+#undef PDU_CHECK_LEN
+    return 1;
+}
+
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
@@ -0,0 +1,221 @@
+/**
+ * \file            gsm_sms_report.c
+ * \brief           SMS delivery status report tracking
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_sms.h"
+#include "gsm/gsm_timeout.h"
+
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+
+#define REPORT_HASH(mr)                 ((size_t)(mr) % GSM_CFG_SMS_REPORT_SIZE)
+
+/**
+ * \brief           Sent message waiting for status report
+ */
+typedef struct {
+    uint8_t used;                               /*!< Flag indicating slot is used */
+    uint8_t mr;                                 /*!< Message reference, key of the table */
+    uint32_t tag;                               /*!< User tag of message */
+    uint32_t time;                              /*!< Time when message was sent */
+} gsm_sms_report_rec_t;
+
+static gsm_sms_report_rec_t report_recs[GSM_CFG_SMS_REPORT_SIZE];   /*!< Open addressing table indexed by message reference */
+static uint8_t report_timeout_active;           /*!< Flag indicating expiry timeout is active */
+
+/**
+ * \brief           Find record by message reference
+ * \param[in]       mr: Message reference
+ * \return          Record index or `GSM_CFG_SMS_REPORT_SIZE` if not found
+ */
+static size_t
+report_find(uint8_t mr) {
+    size_t i, n;
+
+    for (i = REPORT_HASH(mr), n = 0; n < GSM_CFG_SMS_REPORT_SIZE && report_recs[i].used;
+            i = (i + 1) % GSM_CFG_SMS_REPORT_SIZE, n++) {
+        if (report_recs[i].mr == mr) {
+            return i;
+        }
+    }
+    return GSM_CFG_SMS_REPORT_SIZE;
+}
+
+/**
+ * \brief           Remove record from table
+ *
+ *                  Following records of the same probe sequence are moved back,
+ *                  so lookups never stop on a hole
+ *
+ * \param[in]       i: Record index
+ */
+static void
+report_remove(size_t i) {
+    size_t j = i, home;
+
+    report_recs[i].used = 0;
+    while (1) {
+        j = (j + 1) % GSM_CFG_SMS_REPORT_SIZE;
+        if (!report_recs[j].used) {
+            break;
+        }
+        home = REPORT_HASH(report_recs[j].mr);
+        if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) {
+            continue;                           /* Record is still reachable from its home slot */
+        }
+        report_recs[i] = report_recs[j];        /* Move record to the hole */
+        report_recs[j].used = 0;
+        i = j;
+    }
+}
+
+/**
+ * \brief           Report and remove record
+ * \param[in]       i: Record index
+ * \param[in]       report: Received status report or `NULL` when record expired
+ * \param[in]       res: Result to report
+ */
+static void
+report_finish(size_t i, const gsm_sms_report_t* report, gsmr_t res) {
+    gsm.cb.cb.sms_report.tag = report_recs[i].tag;
+    gsm.cb.cb.sms_report.mr = report_recs[i].mr;
+    gsm.cb.cb.sms_report.report = report;
+    gsm.cb.cb.sms_report.res = res;
+    report_remove(i);
+    gsmi_send_cb(GSM_CB_SMS_REPORT);            /* Send to user */
+}
+
+static void report_timeout_fn(void* arg);
+
+/**
+ * \brief           Report expired records and start timeout for the next one
+ */
+static void
+report_expire(void) {
+    uint32_t now, age, next = 0xFFFFFFFF;
+    size_t i;
+
+    now = gsm_sys_now();
+    for (i = 0; i < GSM_CFG_SMS_REPORT_SIZE; ) {
+        if (report_recs[i].used) {
+            age = now - report_recs[i].time;
+            if (age >= GSM_CFG_SMS_REPORT_TIMEOUT) {
+                report_finish(i, NULL, gsmTIMEOUT);
+                continue;                       /* Other record may be moved to this slot */
+            } else if (GSM_CFG_SMS_REPORT_TIMEOUT - age < next) {
+                next = GSM_CFG_SMS_REPORT_TIMEOUT - age;
+            }
+        }
+        i++;
+    }
+    if (!report_timeout_active && next != 0xFFFFFFFF
+        && gsm_timeout_add(next, report_timeout_fn, NULL) == gsmOK) {
+        report_timeout_active = 1;
+    }
+}
+
+/**
+ * \brief           Expire records waiting for status report too long
+ * \param[in]       arg: Unused
+ */
+static void
+report_timeout_fn(void* arg) {
+    GSM_CORE_PROTECT();                         /* Protect core */
+    report_timeout_active = 0;
+    report_expire();
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    GSM_UNUSED(arg);
+}
+
+/**
+ * \brief           Save sent message to wait for its status report
+ *
+ *                  Record with the same reference is replaced and reported as expired.
+ *                  When table is full, oldest record is reported as expired
+ *
+ * \param[in]       mr: Message reference received with `+CMGS`
+ * \param[in]       tag: User tag of message
+ */
+void
+gsmi_sms_report_add(uint8_t mr, uint32_t tag) {
+    size_t i, cnt = 0, oldest = 0;
+
+    if ((i = report_find(mr)) < GSM_CFG_SMS_REPORT_SIZE) {
+        report_finish(i, NULL, gsmTIMEOUT);     /* Reference was reused before report arrived */
+    }
+    for (i = 0; i < GSM_CFG_SMS_REPORT_SIZE; i++) {
+        if (report_recs[i].used) {
+            if (!cnt++ || (int32_t)(report_recs[i].time - report_recs[oldest].time) < 0) {
+                oldest = i;
+            }
+        }
+    }
+    if (cnt == GSM_CFG_SMS_REPORT_SIZE) {       /* Table is full */
+        report_finish(oldest, NULL, gsmTIMEOUT);
+    }
+    i = REPORT_HASH(mr);
+    while (report_recs[i].used) {               /* Linear probing for free slot */
+        i = (i + 1) % GSM_CFG_SMS_REPORT_SIZE;
+    }
+    report_recs[i].used = 1;
+    report_recs[i].mr = mr;
+    report_recs[i].tag = tag;
+    report_recs[i].time = gsm_sys_now();
+    report_expire();                            /* Make sure expiry timeout is active */
+}
+
+/**
+ * \brief           Process received status report
+ *
+ *                  Final status is reported with \ref GSM_CB_SMS_REPORT event.
+ *                  Reports with temporary status keep message waiting for final report
+ *
+ * \param[in]       report: Received status report
+ */
+void
+gsmi_sms_report_process(const gsm_sms_report_t* report) {
+    size_t i;
+
+    if (report->st >= 0x20 && report->st < 0x40) {
+        return;                                 /* Network is still trying to deliver message */
+    }
+    if ((i = report_find(report->mr)) < GSM_CFG_SMS_REPORT_SIZE) {
+        report_finish(i, report, report->st < 0x20 ? gsmOK : gsmERR);
+    } else {                                    /* Message is not tracked anymore */
+        gsm.cb.cb.sms_report.tag = 0;
+        gsm.cb.cb.sms_report.mr = report->mr;
+        gsm.cb.cb.sms_report.report = report;
+        gsm.cb.cb.sms_report.res = report->st < 0x20 ? gsmOK : gsmERR;
+        gsmi_send_cb(GSM_CB_SMS_REPORT);        /* Send to user */
+    }
+}
+
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
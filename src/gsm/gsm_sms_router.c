@@ -0,0 +1,292 @@
+/**
+ * \file            gsm_sms_router.c
+ * \brief           Routing of received SMS by sender number prefix
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#include "gsm/gsm_private.h"
+#include "gsm/gsm_sms.h"
+
+#if GSM_CFG_SMS_ROUTER || __DOXYGEN__
+
+/**
+ * \brief           Trie node for single digit of prefix
+ */
+typedef struct {
+    uint8_t child[10];                          /*!< Node index for every next digit, `0` when not used */
+    uint8_t route;                              /*!< Route index plus `1` or `0` when no route ends here */
+    uint8_t used;                               /*!< Flag indicating node is used */
+} gsm_sms_router_node_t;
+
+/**
+ * \brief           Route handler
+ */
+typedef struct {
+    gsm_sms_route_fn fn;                        /*!< Handler function or `NULL` to drop messages */
+    void* arg;                                  /*!< User argument */
+    uint8_t used;                               /*!< Flag indicating route is used */
+} gsm_sms_router_route_t;
+
+static gsm_sms_router_node_t router_nodes[GSM_CFG_SMS_ROUTER_NODES] = { { { 0 }, 0, 1 } }; /*!< Trie nodes, first is root */
+static gsm_sms_router_route_t router_routes[GSM_CFG_SMS_ROUTER_ROUTES];  /*!< Routes */
+
+/**
+ * \brief           Skip international prefix of number
+ * \param[in]       num: Phone number, `+` or `00` prefix is optional
+ * \return          Pointer to first digit of country code
+ */
+static const char*
+router_num_start(const char* num) {
+    if (*num == '+') {
+        num++;
+    } else if (num[0] == '0' && num[1] == '0') {
+        num += 2;
+    }
+    return num;
+}
+
+/**
+ * \brief           Get next digit of normalised number
+ * \param[in,out]   num: Pointer to pointer to number, moved after returned digit
+ * \return          Digit from `0` to `9` or `-1` at the end or on non-digit character
+ */
+static int8_t
+router_num_digit(const char** num) {
+    while (**num == ' ' || **num == '-' || **num == '(' || **num == ')') {
+        (*num)++;                               /* Ignore formatting characters */
+    }
+    if (GSM_CHARISNUM(**num)) {
+        return (int8_t)GSM_CHARTONUM(*(*num)++);
+    }
+    return -1;
+}
+
+/**
+ * \brief           Check if prefix is valid
+ * \param[in]       prefix: Prefix to check
+ * \return          `1` if all characters are digits or formatting characters, `0` otherwise
+ */
+static uint8_t
+router_prefix_valid(const char* prefix) {
+    prefix = router_num_start(prefix);
+    while (router_num_digit(&prefix) >= 0) {}
+    return *prefix == '\0';
+}
+
+/**
+ * \brief           Find node of prefix
+ * \param[in]       prefix: Prefix
+ * \param[out]      path: Node indexes on the path, root excluded. Set to `NULL` if not used
+ * \param[out]      depth: Number of nodes on the path. Set to `NULL` if not used
+ * \return          Node index, `0` for empty prefix or \ref GSM_CFG_SMS_ROUTER_NODES if prefix has no node
+ */
+static size_t
+router_find(const char* prefix, uint8_t* path, size_t* depth) {
+    size_t n = 0, d = 0;
+    int8_t digit;
+
+    prefix = router_num_start(prefix);
+    while ((digit = router_num_digit(&prefix)) >= 0) {
+        if ((n = router_nodes[n].child[digit]) == 0) {
+            return GSM_CFG_SMS_ROUTER_NODES;
+        }
+        if (path != NULL) {
+            path[d] = (uint8_t)n;
+        }
+        d++;
+    }
+    if (depth != NULL) {
+        *depth = d;
+    }
+    return n;
+}
+
+/**
+ * \brief           Allocate new trie node
+ * \note            Caller must check that free node exists
+ * \return          Node index
+ */
+static size_t
+router_node_alloc(void) {
+    size_t i = 1;
+
+    while (router_nodes[i].used) {
+        i++;
+    }
+    memset(&router_nodes[i], 0x00, sizeof(router_nodes[i]));
+    router_nodes[i].used = 1;
+    return i;
+}
+
+/**
+ * \brief           Add route for sender number prefix
+ *
+ *                  Message is dispatched to route with the longest matching prefix.
+ *                  Empty prefix adds default route for all messages, including alphanumeric senders
+ *
+ * \param[in]       prefix: Number prefix in international format, for example `+386` or `386`.
+ *                      Existing route of the same prefix is replaced
+ * \param[in]       fn: Handler function or `NULL` to drop matching messages
+ * \param[in]       arg: User argument for handler
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sms_router_add(const char* prefix, gsm_sms_route_fn fn, void* arg) {
+    const char* p;
+    size_t n = 0, i, r, missing = 0, free_nodes = 0;
+    int8_t digit;
+    gsmr_t res = gsmOK;
+
+    GSM_ASSERT("prefix != NULL && prefix is number", prefix != NULL && router_prefix_valid(prefix));
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+
+    /* Check memory first to not leave partial path on failure */
+    p = router_num_start(prefix);
+    while ((digit = router_num_digit(&p)) >= 0) {
+        if (!missing && router_nodes[n].child[digit] != 0) {
+            n = router_nodes[n].child[digit];
+        } else {
+            missing++;
+        }
+    }
+    for (i = 1; i < GSM_CFG_SMS_ROUTER_NODES; i++) {
+        free_nodes += !router_nodes[i].used;
+    }
+    for (r = 0; r < GSM_CFG_SMS_ROUTER_ROUTES && router_routes[r].used; r++) {}
+    if (missing > free_nodes || ((missing || router_nodes[n].route == 0) && r == GSM_CFG_SMS_ROUTER_ROUTES)) {
+        res = gsmERRMEM;
+    } else {
+        n = 0;
+        p = router_num_start(prefix);
+        while ((digit = router_num_digit(&p)) >= 0) {
+            if (router_nodes[n].child[digit] == 0) {
+                router_nodes[n].child[digit] = (uint8_t)router_node_alloc();
+            }
+            n = router_nodes[n].child[digit];
+        }
+        if (router_nodes[n].route == 0) {       /* New route */
+            router_routes[r].used = 1;
+            router_nodes[n].route = (uint8_t)(r + 1);
+        }
+        router_routes[router_nodes[n].route - 1].fn = fn;
+        router_routes[router_nodes[n].route - 1].arg = arg;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Remove route of sender number prefix
+ * \param[in]       prefix: Number prefix used with \ref gsm_sms_router_add
+ * \return          \ref gsmOK on success, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sms_router_remove(const char* prefix) {
+    uint8_t path[GSM_CFG_SMS_ROUTER_NODES];
+    size_t n, i, depth = 0, parent;
+    gsmr_t res = gsmOK;
+
+    GSM_ASSERT("prefix != NULL && prefix is number", prefix != NULL && router_prefix_valid(prefix));
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    n = router_find(prefix, path, &depth);
+    if (n == GSM_CFG_SMS_ROUTER_NODES || router_nodes[n].route == 0) {
+        res = gsmERR;                           /* Route does not exist */
+    } else {
+        router_routes[router_nodes[n].route - 1].used = 0;
+        router_nodes[n].route = 0;
+
+        /* Release nodes not used by any other prefix, from the end of the path */
+        while (depth > 0) {
+            n = path[depth - 1];
+            if (router_nodes[n].route != 0) {
+                break;
+            }
+            for (i = 0; i < 10 && router_nodes[n].child[i] == 0; i++) {}
+            if (i < 10) {
+                break;                          /* Node is part of longer prefix */
+            }
+            router_nodes[n].used = 0;
+            parent = depth > 1 ? path[depth - 2] : 0;
+            for (i = 0; i < 10; i++) {
+                if (router_nodes[parent].child[i] == n) {
+                    router_nodes[parent].child[i] = 0;
+                }
+            }
+            depth--;
+        }
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+    return res;
+}
+
+/**
+ * \brief           Dispatch received SMS to handler of route with the longest matching sender prefix
+ *
+ *                  Messages delivered with \ref GSM_CB_SMS_RECV_DIRECT and \ref GSM_CB_SMS_RECV_BATCH
+ *                  events are dispatched by stack. Call function for messages read by application
+ *
+ * \param[in]       entry: Received SMS entry
+ * \return          \ref gsmOK when route was found, member of \ref gsmr_t enumeration otherwise
+ */
+gsmr_t
+gsm_sms_router_dispatch(const gsm_sms_entry_t* entry) {
+    gsm_sms_route_fn fn = NULL;
+    void* arg = NULL;
+    const char* p;
+    size_t n = 0, route;
+    int8_t digit;
+
+    GSM_ASSERT("entry != NULL", entry != NULL);
+
+    GSM_CORE_PROTECT();                         /* Protect core */
+    route = router_nodes[0].route;              /* Default route */
+    p = router_num_start(entry->number);
+    while ((digit = router_num_digit(&p)) >= 0 && (n = router_nodes[n].child[digit]) != 0) {
+        if (router_nodes[n].route != 0) {
+            route = router_nodes[n].route;      /* Longer prefix matches */
+        }
+    }
+    if (route != 0) {
+        fn = router_routes[route - 1].fn;
+        arg = router_routes[route - 1].arg;
+    }
+    GSM_CORE_UNPROTECT();                       /* Unprotect core */
+
+    if (route == 0) {
+        return gsmERR;                          /* No route for sender */
+    }
+    if (fn != NULL) {
+        fn(entry, arg);
+    }
+    return gsmOK;
+}
+
+#endif /* GSM_CFG_SMS_ROUTER || __DOXYGEN__ */
@@ -72,6 +72,9 @@ gsm_thread_producer(void* const arg) {
             GSM_CORE_UNPROTECT();               /* Release protection, think if this is necessary, probably shouldn't be here */
             gsm_sys_sem_wait(&e->sem_sync, 0000);	/* Lock semaphore, should be unlocked before! */
             GSM_CORE_PROTECT();                 /* Protect system again, think if this is necessary, probably shouldn't be here */
+            if (msg->steps != NULL) {           /* Does message use steps table? */
+                msg->cmd = gsmi_cmd_steps_next(msg, 1); /* Start with first step not yet satisfied by device state */
+            }
             res = msg->fn(msg);                 /* Process this message, check if command started at least */
             if (res == gsmOK) {                 /* We have valid data and data were sent */
                 GSM_CORE_UNPROTECT();           /* Release protection */
@@ -82,12 +85,24 @@ gsm_thread_producer(void* const arg) {
                     res = gsmTIMEOUT;           /* Timeout on command */
                 }
             } else {
+                msg->res = res;                 /* Command was not started, report its error */
                 gsm_sys_sem_release(&e->sem_sync);  /* We failed, release semaphore automatically */
             }
         } else {
             res = gsmERR;                       /* Simply set error message */
         }
         
+#if GSM_CFG_SMS_OUTBOX
+        if (CMD_IS_DEF(GSM_CMD_CMGS) && msg->msg.sms_send.outbox_id) {
+            gsmi_sms_outbox_result(msg->msg.sms_send.outbox_id, res == gsmOK ? msg->res : res, msg->msg.sms_send.cms_err);
+        }
+#endif /* GSM_CFG_SMS_OUTBOX */
+#if GSM_CFG_SMS_DRAIN
+        if (CMD_IS_DEF(GSM_CMD_CMGL) && msg->msg.sms_list.drain) {
+            gsmi_sms_drain_finish(msg->msg.sms_list.mem);   /* Also when list did not finish */
+        }
+#endif /* GSM_CFG_SMS_DRAIN */
+
         /*
          * In case message is blocking,
          * release semaphore and notify finished with processing
@@ -139,3 +154,30 @@ gsm_thread_process(void* const arg) {
 #endif /* !GSM_CFG_INPUT_USE_PROCESS */
     }
 }
+
+#if (GSM_CFG_EVT_QUEUE && GSM_CFG_EVT_QUEUE_THREAD) || __DOXYGEN__
+
+/**
+ * \brief           Thread for delivering deferred events to user
+ *
+ *                  User callback functions are called from this thread
+ *                  without core protection, so they cannot block AT port processing
+ *
+ * \sa              GSM_CFG_EVT_QUEUE
+ */
+void
+gsm_thread_evt(void* const arg) {
+    void* rec;
+    uint32_t time;
+
+    GSM_UNUSED(arg);                            /* Unused variable */
+    while (1) {
+        time = gsm_sys_mbox_get(&gsm.mbox_evt, &rec, 0);    /* Wait for next event */
+        if (time == GSM_SYS_TIMEOUT || rec == NULL) {
+            continue;
+        }
+        gsmi_evt_queue_dispatch(rec);           /* Deliver event to user */
+    }
+}
+
+#endif /* (GSM_CFG_EVT_QUEUE && GSM_CFG_EVT_QUEUE_THREAD) || __DOXYGEN__ */
@@ -58,6 +58,8 @@ gsmr_t      gsm_core_unlock(void);
 
 gsmr_t      gsm_cb_register(gsm_cb_fn cb_fn);
 gsmr_t      gsm_cb_unregister(gsm_cb_fn cb_fn);
+gsmr_t      gsm_cb_register_type(gsm_cb_type_t type, gsm_cb_fn cb_fn);
+gsmr_t      gsm_cb_unregister_type(gsm_cb_type_t type, gsm_cb_fn cb_fn);
 
 gsmr_t      gsm_device_set_present(uint8_t present, uint32_t blocking);
 uint8_t     gsm_device_is_present(void);
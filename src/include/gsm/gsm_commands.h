@@ -0,0 +1,272 @@
+/**
+ * \file            gsm_commands.h
+ * \brief           List of AT commands
+ */
+
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+
+/*
+ * This file is included multiple times to generate
+ * command enumeration, command table and debug names from single source.
+ *
+ * GSM_CMD_DEF(name, str)
+ *  Command sent as "AT" + str + CRLF. Set str to "" for commands
+ *  which are not sent directly, such as top commands for sequences
+ *
+ * GSM_CMD_DEF_ENC(name, str, enc)
+ *  Command sent as "AT" + str + arguments + CRLF,
+ *  where arguments are written by command encoder function "enc"
+ */
+
+#ifndef GSM_CMD_DEF_ENC
+#define GSM_CMD_DEF_ENC(name, str, enc)         GSM_CMD_DEF(name, str)
+#endif
+
+GSM_CMD_DEF(IDLE, "")                           /* IDLE mode */
+
+/*
+ * Basic AT commands
+ */
+GSM_CMD_DEF(RESET, "+CFUN=1,1")                 /* Reset device */
+GSM_CMD_DEF(RESET_DEVICE_FIRST_CMD, "")         /* Reset device first driver specific command */
+GSM_CMD_DEF(ATE0, "E0")                         /* Disable ECHO mode on AT commands */
+GSM_CMD_DEF(ATE1, "E1")                         /* Enable ECHO mode on AT commands */
+GSM_CMD_DEF(GSLP, "")                           /* Set GSM to sleep mode */
+GSM_CMD_DEF(RESTORE, "")                        /* Restore GSM internal settings to default values */
+GSM_CMD_DEF(UART, "")
+
+#if GSM_CFG_NETWORK
+GSM_CMD_DEF(CGACT_SET_0, "")
+GSM_CMD_DEF(CGACT_SET_1, "")
+GSM_CMD_DEF(CGATT_SET_0, "")
+GSM_CMD_DEF(CGATT_SET_1, "")
+GSM_CMD_DEF(NETWORK_ATTACH, "")                 /* Attach to a network */
+GSM_CMD_DEF(NETWORK_DETACH, "")                 /* Detach from network */
+#endif /* GSM_CFG_NETWORK */
+
+/*
+ * AT commands according to the V.25TER
+ */
+GSM_CMD_DEF(A, "")                              /* Re-issues the Last Command Given */
+GSM_CMD_DEF(ATA, "A")                           /* Answer an Incoming Call */
+#if GSM_CFG_CALL
+GSM_CMD_DEF_ENC(ATD, "D", atd)                  /* Mobile Originated Call to Dial A Number */
+#else
+GSM_CMD_DEF(ATD, "")                            /* Mobile Originated Call to Dial A Number */
+#endif /* GSM_CFG_CALL */
+GSM_CMD_DEF(ATD_N, "")                          /* Originate Call to Phone Number in Current Memory: ATD<n> */
+GSM_CMD_DEF(ATD_STR, "")                        /* Originate Call to Phone Number in Memory Which Corresponds to Field "str": ATD>str */
+GSM_CMD_DEF(ATDL, "")                           /* Redial Last Telephone Number Used */
+GSM_CMD_DEF(ATE, "")                            /* Set Command Echo Mode */
+GSM_CMD_DEF(ATH, "H")                           /* Disconnect Existing */
+GSM_CMD_DEF(ATI, "")                            /* Display Product Identification Information */
+GSM_CMD_DEF(ATL, "")                            /* Set Monitor speaker */
+GSM_CMD_DEF(ATM, "")                            /* Set Monitor Speaker Mode */
+GSM_CMD_DEF(PPP, "")                            /* Switch from Data Mode or PPP Online Mode to Command Mode, "+++" originally */
+GSM_CMD_DEF(ATO, "")                            /* Switch from Command Mode to Data Mode */
+GSM_CMD_DEF(ATP, "")                            /* Select Pulse Dialing */
+GSM_CMD_DEF(ATQ, "")                            /* Set Result Code Presentation Mode */
+GSM_CMD_DEF(ATS0, "")                           /* Set Number of Rings before Automatically Answering the Call */
+GSM_CMD_DEF(ATS3, "")                           /* Set Command Line Termination Character */
+GSM_CMD_DEF(ATS4, "")                           /* Set Response Formatting Character */
+GSM_CMD_DEF(ATS5, "")                           /* Set Command Line Editing Character */
+GSM_CMD_DEF(ATS6, "")                           /* Pause Before Blind */
+GSM_CMD_DEF(ATS7, "")                           /* Set Number of Seconds to Wait for Connection Completion */
+GSM_CMD_DEF(ATS8, "")                           /* Set Number of Seconds to Wait for Comma Dial Modifier Encountered in Dial String of D Command */
+GSM_CMD_DEF(ATS10, "")                          /* Set Disconnect Delay after Indicating the Absence of Data Carrier */
+GSM_CMD_DEF(ATT, "")                            /* Select Tone Dialing */
+GSM_CMD_DEF(ATV, "")                            /* TA Response Format */
+GSM_CMD_DEF(ATX, "")                            /* Set CONNECT Result Code Format and Monitor Call Progress */
+GSM_CMD_DEF(ATZ, "")                            /* Reset Default Configuration */
+GSM_CMD_DEF(AT_C, "")                           /* Set DCD Function Mode, AT&C */
+GSM_CMD_DEF(AT_D, "")                           /* Set DTR Function, AT&D */
+GSM_CMD_DEF(AT_F, "")                           /* Factory Defined Configuration, AT&F */
+GSM_CMD_DEF(AT_V, "")                           /* Display Current Configuration, AT&V */
+GSM_CMD_DEF(AT_W, "")                           /* Store Active Profile, AT&W */
+GSM_CMD_DEF(GCAP, "")                           /* Request Complete TA Capabilities List */
+GSM_CMD_DEF(GMI, "")                            /* Request Manufacturer Identification */
+GSM_CMD_DEF(GMM, "")                            /* Request TA Model Identification */
+GSM_CMD_DEF(GMR, "")                            /* Request TA Revision Identification of Software Release */
+GSM_CMD_DEF(GOI, "")                            /* Request Global Object Identification */
+GSM_CMD_DEF(GSN, "")                            /* Request TA Serial Number Identification (IMEI) */
+GSM_CMD_DEF(ICF, "")                            /* Set TE-TA Control Character Framing */
+GSM_CMD_DEF(IFC, "")                            /* Set TE-TA Local Data Flow Control */
+GSM_CMD_DEF(IPR, "")                            /* Set TE-TA Fixed Local Rate */
+GSM_CMD_DEF(HVOIC, "")                          /* Disconnect Voice Call Only */
+
+/*
+ * AT commands according to 3GPP TS 27.007
+ */
+GSM_CMD_DEF_ENC(COPS_SET, "+COPS=", cops_set)   /* Set operator */
+GSM_CMD_DEF(COPS_GET, "+COPS?")                 /* Get current operator */
+GSM_CMD_DEF(COPS_GET_OPT, "+COPS=?")            /* Get a list of available operators */
+#if GSM_CFG_OPERATOR_CACHE
+GSM_CMD_DEF_ENC(COPN, "+COPN", copn)            /* Read Operator Names */
+#endif /* GSM_CFG_OPERATOR_CACHE */
+GSM_CMD_DEF(CPAS, "")                           /* Phone Activity Status */
+GSM_CMD_DEF(CGMI_GET, "+CGMI")                  /* Request Manufacturer Identification */
+GSM_CMD_DEF(CGMM_GET, "+CGMM")                  /* Request Model Identification */
+GSM_CMD_DEF(CGMR_GET, "")                       /* Request TA Revision Identification of Software Release */
+GSM_CMD_DEF(CGSN_GET, "+CGSN")                  /* Request Product Serial Number Identification (Identical with +GSN) */
+
+GSM_CMD_DEF(CLCC, "+CLCC=1")                    /* List Current Calls of ME */
+GSM_CMD_DEF(CLCK, "")                           /* Facility Lock */
+
+GSM_CMD_DEF(CACM, "")                           /* Accumulated Call Meter (ACM) Reset or Query */
+GSM_CMD_DEF(CAMM, "")                           /* Accumulated Call Meter Maximum (ACM max) Set or Query */
+GSM_CMD_DEF(CAOC, "")                           /* Advice of Charge */
+GSM_CMD_DEF(CBST, "")                           /* Select Bearer Service Type */
+GSM_CMD_DEF(CCFC, "")                           /* Call Forwarding Number and Conditions Control */
+GSM_CMD_DEF(CCWA, "")                           /* Call Waiting Control */
+GSM_CMD_DEF(CEER, "")                           /* Extended Error Report  */
+GSM_CMD_DEF(CSCS, "")                           /* Select TE Character Set */
+GSM_CMD_DEF(CSTA, "")                           /* Select Type of Address */
+GSM_CMD_DEF(CHLD, "")                           /* Call Hold and Multiparty */
+GSM_CMD_DEF(CIMI, "")                           /* Request International Mobile Subscriber Identity */
+GSM_CMD_DEF(CLIP, "")                           /* Calling Line Identification Presentation */
+GSM_CMD_DEF(CLIR, "")                           /* Calling Line Identification Restriction */
+GSM_CMD_DEF(CMEE, "+CMEE=1")                    /* Report Mobile Equipment Error */
+GSM_CMD_DEF(COLP, "")                           /* Connected Line Identification Presentation */
+#if GSM_CFG_PHONEBOOK
+GSM_CMD_DEF(PHONEBOOK_ENABLE, "")               /* Top command to enable phonebook */
+GSM_CMD_DEF(PHONEBOOK_SYNC, "")                 /* Top command to synchronize phonebook with target entries */
+GSM_CMD_DEF_ENC(CPBF, "+CPBF=", cpbf)           /* Find Phonebook Entries */
+GSM_CMD_DEF_ENC(CPBR, "+CPBR=", cpbr)           /* Read Current Phonebook Entries  */
+GSM_CMD_DEF_ENC(CPBS_SET, "+CPBS=", cpbs_set)   /* Select Phonebook Memory Storage */
+GSM_CMD_DEF(CPBS_GET, "+CPBS?")                 /* Get current Phonebook Memory Storage */
+GSM_CMD_DEF(CPBS_GET_OPT, "+CPBS=?")            /* Get available Phonebook Memory Storages */
+GSM_CMD_DEF_ENC(CPBW_SET, "+CPBW=", cpbw_set)   /* Write Phonebook Entry */
+GSM_CMD_DEF(CPBW_GET_OPT, "")                   /* Get options for write Phonebook Entry */
+#endif /* GSM_CFG_PHONEBOOK */
+GSM_CMD_DEF(SIM_PROCESS_BASIC_CMDS, "")         /* Command setup, executed when SIM is in READY state */
+GSM_CMD_DEF_ENC(CPIN_SET, "+CPIN=", cpin_set)   /* Enter PIN */
+GSM_CMD_DEF(CPIN_GET, "+CPIN?")                 /* Read current SIM status */
+GSM_CMD_DEF_ENC(CPIN_ADD, "+CLCK=\"SC\",1,", cpin_add) /* Add new PIN to SIM if pin is not set */
+GSM_CMD_DEF_ENC(CPIN_CHANGE, "+CPWD=\"SC\"", cpin_change) /* Change already active SIM */
+GSM_CMD_DEF_ENC(CPIN_REMOVE, "+CLCK=\"SC\",0,", cpin_remove) /* Remove current PIN */
+GSM_CMD_DEF_ENC(CPUK_SET, "+CPIN=", cpuk_set)   /* Enter PUK and set new PIN */
+
+GSM_CMD_DEF(CSQ_GET, "+CSQ")                    /* Signal Quality Report */
+GSM_CMD_DEF_ENC(CFUN_SET, "+CFUN=", cfun_set)   /* Set Phone Functionality */
+GSM_CMD_DEF(CFUN_GET, "")                       /* Get Phone Functionality */
+#if GSM_CFG_NETWORK_REG
+GSM_CMD_DEF(CREG_SET, "+CREG=2")                /* Network Registration set output with location info */
+GSM_CMD_DEF(CGREG_SET, "+CGREG=2")              /* GPRS Network Registration set output with location info */
+GSM_CMD_DEF(CEREG_SET, "+CEREG=2")              /* EPS Network Registration set output with location info */
+#else /* GSM_CFG_NETWORK_REG */
+GSM_CMD_DEF(CREG_SET, "+CREG=1")                /* Network Registration set output */
+#endif /* !GSM_CFG_NETWORK_REG */
+GSM_CMD_DEF(CREG_GET, "+CREG?")                 /* Get current network registration status */
+GSM_CMD_DEF(CBC, "")                            /* Battery Charge */
+GSM_CMD_DEF(CNUM, "+CNUM")                      /* Subscriber Number */
+
+GSM_CMD_DEF(CPWD, "")                           /* Change Password */
+GSM_CMD_DEF(CR, "")                             /* Service Reporting Control */
+GSM_CMD_DEF(CRC, "")                            /* Set Cellular Result Codes for Incoming Call Indication */
+GSM_CMD_DEF(CRLP, "")                           /* Select Radio Link Protocol Parameters  */
+GSM_CMD_DEF(CRSM, "")                           /* Restricted SIM Access */
+GSM_CMD_DEF(VTD, "")                            /* Tone Duration */
+GSM_CMD_DEF(VTS, "")                            /* DTMF and Tone Generation */
+GSM_CMD_DEF(CMUX, "")                           /* Multiplexer Control */
+GSM_CMD_DEF(CPOL, "")                           /* Preferred Operator List */
+GSM_CMD_DEF(CCLK, "")                           /* Clock */
+GSM_CMD_DEF(CSIM, "")                           /* Generic SIM Access */
+GSM_CMD_DEF(CALM, "")                           /* Alert Sound Mode */
+GSM_CMD_DEF(CALS, "")                           /* Alert Sound Select */
+GSM_CMD_DEF(CRSL, "")                           /* Ringer Sound Level */
+GSM_CMD_DEF(CLVL, "")                           /* Loud Speaker Volume Level */
+GSM_CMD_DEF(CMUT, "")                           /* Mute Control */
+GSM_CMD_DEF(CPUC, "")                           /* Price Per Unit and Currency Table */
+GSM_CMD_DEF(CCWE, "")                           /* Call Meter Maximum Event */
+GSM_CMD_DEF(CUSD, "")                           /* Unstructured Supplementary Service Data108 */
+GSM_CMD_DEF(CSSN, "")                           /* Supplementary Services Notification 109 */
+#if GSM_CFG_CONN
+GSM_CMD_DEF(CIPMUX, "+CIPMUX=1")                /* Start Up Multi-IP Connection */
+GSM_CMD_DEF(CIPSTART, "")                       /* Start Up TCP or UDP Connection */
+GSM_CMD_DEF(CIPSEND, "")                        /* Send Data Through TCP or UDP Connection */
+GSM_CMD_DEF(CIPQSEND, "")                       /* Select Data Transmitting Mode */
+GSM_CMD_DEF(CIPACK, "")                         /* Query Previous Connection Data Transmitting State */
+GSM_CMD_DEF(CIPCLOSE, "")                       /* Close TCP or UDP Connection */
+GSM_CMD_DEF(CIPSHUT, "+CIPSHUT")                /* Deactivate GPRS PDP Context */
+GSM_CMD_DEF(CLPORT, "")                         /* Set Local Port */
+GSM_CMD_DEF(CSTT, "")                           /* Start Task and Set APN, username, password */
+GSM_CMD_DEF(CIICR, "")                          /* Bring Up Wireless Connection with GPRS or CSD */
+GSM_CMD_DEF(CIFSR, "")                          /* Get Local IP Address */
+GSM_CMD_DEF(CIPSTATUS, "")                      /* Query Current Connection Status */
+GSM_CMD_DEF(CDNSCFG, "")                        /* Configure Domain Name Server */
+GSM_CMD_DEF(CDNSGIP, "")                        /* Query the IP Address of Given Domain Name */
+GSM_CMD_DEF(CIPHEAD, "+CIPHEAD=1")              /* Add an IP Head at the Beginning of a Package Received */
+GSM_CMD_DEF(CIPATS, "")                         /* Set Auto Sending Timer */
+GSM_CMD_DEF(CIPSPRT, "")                        /* Set Prompt of '>' When Module Sends Data */
+GSM_CMD_DEF(CIPSERVER, "")                      /* Configure Module as Server */
+GSM_CMD_DEF(CIPCSGP, "")                        /* Set CSD or GPRS for Connection Mode */
+GSM_CMD_DEF(CIPSRIP, "+CIPSRIP=1")              /* Show Remote IP Address and Port When Received Data */
+GSM_CMD_DEF(CIPDPDP, "")                        /* Set Whether to Check State of GPRS Network Timing */
+GSM_CMD_DEF(CIPMODE, "")                        /* Select TCPIP Application Mode */
+GSM_CMD_DEF(CIPCCFG, "")                        /* Configure Transparent Transfer Mode */
+GSM_CMD_DEF(CIPSHOWTP, "")                      /* Display Transfer Protocol in IP Head When Received Data */
+GSM_CMD_DEF(CIPUDPMODE, "")                     /* UDP Extended Mode */
+GSM_CMD_DEF(CIPRXGET, "")                       /* Get Data from Network Manually */
+GSM_CMD_DEF(CIPSCONT, "")                       /* Save TCPIP Application Context */
+GSM_CMD_DEF(CIPRDTIMER, "")                     /* Set Remote Delay Timer */
+GSM_CMD_DEF(CIPSGTXT, "")                       /* Select GPRS PDP context */
+GSM_CMD_DEF(CIPTKA, "")                         /* Set TCP Keepalive Parameters */
+#endif /* GSM_CFG_CONN */
+#if GSM_CFG_CALL
+GSM_CMD_DEF(CALL_ENABLE, "")                    /* Top command to enable call */
+#endif /* GSM_CFG_CALL */
+#if GSM_CFG_SMS
+GSM_CMD_DEF(SMS_ENABLE, "")                     /* Top command to enable SMS */
+GSM_CMD_DEF_ENC(CMGD, "+CMGD=", cmgd)           /* Delete SMS Message */
+GSM_CMD_DEF_ENC(CMGDA, "+CMGDA=", cmgda)        /* Delete All SMS Messages of Type, device specific */
+GSM_CMD_DEF_ENC(CMGF, "+CMGF=", cmgf)           /* Select SMS Message Format */
+GSM_CMD_DEF_ENC(CMGL, "+CMGL=", cmgl)           /* List SMS Messages from Preferred Store */
+GSM_CMD_DEF_ENC(CMGR, "+CMGR=", cmgr)           /* Read SMS Message */
+GSM_CMD_DEF_ENC(CMGS, "+CMGS=", cmgs)           /* Send SMS Message */
+GSM_CMD_DEF(CMGW, "")                           /* Write SMS Message to Memory */
+GSM_CMD_DEF_ENC(CMMS_SET, "+CMMS=", cmms_set)   /* More Messages to Send */
+GSM_CMD_DEF(CMSS, "")                           /* Send SMS Message from Storage */
+GSM_CMD_DEF_ENC(CNMI, "+CNMI=", cnmi)           /* New SMS Message Indications */
+GSM_CMD_DEF_ENC(CPMS_SET, "+CPMS=", cpms_set)   /* Set preferred SMS Message Storage */
+GSM_CMD_DEF(CPMS_GET, "+CPMS?")                 /* Get preferred SMS Message Storage */
+GSM_CMD_DEF(CPMS_GET_OPT, "+CPMS=?")            /* Get optional SMS message storages */
+GSM_CMD_DEF(CRES, "")                           /* Restore SMS Settings */
+GSM_CMD_DEF(CSAS, "")                           /* Save SMS Settings */
+GSM_CMD_DEF(CSCA, "")                           /* SMS Service Center Address */
+GSM_CMD_DEF(CSCB, "")                           /* Select Cell Broadcast SMS Messages */
+GSM_CMD_DEF(CSDH, "")                           /* Show SMS Text Mode Parameters */
+GSM_CMD_DEF(CSMP_GET, "+CSMP?")                 /* Get SMS Text Mode Parameters */
+GSM_CMD_DEF_ENC(CSMP, "+CSMP=", csmp)           /* Set SMS Text Mode Parameters */
+GSM_CMD_DEF(CSMS_SET_1, "+CSMS=1")              /* Select Message Service with acknowledgement of new messages */
+#endif /* GSM_CFG_SMS */
+
+
+
+#undef GSM_CMD_DEF
+#undef GSM_CMD_DEF_ENC
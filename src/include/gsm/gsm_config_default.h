@@ -142,6 +142,17 @@
 #define GSM_CFG_RCV_BUFF_SIZE               0x400
 #endif
 
+/**
+ * \brief           Size of staging buffer for AT commands sent to device
+ *
+ *                  Complete command is first assembled in this buffer
+ *                  and then sent with single call to low-level send function.
+ *                  Commands longer than buffer are sent in multiple chunks
+ */
+#ifndef GSM_CFG_AT_PORT_TX_BUFF_SIZE
+#define GSM_CFG_AT_PORT_TX_BUFF_SIZE        256
+#endif
+
 /**
  * \brief           Enables (`1`) or disables (`0`) reset sequence after \ref gsm_init call
  *
@@ -328,6 +339,50 @@
 #ifndef GSM_CFG_INPUT_USE_PROCESS
 #define GSM_CFG_INPUT_USE_PROCESS           0
 #endif
+
+/**
+ * \brief           Enables (`1`) or disables (`0`) deferred event delivery
+ *
+ *                  When enabled, events are copied to records of internal queue
+ *                  and user callback functions are called later, without core protection,
+ *                  from separate thread or from \ref gsm_evt_queue_process function.
+ *                  Long callback functions do not block processing of AT port anymore.
+ *
+ * \note            Device identification and connection events are always delivered immediately
+ */
+#ifndef GSM_CFG_EVT_QUEUE
+#define GSM_CFG_EVT_QUEUE                   0
+#endif
+
+/**
+ * \brief           Number of event records in deferred queue
+ *
+ *                  When all records are in use, new events are dropped
+ *                  and counted in \ref gsm_evt_queue_stats_t statistics
+ */
+#ifndef GSM_CFG_EVT_QUEUE_SIZE
+#define GSM_CFG_EVT_QUEUE_SIZE              16
+#endif
+
+/**
+ * \brief           Enables (`1`) or disables (`0`) dedicated thread for deferred events
+ *
+ *                  When disabled, user must periodically call \ref gsm_evt_queue_process
+ *                  to deliver events from application thread
+ */
+#ifndef GSM_CFG_EVT_QUEUE_THREAD
+#define GSM_CFG_EVT_QUEUE_THREAD            1
+#endif
+
+/**
+ * \brief           Number of callback functions for single deferred event kept on stack
+ *
+ *                  When more callback functions are registered,
+ *                  memory for snapshot of listeners is allocated for every delivered event
+ */
+#ifndef GSM_CFG_EVT_QUEUE_LISTENERS
+#define GSM_CFG_EVT_QUEUE_LISTENERS         8
+#endif
  
 /**
  * \}
@@ -352,6 +407,310 @@
 #ifndef GSM_CFG_SMS
 #define GSM_CFG_SMS                         0
 #endif
+
+/**
+ * \brief           Enables (1) or disables (0) PDU mode for SMS
+ *
+ *                  When enabled, messages are sent, read and listed in PDU mode.
+ *                  Text is sent with GSM 7-bit alphabet when possible or as UCS2 otherwise
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_PDU
+#define GSM_CFG_SMS_PDU                     0
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) reassembly of received concatenated SMS
+ *
+ *                  Parts of concatenated message, received with direct delivery
+ *                  or listed in drain mode, are collected and \ref GSM_CB_SMS_CONCAT event
+ *                  is sent when all parts are received. Read and list operations
+ *                  of application do not assemble messages
+ *
+ * \note            \ref GSM_CFG_SMS_PDU must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_CONCAT
+#define GSM_CFG_SMS_CONCAT                  0
+#endif
+
+/**
+ * \brief           Maximal number of concatenated messages assembled at the same time
+ *
+ *                  When all slots are in use, the oldest incomplete message is dropped
+ */
+#ifndef GSM_CFG_SMS_CONCAT_SETS
+#define GSM_CFG_SMS_CONCAT_SETS             2
+#endif
+
+/**
+ * \brief           Maximal number of parts of single concatenated message
+ *
+ *                  Messages with more parts are not assembled. Maximal value is `32`
+ */
+#ifndef GSM_CFG_SMS_CONCAT_PARTS
+#define GSM_CFG_SMS_CONCAT_PARTS            4
+#endif
+
+/**
+ * \brief           Time in units of milliseconds to wait for missing parts after last received part
+ *
+ *                  Incomplete message is dropped after timeout
+ */
+#ifndef GSM_CFG_SMS_CONCAT_TIMEOUT
+#define GSM_CFG_SMS_CONCAT_TIMEOUT          60000
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) local mirror of SMS storage
+ *
+ *                  Memory is mirrored after \ref gsm_sms_mirror_sync call and kept up to date
+ *                  with received, read and deleted messages. Read and list operations
+ *                  are answered from mirror when possible. Mirror is invalidated on device reset
+ *
+ * \note            Events of read and list operations answered from mirror
+ *                  are sent from calling thread instead of processing thread
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_MIRROR
+#define GSM_CFG_SMS_MIRROR                  0
+#endif
+
+/**
+ * \brief           Number of SMS entries kept in local mirror for all memories
+ *
+ *                  Memory with more messages than available entries is not mirrored
+ */
+#ifndef GSM_CFG_SMS_MIRROR_SIZE
+#define GSM_CFG_SMS_MIRROR_SIZE             20
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) direct delivery of received SMS
+ *
+ *                  When enabled with \ref gsm_sms_set_direct, received messages are reported
+ *                  with `+CMT` unsolicited code and \ref GSM_CB_SMS_RECV_DIRECT event
+ *                  instead of being stored to device memory
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_DIRECT
+#define GSM_CFG_SMS_DIRECT                  0
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) acknowledgement of directly delivered SMS
+ *
+ *                  When enabled, message service is set to phase 2+ with `AT+CSMS=1`
+ *                  and every received message is acknowledged with `AT+CNMA`.
+ *                  Network sends message again when it is not acknowledged in time
+ *
+ * \note            \ref GSM_CFG_SMS_DIRECT must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_DIRECT_ACK
+#define GSM_CFG_SMS_DIRECT_ACK              0
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) inbox drain mode for received SMS
+ *
+ *                  When enabled with \ref gsm_sms_set_drain, `+CMTI` notifications are collected
+ *                  until no new message is received for \ref GSM_CFG_SMS_DRAIN_DELAY milliseconds.
+ *                  Unread messages are then listed at once, reported with \ref GSM_CB_SMS_RECV_BATCH event
+ *                  and deleted from memory afterwards
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_DRAIN
+#define GSM_CFG_SMS_DRAIN                   0
+#endif
+
+/**
+ * \brief           Time in units of milliseconds without new `+CMTI` before inbox is drained
+ */
+#ifndef GSM_CFG_SMS_DRAIN_DELAY
+#define GSM_CFG_SMS_DRAIN_DELAY             1000
+#endif
+
+/**
+ * \brief           Maximal number of messages reported in single \ref GSM_CB_SMS_RECV_BATCH event
+ *
+ *                  When more messages are drained, multiple events are sent
+ */
+#ifndef GSM_CFG_SMS_DRAIN_SIZE
+#define GSM_CFG_SMS_DRAIN_SIZE              4
+#endif
+
+/**
+ * \brief           Enables (1) or disables (0) storage watermark monitor for received SMS
+ *
+ *                  Usage of memory for received messages is tracked from `+CPMS` responses,
+ *                  received and deleted messages. \ref GSM_CB_SMS_STORAGE event is sent
+ *                  when usage crosses high or low watermark. On high watermark, read messages
+ *                  are deleted from memory. When inbox drain mode is enabled, unread messages
+ *                  are drained immediately too
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_WATERMARK
+#define GSM_CFG_SMS_WATERMARK               0
+#endif
+
+/**
+ * \brief           High watermark in units of percent of memory size
+ */
+#ifndef GSM_CFG_SMS_WATERMARK_HIGH
+#define GSM_CFG_SMS_WATERMARK_HIGH          80
+#endif
+
+/**
+ * \brief           Low watermark in units of percent of memory size
+ *
+ *                  Storage is reported as normal again when usage drops to this level
+ */
+#ifndef GSM_CFG_SMS_WATERMARK_LOW
+#define GSM_CFG_SMS_WATERMARK_LOW           50
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` SMS outbox
+ *
+ *                  Messages are queued by stack, written to optional application journal
+ *                  and sent with rate limits and retries on temporary network errors
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_OUTBOX
+#define GSM_CFG_SMS_OUTBOX                  0
+#endif
+
+/**
+ * \brief           Maximal number of messages waiting in outbox
+ */
+#ifndef GSM_CFG_SMS_OUTBOX_SIZE
+#define GSM_CFG_SMS_OUTBOX_SIZE             8
+#endif
+
+/**
+ * \brief           Maximal text length of outbox message in units of bytes
+ *
+ *                  Text must still fit single SMS message
+ */
+#ifndef GSM_CFG_SMS_OUTBOX_TEXT_LEN
+#define GSM_CFG_SMS_OUTBOX_TEXT_LEN         160
+#endif
+
+/**
+ * \brief           Minimal time between 2 sent messages in units of milliseconds
+ */
+#ifndef GSM_CFG_SMS_OUTBOX_INTERVAL
+#define GSM_CFG_SMS_OUTBOX_INTERVAL         500
+#endif
+
+/**
+ * \brief           Minimal time between 2 messages sent to the same number in units of milliseconds
+ *
+ *                  Messages to other numbers are sent in the meantime
+ */
+#ifndef GSM_CFG_SMS_OUTBOX_DEST_INTERVAL
+#define GSM_CFG_SMS_OUTBOX_DEST_INTERVAL    3000
+#endif
+
+/**
+ * \brief           Maximal number of send attempts for single message
+ */
+#ifndef GSM_CFG_SMS_OUTBOX_RETRIES
+#define GSM_CFG_SMS_OUTBOX_RETRIES          3
+#endif
+
+/**
+ * \brief           Delay before first retry in units of milliseconds
+ *
+ *                  Delay is doubled for every next retry
+ */
+#ifndef GSM_CFG_SMS_OUTBOX_BACKOFF
+#define GSM_CFG_SMS_OUTBOX_BACKOFF          5000
+#endif
+
+/**
+ * \brief           Time to collect journal records before they are committed, in units of milliseconds
+ *
+ *                  Messages added within this time are committed to journal together
+ */
+#ifndef GSM_CFG_SMS_OUTBOX_COMMIT_DELAY
+#define GSM_CFG_SMS_OUTBOX_COMMIT_DELAY     10
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` SMS delivery status reports
+ *
+ *                  When enabled with \ref gsm_sms_set_report, network reports
+ *                  delivery of every sent message with `+CDS` notification
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_REPORT
+#define GSM_CFG_SMS_REPORT                  0
+#endif
+
+/**
+ * \brief           Maximal number of sent messages waiting for status report
+ *
+ *                  Oldest message is reported as expired when table is full
+ */
+#ifndef GSM_CFG_SMS_REPORT_SIZE
+#define GSM_CFG_SMS_REPORT_SIZE             16
+#endif
+
+/**
+ * \brief           Time to wait for status report in units of milliseconds
+ */
+#ifndef GSM_CFG_SMS_REPORT_TIMEOUT
+#define GSM_CFG_SMS_REPORT_TIMEOUT          86400000
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` routing of received SMS by sender number prefix
+ *
+ *                  Routes are kept in digit trie and the longest matching prefix wins,
+ *                  so lookup time depends only on number length
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_ROUTER
+#define GSM_CFG_SMS_ROUTER                  0
+#endif
+
+/**
+ * \brief           Maximal number of trie nodes, one node per prefix digit not shared with other prefix
+ *
+ * \note            Value must not be greater than `255`
+ */
+#ifndef GSM_CFG_SMS_ROUTER_NODES
+#define GSM_CFG_SMS_ROUTER_NODES            64
+#endif
+
+/**
+ * \brief           Maximal number of routes
+ */
+#ifndef GSM_CFG_SMS_ROUTER_ROUTES
+#define GSM_CFG_SMS_ROUTER_ROUTES           16
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` delivery of SMS body as slices of received data
+ *
+ *                  Body of message read with `+CMGR` or `+CMGL` is not copied to entry byte by byte.
+ *                  Every contiguous part of body in received data is passed to user
+ *                  with \ref GSM_CB_SMS_BODY event instead, as pointer and length.
+ *                  Body is copied to entry only when user requests it in event
+ *
+ * \note            \ref GSM_CFG_SMS must be enabled and \ref GSM_CFG_SMS_PDU disabled to use this feature
+ */
+#ifndef GSM_CFG_SMS_BODY_SLICE
+#define GSM_CFG_SMS_BODY_SLICE              0
+#endif
 #ifndef GSM_CFG_CALL
 #define GSM_CFG_CALL                        0
 #endif
@@ -368,6 +727,139 @@
 #define GSM_CFG_PING                        0
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` local phonebook cache
+ *
+ *                  Entries of single memory are loaded once with \ref gsm_pb_cache_load
+ *                  and indexed by phone number and by name, so lookups do not need device communication.
+ *                  Cache is kept coherent with entries written with phonebook API
+ *
+ * \note            \ref GSM_CFG_PHONEBOOK must be enabled to use this feature
+ */
+#ifndef GSM_CFG_PB_CACHE
+#define GSM_CFG_PB_CACHE                    0
+#endif
+
+/**
+ * \brief           Maximal number of cached phonebook entries
+ *
+ * \note            Value must not be greater than `65535`
+ */
+#ifndef GSM_CFG_PB_CACHE_SIZE
+#define GSM_CFG_PB_CACHE_SIZE               100
+#endif
+
+/**
+ * \brief           Number of entries read with single `+CPBR` command when cache is loaded
+ */
+#ifndef GSM_CFG_PB_CACHE_CHUNK
+#define GSM_CFG_PB_CACHE_CHUNK              10
+#endif
+
+/**
+ * \brief           Number of last digits used to compare phone numbers in cache
+ *
+ *                  Number in national and international format matches,
+ *                  for example `+38640123456` and `040123456`
+ */
+#ifndef GSM_CFG_PB_CACHE_MATCH_DIGITS
+#define GSM_CFG_PB_CACHE_MATCH_DIGITS       8
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` phonebook sync with target entry set
+ *
+ *                  Memory is read once and only entries which differ from target set are written or deleted
+ *
+ * \note            \ref GSM_CFG_PHONEBOOK must be enabled to use this feature
+ */
+#ifndef GSM_CFG_PB_SYNC
+#define GSM_CFG_PB_SYNC                     0
+#endif
+
+/**
+ * \brief           Maximal number of memory positions and target entries of phonebook sync
+ */
+#ifndef GSM_CFG_PB_SYNC_SIZE
+#define GSM_CFG_PB_SYNC_SIZE                250
+#endif
+
+/**
+ * \brief           Number of positions read with single `+CPBR` command during phonebook sync
+ *
+ *                  Entries are compared while received and not stored,
+ *                  so range can be large
+ */
+#ifndef GSM_CFG_PB_SYNC_CHUNK
+#define GSM_CFG_PB_SYNC_CHUNK               50
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` operator scan cache and operator names table
+ *
+ *                  Result of last operator scan is reused for \ref GSM_CFG_OPERATOR_CACHE_TTL milliseconds.
+ *                  Names table is loaded once with \ref gsm_operator_names_load
+ *                  to resolve operator numeric codes to names without device communication
+ */
+#ifndef GSM_CFG_OPERATOR_CACHE
+#define GSM_CFG_OPERATOR_CACHE              0
+#endif
+
+/**
+ * \brief           Maximal number of operators in cached scan result
+ */
+#ifndef GSM_CFG_OPERATOR_CACHE_SIZE
+#define GSM_CFG_OPERATOR_CACHE_SIZE         10
+#endif
+
+/**
+ * \brief           Time in units of milliseconds cached scan result is valid
+ */
+#ifndef GSM_CFG_OPERATOR_CACHE_TTL
+#define GSM_CFG_OPERATOR_CACHE_TTL          300000
+#endif
+
+/**
+ * \brief           Maximal number of entries in operator names table
+ *
+ *                  Devices usually report more than `1000` operators with `+COPN`.
+ *                  Every entry uses `6` bytes of memory, name is stored in names pool
+ */
+#ifndef GSM_CFG_OPERATOR_NAMES_SIZE
+#define GSM_CFG_OPERATOR_NAMES_SIZE         1200
+#endif
+
+/**
+ * \brief           Size of buffer for operator names in units of bytes
+ *
+ * \note            Value must not be greater than `65535`
+ */
+#ifndef GSM_CFG_OPERATOR_NAMES_POOL
+#define GSM_CFG_OPERATOR_NAMES_POOL         16384
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` debounced network registration with location info
+ *
+ *                  `+CREG`, `+CGREG` and `+CEREG` are reported with location area and cell ID.
+ *                  Unsolicited reports are applied when stable for \ref GSM_CFG_NETWORK_REG_DEBOUNCE milliseconds,
+ *                  responses to `AT+CREG?` immediately. Operator is queried when device registers
+ *                  or changes between home and roaming network. Location area or cell change
+ *                  only updates registration info and sends \ref GSM_CB_NETWORK_CELL_CHANGED event
+ *
+ * \note            Devices without `+CGREG` or `+CEREG` support report only registration they support
+ */
+#ifndef GSM_CFG_NETWORK_REG
+#define GSM_CFG_NETWORK_REG                 0
+#endif
+
+/**
+ * \brief           Time in units of milliseconds registration report must be stable before it is applied
+ */
+#ifndef GSM_CFG_NETWORK_REG_DEBOUNCE
+#define GSM_CFG_NETWORK_REG_DEBOUNCE        3000
+#endif
+
 /**
  * \}
  */
@@ -395,6 +887,69 @@
     #endif /* GSM_CFG_INPUT_USE_PROCESS */
 #endif /* !GSM_CFG_OS */
 
+#if GSM_CFG_SMS_CONCAT
+    #if !GSM_CFG_SMS_PDU
+    #error "GSM_CFG_SMS_CONCAT may only be enabled when GSM_CFG_SMS_PDU is enabled!"
+    #endif /* !GSM_CFG_SMS_PDU */
+    #if GSM_CFG_SMS_CONCAT_PARTS > 32
+    #error "GSM_CFG_SMS_CONCAT_PARTS must not be greater than 32!"
+    #endif /* GSM_CFG_SMS_CONCAT_PARTS > 32 */
+#endif /* GSM_CFG_SMS_CONCAT */
+
+#if GSM_CFG_SMS_DIRECT_ACK
+    #if !GSM_CFG_SMS_DIRECT
+    #error "GSM_CFG_SMS_DIRECT_ACK may only be enabled when GSM_CFG_SMS_DIRECT is enabled!"
+    #endif /* !GSM_CFG_SMS_DIRECT */
+#endif /* GSM_CFG_SMS_DIRECT_ACK */
+
+#if GSM_CFG_SMS_WATERMARK
+    #if GSM_CFG_SMS_WATERMARK_LOW >= GSM_CFG_SMS_WATERMARK_HIGH || GSM_CFG_SMS_WATERMARK_HIGH > 100
+    #error "GSM_CFG_SMS_WATERMARK_LOW must be lower than GSM_CFG_SMS_WATERMARK_HIGH, which must not be greater than 100!"
+    #endif /* GSM_CFG_SMS_WATERMARK_LOW >= GSM_CFG_SMS_WATERMARK_HIGH || GSM_CFG_SMS_WATERMARK_HIGH > 100 */
+#endif /* GSM_CFG_SMS_WATERMARK */
+
+#if GSM_CFG_SMS_OUTBOX
+    #if GSM_CFG_SMS_OUTBOX_RETRIES < 1 || GSM_CFG_SMS_OUTBOX_RETRIES > 8
+    #error "GSM_CFG_SMS_OUTBOX_RETRIES must be between 1 and 8!"
+    #endif /* GSM_CFG_SMS_OUTBOX_RETRIES < 1 || GSM_CFG_SMS_OUTBOX_RETRIES > 8 */
+#endif /* GSM_CFG_SMS_OUTBOX */
+
+#if GSM_CFG_SMS_ROUTER
+    #if GSM_CFG_SMS_ROUTER_NODES > 255 || GSM_CFG_SMS_ROUTER_ROUTES > 255
+    #error "GSM_CFG_SMS_ROUTER_NODES and GSM_CFG_SMS_ROUTER_ROUTES must not be greater than 255!"
+    #endif /* GSM_CFG_SMS_ROUTER_NODES > 255 || GSM_CFG_SMS_ROUTER_ROUTES > 255 */
+#endif /* GSM_CFG_SMS_ROUTER */
+
+#if GSM_CFG_SMS_BODY_SLICE
+    #if GSM_CFG_SMS_PDU
+    #error "GSM_CFG_SMS_BODY_SLICE may only be enabled when GSM_CFG_SMS_PDU is disabled!"
+    #endif /* GSM_CFG_SMS_PDU */
+#endif /* GSM_CFG_SMS_BODY_SLICE */
+
+#if GSM_CFG_PB_CACHE
+    #if !GSM_CFG_PHONEBOOK
+    #error "GSM_CFG_PB_CACHE may only be enabled when GSM_CFG_PHONEBOOK is enabled!"
+    #endif /* !GSM_CFG_PHONEBOOK */
+    #if GSM_CFG_PB_CACHE_SIZE > 65535 || GSM_CFG_PB_CACHE_CHUNK < 1 || GSM_CFG_PB_CACHE_MATCH_DIGITS < 1
+    #error "GSM_CFG_PB_CACHE_SIZE must not be greater than 65535, GSM_CFG_PB_CACHE_CHUNK and GSM_CFG_PB_CACHE_MATCH_DIGITS must be at least 1!"
+    #endif /* GSM_CFG_PB_CACHE_SIZE > 65535 || GSM_CFG_PB_CACHE_CHUNK < 1 || GSM_CFG_PB_CACHE_MATCH_DIGITS < 1 */
+#endif /* GSM_CFG_PB_CACHE */
+
+#if GSM_CFG_PB_SYNC
+    #if !GSM_CFG_PHONEBOOK
+    #error "GSM_CFG_PB_SYNC may only be enabled when GSM_CFG_PHONEBOOK is enabled!"
+    #endif /* !GSM_CFG_PHONEBOOK */
+    #if GSM_CFG_PB_SYNC_CHUNK < 1
+    #error "GSM_CFG_PB_SYNC_CHUNK must be at least 1!"
+    #endif /* GSM_CFG_PB_SYNC_CHUNK < 1 */
+#endif /* GSM_CFG_PB_SYNC */
+
+#if GSM_CFG_OPERATOR_CACHE
+    #if GSM_CFG_OPERATOR_NAMES_POOL > 65535
+    #error "GSM_CFG_OPERATOR_NAMES_POOL must not be greater than 65535!"
+    #endif /* GSM_CFG_OPERATOR_NAMES_POOL > 65535 */
+#endif /* GSM_CFG_OPERATOR_CACHE */
+
 #endif /* !__DOXYGEN__ */
 
 #endif /* __GSM_DEFAULT_CONFIG_H */
@@ -48,6 +48,25 @@ extern "C" {
  */
 
 uint8_t     gsm_evt_reset_is_forced(gsm_cb_t* cb);
+
+#if GSM_CFG_EVT_QUEUE || __DOXYGEN__
+
+/**
+ * \brief           Deferred event queue statistics
+ */
+typedef struct {
+    uint32_t queued;                            /*!< Number of events put to queue */
+    uint32_t dispatched;                        /*!< Number of events delivered to user */
+    uint32_t dropped;                           /*!< Number of events dropped because queue was full */
+    size_t used;                                /*!< Number of records currently waiting in queue */
+    size_t max_used;                            /*!< Maximal number of records used at the same time */
+    uint32_t skipped;                           /*!< Number of listener calls skipped because listeners snapshot could not be allocated */
+} gsm_evt_queue_stats_t;
+
+gsmr_t      gsm_evt_queue_process(uint32_t timeout);
+gsmr_t      gsm_evt_queue_get_stats(gsm_evt_queue_stats_t* stats);
+
+#endif /* GSM_CFG_EVT_QUEUE || __DOXYGEN__ */
  
 /**
  * \}
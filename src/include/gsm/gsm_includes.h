@@ -52,6 +52,7 @@ extern "C" {
 
 #if GSM_CFG_SMS
 #include "gsm/gsm_sms.h"
+#include "gsm/gsm_sms_pdu.h"
 #endif /* GSM_CFG_SMS */
 #if GSM_CFG_CALL
 #include "gsm/gsm_call.h"
@@ -50,6 +50,10 @@ extern "C" {
 gsmr_t      gsm_network_attach(const char* apn, const char* user, const char* pass, uint32_t blocking);
 gsmr_t      gsm_network_detach(uint32_t blocking);
 
+#if GSM_CFG_NETWORK_REG || __DOXYGEN__
+gsmr_t      gsm_network_reg_get(gsm_network_reg_domain_t domain, gsm_network_reg_t* reg);
+#endif /* GSM_CFG_NETWORK_REG || __DOXYGEN__ */
+
 /**
  * \}
  */
@@ -51,6 +51,13 @@ gsmr_t      gsm_operator_get(gsm_operator_curr_t* curr, uint32_t blocking);
 gsmr_t      gsm_operator_set(gsm_operator_mode_t mode, gsm_operator_format_t format, const char* name, uint32_t num, uint32_t blocking);
 
 gsmr_t      gsm_operator_scan(gsm_operator_t* ops, size_t opsl, size_t* opf, uint32_t blocking);
+gsmr_t      gsm_operator_scan_stream(gsm_operator_t* op, gsm_operator_scan_fn fn, void* arg, size_t* opf, uint32_t blocking);
+
+#if GSM_CFG_OPERATOR_CACHE || __DOXYGEN__
+void        gsm_operator_cache_invalidate(void);
+gsmr_t      gsm_operator_names_load(uint32_t blocking);
+gsmr_t      gsm_operator_name_find(uint32_t num, char* name, size_t len);
+#endif /* GSM_CFG_OPERATOR_CACHE || __DOXYGEN__ */
 
 gsmr_t      gsm_operator_rssi(int16_t* rssi, uint32_t blocking);
 
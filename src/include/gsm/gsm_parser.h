@@ -46,17 +46,22 @@ uint8_t     gsmi_parse_mac(const char** src, gsm_mac_t* mac);
 
 uint8_t     gsmi_parse_cpin(const char* str, uint8_t send_evt);
 uint8_t     gsmi_parse_creg(const char* str, uint8_t skip_first);
+uint8_t     gsmi_parse_reg(const char* str, gsm_network_reg_domain_t domain, uint8_t skip_first);
 uint8_t     gsmi_parse_csq(const char* str);
 
 uint8_t     gsmi_parse_cmgs(const char* str, uint8_t send_evt);
 uint8_t     gsmi_parse_cmti(const char* str, uint8_t send_evt);
 uint8_t     gsmi_parse_cmgr(const char* str);
 uint8_t     gsmi_parse_cmgl(const char* str);
+uint8_t     gsmi_parse_cmt(const char* str, gsm_sms_entry_t* e);
+uint8_t     gsmi_parse_cds(const char* str, gsm_sms_report_t* r);
+uint8_t     gsmi_parse_csmp(const char* str);
 
 uint8_t     gsmi_parse_at_sdk_version(const char* str, uint32_t* version_out);
 
 uint8_t     gsmi_parse_cops_scan(uint8_t ch, uint8_t reset);
 uint8_t     gsmi_parse_cops(const char* str);
+uint8_t     gsmi_parse_copn(const char* str);
 uint8_t     gsmi_parse_clcc(const char* str, uint8_t send_evt);
 
 uint8_t     gsmi_parse_cpbs(const char* str, uint8_t opt);
@@ -55,8 +55,20 @@ gsmr_t      gsm_pb_edit(gsm_mem_t mem, size_t pos, const char* name, const char*
 gsmr_t      gsm_pb_delete(gsm_mem_t mem, size_t pos, uint32_t blocking);
 gsmr_t      gsm_pb_read(gsm_mem_t mem, size_t pos, gsm_pb_entry_t* entry, uint32_t blocking);
 gsmr_t      gsm_pb_list(gsm_mem_t mem, size_t start_index, gsm_pb_entry_t* entries, size_t etr, size_t* er, uint32_t blocking);
+gsmr_t      gsm_pb_list_stream(gsm_mem_t mem, size_t page, gsm_pb_entry_t* entry, gsm_pb_list_fn fn, void* arg, size_t* er, uint32_t blocking);
 gsmr_t      gsm_pb_search(gsm_mem_t mem, const char* search, gsm_pb_entry_t* entries, size_t etr, size_t* er, uint32_t blocking);
 
+#if GSM_CFG_PB_CACHE || __DOXYGEN__
+gsmr_t      gsm_pb_cache_load(gsm_mem_t mem, uint32_t blocking);
+uint8_t     gsm_pb_cache_is_valid(gsm_mem_t mem);
+gsmr_t      gsm_pb_cache_find_number(const char* num, gsm_pb_entry_t* entry);
+gsmr_t      gsm_pb_cache_find_name(const char* name, gsm_pb_entry_t* entries, size_t etr, size_t* er);
+#endif /* GSM_CFG_PB_CACHE || __DOXYGEN__ */
+
+#if GSM_CFG_PB_SYNC || __DOXYGEN__
+gsmr_t      gsm_pb_sync(gsm_mem_t mem, const gsm_pb_entry_t* entries, size_t len, uint32_t blocking);
+#endif /* GSM_CFG_PB_SYNC || __DOXYGEN__ */
+
 /**
  * \}
  */
@@ -50,207 +50,8 @@ extern "C" {
  * \brief           List of possible messages
  */
 typedef enum {
-    GSM_CMD_IDLE = 0,                           /*!< IDLE mode */
-
-    /*
-     * Basic AT commands
-     */
-    GSM_CMD_RESET,                              /*!< Reset device */
-    GSM_CMD_RESET_DEVICE_FIRST_CMD,             /*!< Reset device first driver specific command */
-    GSM_CMD_ATE0,                               /*!< Disable ECHO mode on AT commands */
-    GSM_CMD_ATE1,                               /*!< Enable ECHO mode on AT commands */
-    GSM_CMD_GSLP,                               /*!< Set GSM to sleep mode */
-    GSM_CMD_RESTORE,                            /*!< Restore GSM internal settings to default values */
-    GSM_CMD_UART,
-
-#if GSM_CFG_NETWORK || __DOXYGEN__
-    GSM_CMD_CGACT_SET_0,
-    GSM_CMD_CGACT_SET_1,
-    GSM_CMD_CGATT_SET_0,
-    GSM_CMD_CGATT_SET_1,
-    GSM_CMD_NETWORK_ATTACH,                     /*!< Attach to a network */
-    GSM_CMD_NETWORK_DETACH,                     /*!< Detach from network */
-#endif /* GSM_CFG_NETWORK */
-
-    /*
-     * AT commands according to the V.25TER
-     */
-    GSM_CMD_A,                                  /*!< Re-issues the Last Command Given */
-    GSM_CMD_ATA,                                /*!< Answer an Incoming Call */
-    GSM_CMD_ATD,                                /*!< Mobile Originated Call to Dial A Number */
-    GSM_CMD_ATD_N,                              /*!< Originate Call to Phone Number in Current Memory: ATD<n> */
-    GSM_CMD_ATD_STR,                            /*!< Originate Call to Phone Number in Memory Which Corresponds to Field "str": ATD>str */
-    GSM_CMD_ATDL,                               /*!< Redial Last Telephone Number Used */
-    GSM_CMD_ATE,                                /*!< Set Command Echo Mode */
-    GSM_CMD_ATH,                                /*!< Disconnect Existing */
-    GSM_CMD_ATI,                                /*!< Display Product Identification Information */
-    GSM_CMD_ATL,                                /*!< Set Monitor speaker */
-    GSM_CMD_ATM,                                /*!< Set Monitor Speaker Mode */
-    GSM_CMD_PPP,                                /*!< Switch from Data Mode or PPP Online Mode to Command Mode, "+++" originally */
-    GSM_CMD_ATO,                                /*!< Switch from Command Mode to Data Mode */
-    GSM_CMD_ATP,                                /*!< Select Pulse Dialing */
-    GSM_CMD_ATQ,                                /*!< Set Result Code Presentation Mode */
-    GSM_CMD_ATS0,                               /*!< Set Number of Rings before Automatically Answering the Call */
-    GSM_CMD_ATS3,                               /*!< Set Command Line Termination Character */
-    GSM_CMD_ATS4,                               /*!< Set Response Formatting Character */
-    GSM_CMD_ATS5,                               /*!< Set Command Line Editing Character */
-    GSM_CMD_ATS6,                               /*!< Pause Before Blind */
-    GSM_CMD_ATS7,                               /*!< Set Number of Seconds to Wait for Connection Completion */
-    GSM_CMD_ATS8,                               /*!< Set Number of Seconds to Wait for Comma Dial Modifier Encountered in Dial String of D Command */
-    GSM_CMD_ATS10,                              /*!< Set Disconnect Delay after Indicating the Absence of Data Carrier */
-    GSM_CMD_ATT,                                /*!< Select Tone Dialing */
-    GSM_CMD_ATV,                                /*!< TA Response Format */
-    GSM_CMD_ATX,                                /*!< Set CONNECT Result Code Format and Monitor Call Progress */
-    GSM_CMD_ATZ,                                /*!< Reset Default Configuration */
-    GSM_CMD_AT_C,                               /*!< Set DCD Function Mode, AT&C */
-    GSM_CMD_AT_D,                               /*!< Set DTR Function, AT&D */
-    GSM_CMD_AT_F,                               /*!< Factory Defined Configuration, AT&F */
-    GSM_CMD_AT_V,                               /*!< Display Current Configuration, AT&V */
-    GSM_CMD_AT_W,                               /*!< Store Active Profile, AT&W */
-    GSM_CMD_GCAP,                               /*!< Request Complete TA Capabilities List */
-    GSM_CMD_GMI,                                /*!< Request Manufacturer Identification */
-    GSM_CMD_GMM,                                /*!< Request TA Model Identification */
-    GSM_CMD_GMR,                                /*!< Request TA Revision Identification of Software Release */
-    GSM_CMD_GOI,                                /*!< Request Global Object Identification */
-    GSM_CMD_GSN,                                /*!< Request TA Serial Number Identification (IMEI) */
-    GSM_CMD_ICF,                                /*!< Set TE-TA Control Character Framing */
-    GSM_CMD_IFC,                                /*!< Set TE-TA Local Data Flow Control */
-    GSM_CMD_IPR,                                /*!< Set TE-TA Fixed Local Rate */
-    GSM_CMD_HVOIC,                              /*!< Disconnect Voice Call Only */
-
-    /*
-     * AT commands according to 3GPP TS 27.007
-     */
-    GSM_CMD_COPS_SET,                           /*!< Set operator */
-    GSM_CMD_COPS_GET,                           /*!< Get current operator */
-    GSM_CMD_COPS_GET_OPT,                       /*!< Get a list of available operators */
-    GSM_CMD_CPAS,                               /*!< Phone Activity Status */
-    GSM_CMD_CGMI_GET,                           /*!< Request Manufacturer Identification */
-    GSM_CMD_CGMM_GET,                           /*!< Request Model Identification */
-    GSM_CMD_CGMR_GET,                           /*!< Request TA Revision Identification of Software Release */
-    GSM_CMD_CGSN_GET,                           /*!< Request Product Serial Number Identification (Identical with +GSN) */
-
-    GSM_CMD_CLCC,                               /*!< List Current Calls of ME */
-    GSM_CMD_CLCK,                               /*!< Facility Lock */
-
-    GSM_CMD_CACM,                               /*!< Accumulated Call Meter (ACM) Reset or Query */
-    GSM_CMD_CAMM,                               /*!< Accumulated Call Meter Maximum (ACM max) Set or Query */
-    GSM_CMD_CAOC,                               /*!< Advice of Charge */
-    GSM_CMD_CBST,                               /*!< Select Bearer Service Type */
-    GSM_CMD_CCFC,                               /*!< Call Forwarding Number and Conditions Control */
-    GSM_CMD_CCWA,                               /*!< Call Waiting Control */
-    GSM_CMD_CEER,                               /*!< Extended Error Report  */
-    GSM_CMD_CSCS,                               /*!< Select TE Character Set */
-    GSM_CMD_CSTA,                               /*!< Select Type of Address */
-    GSM_CMD_CHLD,                               /*!< Call Hold and Multiparty */
-    GSM_CMD_CIMI,                               /*!< Request International Mobile Subscriber Identity */
-    GSM_CMD_CLIP,                               /*!< Calling Line Identification Presentation */
-    GSM_CMD_CLIR,                               /*!< Calling Line Identification Restriction */
-    GSM_CMD_CMEE,                               /*!< Report Mobile Equipment Error */
-    GSM_CMD_COLP,                               /*!< Connected Line Identification Presentation */
-#if GSM_CFG_PHONEBOOK || __DOXYGEN__
-    GSM_CMD_PHONEBOOK_ENABLE,                   /*!< Top command to enable phonebook */
-    GSM_CMD_CPBF,                               /*!< Find Phonebook Entries */
-    GSM_CMD_CPBR,                               /*!< Read Current Phonebook Entries  */
-    GSM_CMD_CPBS_SET,                           /*!< Select Phonebook Memory Storage */
-    GSM_CMD_CPBS_GET,                           /*!< Get current Phonebook Memory Storage */
-    GSM_CMD_CPBS_GET_OPT,                       /*!< Get available Phonebook Memory Storages */
-    GSM_CMD_CPBW_SET,                           /*!< Write Phonebook Entry */
-    GSM_CMD_CPBW_GET_OPT,                       /*!< Get options for write Phonebook Entry */
-#endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
-    GSM_CMD_SIM_PROCESS_BASIC_CMDS,             /*!< Command setup, executed when SIM is in READY state */
-    GSM_CMD_CPIN_SET,                           /*!< Enter PIN */
-    GSM_CMD_CPIN_GET,                           /*!< Read current SIM status */
-    GSM_CMD_CPIN_ADD,                           /*!< Add new PIN to SIM if pin is not set */
-    GSM_CMD_CPIN_CHANGE,                        /*!< Change already active SIM */
-    GSM_CMD_CPIN_REMOVE,                        /*!< Remove current PIN */
-    GMM_CMD_CPUK_SET,                           /*!< Enter PUK and set new PIN */
-
-    GSM_CMD_CSQ_GET,                            /*!< Signal Quality Report */
-    GSM_CMD_CFUN_SET,                           /*!< Set Phone Functionality */
-    GSM_CMD_CFUN_GET,                           /*!< Get Phone Functionality */
-    GSM_CMD_CREG_SET,                           /*!< Network Registration set output */
-    GSM_CMD_CREG_GET,                           /*!< Get current network registration status */
-    GSM_CMD_CBC,                                /*!< Battery Charge */
-    GSM_CMD_CNUM,                               /*!< Subscriber Number */
-
-    GSM_CMD_CPWD,                               /*!< Change Password */
-    GSM_CMD_CR,                                 /*!< Service Reporting Control */
-    GSM_CMD_CRC,                                /*!< Set Cellular Result Codes for Incoming Call Indication */
-    GSM_CMD_CRLP,                               /*!< Select Radio Link Protocol Parameters  */
-    GSM_CMD_CRSM,                               /*!< Restricted SIM Access */
-    GSM_CMD_VTD,                                /*!< Tone Duration */
-    GSM_CMD_VTS,                                /*!< DTMF and Tone Generation */
-    GSM_CMD_CMUX,                               /*!< Multiplexer Control */
-    GSM_CMD_CPOL,                               /*!< Preferred Operator List */
-    GSM_CMD_COPN,                               /*!< Read Operator Names */
-    GSM_CMD_CCLK,                               /*!< Clock */
-    GSM_CMD_CSIM,                               /*!< Generic SIM Access */
-    GSM_CMD_CALM,                               /*!< Alert Sound Mode */
-    GSM_CMD_CALS,                               /*!< Alert Sound Select */
-    GSM_CMD_CRSL,                               /*!< Ringer Sound Level */
-    GSM_CMD_CLVL,                               /*!< Loud Speaker Volume Level */
-    GSM_CMD_CMUT,                               /*!< Mute Control */
-    GSM_CMD_CPUC,                               /*!< Price Per Unit and Currency Table */
-    GSM_CMD_CCWE,                               /*!< Call Meter Maximum Event */
-    GSM_CMD_CUSD,                               /*!< Unstructured Supplementary Service Data108 */
-    GSM_CMD_CSSN,                               /*!< Supplementary Services Notification 109 */
-#if GSM_CFG_CONN || __DOXYGEN__
-    GSM_CMD_CIPMUX,                             /*!< Start Up Multi-IP Connection */
-    GSM_CMD_CIPSTART,                           /*!< Start Up TCP or UDP Connection */
-    GSM_CMD_CIPSEND,                            /*!< Send Data Through TCP or UDP Connection */
-    GSM_CMD_CIPQSEND,                           /*!< Select Data Transmitting Mode */
-    GSM_CMD_CIPACK,                             /*!< Query Previous Connection Data Transmitting State */
-    GSM_CMD_CIPCLOSE,                           /*!< Close TCP or UDP Connection */
-    GSM_CMD_CIPSHUT,                            /*!< Deactivate GPRS PDP Context */
-    GSM_CMD_CLPORT,                             /*!< Set Local Port */
-    GSM_CMD_CSTT,                               /*!< Start Task and Set APN, username, password */
-    GSM_CMD_CIICR,                              /*!< Bring Up Wireless Connection with GPRS or CSD */
-    GSM_CMD_CIFSR,                              /*!< Get Local IP Address */
-    GSM_CMD_CIPSTATUS,                          /*!< Query Current Connection Status */
-    GSM_CMD_CDNSCFG,                            /*!< Configure Domain Name Server */
-    GSM_CMD_CDNSGIP,                            /*!< Query the IP Address of Given Domain Name */
-    GSM_CMD_CIPHEAD,                            /*!< Add an IP Head at the Beginning of a Package Received */
-    GSM_CMD_CIPATS,                             /*!< Set Auto Sending Timer */
-    GSM_CMD_CIPSPRT,                            /*!< Set Prompt of > When Module Sends Data */
-    GSM_CMD_CIPSERVER,                          /*!< Configure Module as Server */
-    GSM_CMD_CIPCSGP,                            /*!< Set CSD or GPRS for Connection Mode */
-    GSM_CMD_CIPSRIP,                            /*!< Show Remote IP Address and Port When Received Data */
-    GSM_CMD_CIPDPDP,                            /*!< Set Whether to Check State of GPRS Network Timing */
-    GSM_CMD_CIPMODE,                            /*!< Select TCPIP Application Mode */
-    GSM_CMD_CIPCCFG,                            /*!< Configure Transparent Transfer Mode */
-    GSM_CMD_CIPSHOWTP,                          /*!< Display Transfer Protocol in IP Head When Received Data */
-    GSM_CMD_CIPUDPMODE,                         /*!< UDP Extended Mode */
-    GSM_CMD_CIPRXGET,                           /*!< Get Data from Network Manually */
-    GSM_CMD_CIPSCONT,                           /*!< Save TCPIP Application Context */
-    GSM_CMD_CIPRDTIMER,                         /*!< Set Remote Delay Timer */
-    GSM_CMD_CIPSGTXT,                           /*!< Select GPRS PDP context */
-    GSM_CMD_CIPTKA,                             /*!< Set TCP Keepalive Parameters */
-#endif /* GSM_CFG_CONN || __DOXYGEN__ */
-#if GSM_CFG_CALL || __DOXYGEN__
-    GSM_CMD_CALL_ENABLE,                        /*!< Top command to enable call */
-#endif /* GSM_CFG_CALL || __DOXYGEN__ */
-#if GSM_CFG_SMS || __DOXYGEN__
-    GSM_CMD_SMS_ENABLE,                         /*!< Top command to enable SMS */
-    GSM_CMD_CMGD,                               /*!< Delete SMS Message */
-    GSM_CMD_CMGF,                               /*!< Select SMS Message Format */
-    GSM_CMD_CMGL,                               /*!< List SMS Messages from Preferred Store */
-    GSM_CMD_CMGR,                               /*!< Read SMS Message */
-    GSM_CMD_CMGS,                               /*!< Send SMS Message */
-    GSM_CMD_CMGW,                               /*!< Write SMS Message to Memory */
-    GSM_CMD_CMSS,                               /*!< Send SMS Message from Storage */
-    GSM_CMD_CNMI,                               /*!< New SMS Message Indications */
-    GSM_CMD_CPMS_SET,                           /*!< Set preferred SMS Message Storage */
-    GSM_CMD_CPMS_GET,                           /*!< Get preferred SMS Message Storage */
-    GSM_CMD_CPMS_GET_OPT,                       /*!< Get optional SMS message storages */
-    GSM_CMD_CRES,                               /*!< Restore SMS Settings */
-    GSM_CMD_CSAS,                               /*!< Save SMS Settings */
-    GSM_CMD_CSCA,                               /*!< SMS Service Center Address */
-    GSM_CMD_CSCB,                               /*!< Select Cell Broadcast SMS Messages */
-    GSM_CMD_CSDH,                               /*!< Show SMS Text Mode Parameters */
-    GSM_CMD_CSMP,                               /*!< Set SMS Text Mode Parameters */
-    GSM_CMD_CSMS,                               /*!< Select Message Service */
-#endif /* GSM_CFG_SMS || __DOXYGEN__ */
+#define GSM_CMD_DEF(name, str)                  GSM_CMD_ ## name,
+#include "gsm/gsm_commands.h"
 
     GSM_CMD_END,                                /*!< Last CMD entry */
 } gsm_cmd_t;
@@ -304,6 +105,16 @@ typedef struct gsm_pbuf_t {
     gsm_port_t port;                            /*!< Remote port for received IPD data */
 } gsm_pbuf_t;
 
+struct gsm_msg;
+
+/**
+ * \brief           Single step in sub-command sequence of message
+ */
+typedef struct {
+    gsm_cmd_t       cmd;                        /*!< Command to execute in this step */
+    uint8_t         (*is_done_fn)(struct gsm_msg *);    /*!< Optional function returning `1` when step is already satisfied by device state and can be skipped */
+} gsm_cmd_step_t;
+
 /**
  * \brief           Message queue structure to share between threads
  */
@@ -318,6 +129,9 @@ typedef struct gsm_msg {
     gsmr_t          res;                        /*!< Result of message operation */
     gsmr_t          (*fn)(struct gsm_msg *);    /*!< Processing callback function to process packet */
     gsmr_t          (*sub_fn)(struct gsm_msg *, uint8_t is_ok, uint16_t is_error);  /*!< Sub command function call */
+    const gsm_cmd_step_t* steps;                /*!< Optional table of sub-commands to execute in order. Set to `NULL` if not used */
+    uint8_t         steps_len;                  /*!< Number of entries in steps table */
+    uint8_t         step;                       /*!< Index of currently active step in steps table */
     union {
         struct {
             uint32_t delay;                     /*!< Delay to use before sending first reset AT command */
@@ -357,6 +171,10 @@ typedef struct gsm_msg {
             size_t opsl;                        /*!< Length of operators array */
             size_t opsi;                        /*!< Current operator index array */
             size_t* opf;                        /*!< Pointer to number of operators found */
+            gsm_operator_scan_fn fn;            /*!< Callback function for every operator in streaming mode */
+            void* fn_arg;                       /*!< Callback function argument */
+            size_t en;                          /*!< Number of operators passed to callback function */
+            uint8_t stop;                       /*!< Flag indicating callback function requested cancel and modem was notified */
         } cops_scan;                            /*!< Scan operators */
         struct {
             gsm_operator_curr_t* curr;          /*!< Pointer to output current operator */
@@ -373,6 +191,27 @@ typedef struct gsm_msg {
             const char* num;                    /*!< Phone number */
             const char* text;                   /*!< SMS content to send */
             uint8_t format;                     /*!< SMS format, `0 = PDU`, `1 = text` */
+            uint8_t cmms;                       /*!< Link control mode for next `CMMS_SET` command */
+            gsm_sms_batch_entry_t* batch;       /*!< Pointer to batch entries or `NULL` for single message */
+            size_t batch_len;                   /*!< Number of batch entries */
+            size_t batch_i;                     /*!< Current batch entry index */
+#if GSM_CFG_SMS_OUTBOX || __DOXYGEN__
+            uint32_t outbox_id;                 /*!< Outbox message ID or `0` if not sent from outbox */
+            uint16_t cms_err;                   /*!< Error code of `+CMS ERROR` response or `0` if not received */
+#endif /* GSM_CFG_SMS_OUTBOX || __DOXYGEN__ */
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+            uint32_t tag;                       /*!< User tag reported with status report */
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+            size_t len;                         /*!< Length of content in units of bytes */
+            gsm_sms_coding_t coding;            /*!< User data coding for PDU mode */
+            uint8_t ref;                        /*!< Concatenated message reference number */
+            uint8_t parts;                      /*!< Number of parts to send, `1` for single message */
+            uint8_t is_long;                    /*!< Status whether message is sent with \ref gsm_sms_send_long */
+            uint8_t part;                       /*!< Current part index, starting with `0` */
+            size_t part_pos;                    /*!< Current part start position in content */
+            size_t part_len;                    /*!< Current part length in units of bytes */
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
         } sms_send;                             /*!< Send SMS */
         struct {
             gsm_mem_t mem;                      /*!< Memory to read from */
@@ -385,6 +224,14 @@ typedef struct gsm_msg {
         struct {
             gsm_mem_t mem;                      /*!< Memory to delete from */
             size_t pos;                         /*!< SMS position in memory */
+            uint8_t delflag;                    /*!< Delete flag, `0` to delete message at position or `1-4` to delete group of messages */
+            gsm_sms_status_t status;            /*!< Status of messages deleted with delete flag or `CMGDA` */
+            uint8_t format;                     /*!< SMS format, `0 = PDU`, `1 = text` */
+#if GSM_CFG_SMS_DRAIN || __DOXYGEN__
+            size_t drain_pos[GSM_CFG_SMS_DRAIN_SIZE];   /*!< Positions of drained messages, deleted one after another */
+            size_t drain_cnt;                   /*!< Number of positions in `drain_pos` array */
+            size_t drain_idx;                   /*!< Index of position being deleted */
+#endif /* GSM_CFG_SMS_DRAIN || __DOXYGEN__ */
         } sms_delete;                           /*!< Delete SMS message */
         struct {
             gsm_mem_t mem;                      /*!< Memory to use for read */
@@ -396,10 +243,27 @@ typedef struct gsm_msg {
             uint8_t update;                     /*!< Update SMS status after read operation */
             uint8_t format;                     /*!< SMS format, `0 = PDU`, `1 = text` */
             uint8_t read;                       /*!< Read the data flag */
+            gsm_sms_list_fn fn;                 /*!< Callback function for every entry in streaming mode */
+            void* fn_arg;                       /*!< Callback function argument */
+            size_t en;                          /*!< Number of entries passed to callback function */
+            uint8_t stop;                       /*!< Flag indicating callback function requested stop */
+#if GSM_CFG_SMS_MIRROR || __DOXYGEN__
+            uint8_t mirror;                     /*!< Flag indicating list synchronizes local mirror */
+#endif /* GSM_CFG_SMS_MIRROR || __DOXYGEN__ */
+#if GSM_CFG_SMS_DRAIN || __DOXYGEN__
+            uint8_t drain;                      /*!< Flag indicating list drains received messages */
+#endif /* GSM_CFG_SMS_DRAIN || __DOXYGEN__ */
         } sms_list;                             /*!< List SMS messages */
         struct {
             gsm_mem_t mem[3];                   /*!< Array of memories */
         } sms_memory;                           /*!< Set preferred memories */
+        struct {
+            uint8_t mt;                         /*!< Indication of received messages, `1 = +CMTI`, `2 = +CMT` */
+            uint8_t ds;                         /*!< Indication of status reports, `0 = disabled`, `1 = +CDS` */
+            uint8_t format;                     /*!< SMS format, `0 = PDU`, `1 = text` */
+            uint8_t fo;                         /*!< First octet of SMS-SUBMIT read with `+CSMP?` */
+            char params[40];                    /*!< Remaining text mode parameters read with `+CSMP?`, sent back unchanged */
+        } sms_cnmi;                             /*!< New message indications settings */
 #endif /* GSM_CFG_SMS || __DOXYGEN__ */
 #if GSM_CFG_CALL || __DOXYGEN__
         struct {
@@ -422,6 +286,14 @@ typedef struct gsm_msg {
             size_t etr;                         /*!< NUmber of entries to read */
             size_t ei;                          /*!< Current entry index */
             size_t* er;                         /*!< Final entries read pointer for user */
+            size_t page;                        /*!< Number of positions read with single command in streaming mode */
+            gsm_pb_list_fn fn;                  /*!< Callback function for every entry in streaming mode */
+            void* fn_arg;                       /*!< Callback function argument */
+            size_t en;                          /*!< Number of entries passed to callback function */
+            uint8_t stop;                       /*!< Flag indicating callback function requested stop */
+#if GSM_CFG_PB_CACHE || __DOXYGEN__
+            uint8_t cache;                      /*!< Flag indicating entries are read in chunks to local cache */
+#endif /* GSM_CFG_PB_CACHE || __DOXYGEN__ */
         } pb_list;                              /*!< List phonebook entries */
         struct {
             gsm_mem_t mem;                      /*!< Memory to use */
@@ -431,6 +303,22 @@ typedef struct gsm_msg {
             size_t* er;                         /*!< Final entries read pointer for user */
             const char* search;                 /*!< Search string */
         } pb_search;                            /*!< Search phonebook entries */
+#if GSM_CFG_PB_SYNC || __DOXYGEN__
+        struct {
+            gsm_mem_t mem;                      /*!< Memory to synchronize */
+            const gsm_pb_entry_t* entries;      /*!< Target entries */
+            size_t len;                         /*!< Number of target entries */
+            size_t start_index;                 /*!< First index of next read range */
+            size_t ti;                          /*!< Index of target entry being written */
+            size_t pos;                         /*!< Position being written or deleted */
+            uint8_t del;                        /*!< Flag indicating position is being deleted */
+            size_t read;                        /*!< Number of entries read from device */
+            size_t kept;                        /*!< Number of target entries already stored on device */
+            size_t written;                     /*!< Number of finished writes */
+            size_t writes;                      /*!< Number of needed writes */
+            gsmr_t res;                         /*!< Sync result */
+        } pb_sync;                              /*!< Synchronize phonebook with target entries */
+#endif /* GSM_CFG_PB_SYNC || __DOXYGEN__ */
 #endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
 #if GSM_CFG_NETWORK || __DOXYGEN__ 
         struct {
@@ -483,6 +371,8 @@ typedef struct {
     size_t used;                                /*!< Number of used entries */
 } gsm_sms_mem_t;
 
+#define GSM_SMS_FORMAT_UNKNOWN          0xFF    /*!< SMS message format on device is not known */
+
 /**
  * \brief           SMS structure
  */
@@ -491,6 +381,13 @@ typedef struct {
     uint8_t enabled;                            /*!< Flag indicating feature enabled */
 
     gsm_sms_mem_t mem[3];                       /*!< 3 memory info for operation,receive,sent storage */
+    uint8_t format;                             /*!< Current message format set with `CMGF`, `0 = PDU`, `1 = text`, \ref GSM_SMS_FORMAT_UNKNOWN if not known */
+#if GSM_CFG_SMS_DIRECT || __DOXYGEN__
+    uint8_t direct;                             /*!< Flag indicating received messages are delivered with `+CMT` */
+#endif /* GSM_CFG_SMS_DIRECT || __DOXYGEN__ */
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+    uint8_t report;                             /*!< Flag indicating status reports are requested and delivered with `+CDS` */
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
 } gsm_sms_t;
 
 /**
@@ -530,6 +427,12 @@ typedef struct {
     gsm_sys_mbox_t      mbox_process;           /*!< Consumer message queue handle */
     gsm_sys_thread_t    thread_producer;        /*!< Producer thread handle */
     gsm_sys_thread_t    thread_process;         /*!< Processing thread handle */
+#if GSM_CFG_EVT_QUEUE || __DOXYGEN__
+    gsm_sys_mbox_t      mbox_evt;               /*!< Deferred event queue handle */
+#if GSM_CFG_EVT_QUEUE_THREAD || __DOXYGEN__
+    gsm_sys_thread_t    thread_evt;             /*!< Event delivery thread handle */
+#endif /* GSM_CFG_EVT_QUEUE_THREAD || __DOXYGEN__ */
+#endif /* GSM_CFG_EVT_QUEUE || __DOXYGEN__ */
 #if !GSM_CFG_INPUT_USE_PROCESS || __DOXYGEN__
     gsm_buff_t          buff;                   /*!< Input processing buffer */
 #endif /* !GSM_CFG_INPUT_USE_PROCESS || __DOXYGEN__ */
@@ -538,7 +441,8 @@ typedef struct {
     gsm_msg_t*          msg;                    /*!< Pointer to current user message being executed */
 
     gsm_cb_t            cb;                     /*!< Callback processing structure */
-    gsm_cb_func_t*      cb_func;                /*!< Callback function linked list */
+    gsm_cb_func_t*      cb_func;                /*!< Callback function linked list for all events */
+    gsm_cb_func_t*      cb_func_type[GSM_CB_END];   /*!< Callback function linked lists, one per event type */
 
     /*
      * Device driver specific
@@ -607,6 +511,7 @@ typedef struct {
 #define GSM_DEVICE_FEATURE_CALL                 GSM_U16(0x0002) /*!< Phone book feature */
 #define GSM_DEVICE_FEATURE_PB                   GSM_U16(0x0004) /*!< Call feature */
 #define GSM_DEVICE_FEATURE_TCPIP                GSM_U16(0x0004) /*!< TCP/IP raw connections */
+#define GSM_DEVICE_FEATURE_SMS_CMGDA            GSM_U16(0x0008) /*!< Delete SMS messages by type with `AT+CMGDA` */
 
 /**
  * \}
@@ -683,18 +588,19 @@ extern size_t               gsm_dev_mem_map_size;
 #define RECV_IDX(index)     recv_buff.data[index]
 
 #define GSM_AT_PORT_SEND_BEGIN()        do { GSM_AT_PORT_SEND_STR("AT"); } while (0)
-#define GSM_AT_PORT_SEND_END()          do { GSM_AT_PORT_SEND_STR(CRLF); } while (0)
+#define GSM_AT_PORT_SEND_END()          do { GSM_AT_PORT_SEND_STR(CRLF); GSM_AT_PORT_SEND_FLUSH(); } while (0)
 
-#define GSM_AT_PORT_SEND_STR(str)       gsm.ll.send_fn((const uint8_t *)(str), (uint16_t)strlen(str))
-#define GSM_AT_PORT_SEND_CHR(ch)        gsm.ll.send_fn((const uint8_t *)(ch), (uint16_t)1)
-#define GSM_AT_PORT_SEND(d, l)          gsm.ll.send_fn((const uint8_t *)(d), (uint16_t)(l))
+#define GSM_AT_PORT_SEND_STR(str)       gsmi_at_port_send((const void *)(str), strlen(str))
+#define GSM_AT_PORT_SEND_CHR(ch)        gsmi_at_port_send((const void *)(ch), 1)
+#define GSM_AT_PORT_SEND(d, l)          gsmi_at_port_send((const void *)(d), (size_t)(l))
+#define GSM_AT_PORT_SEND_FLUSH()        gsmi_at_port_flush()
 
 #define GSM_AT_PORT_SEND_QUOTE_COND(q)  do { if ((q)) { GSM_AT_PORT_SEND_STR("\""); } } while (0)
 #define GSM_AT_PORT_SEND_COMMA_COND(c)  do { if ((c)) { GSM_AT_PORT_SEND_STR(","); } } while (0)
 #define GSM_AT_PORT_SEND_EQUAL_COND(e)  do { if ((e)) { GSM_AT_PORT_SEND_STR("="); } } while (0)
 
-#define GSM_AT_PORT_SEND_CTRL_Z()       GSM_AT_PORT_SEND_STR("\x1A")
-#define GSM_AT_PORT_SEND_ESC()          GSM_AT_PORT_SEND_STR("\x1B")
+#define GSM_AT_PORT_SEND_CTRL_Z()       do { GSM_AT_PORT_SEND_STR("\x1A"); GSM_AT_PORT_SEND_FLUSH(); } while (0)
+#define GSM_AT_PORT_SEND_ESC()          do { GSM_AT_PORT_SEND_STR("\x1B"); GSM_AT_PORT_SEND_FLUSH(); } while (0)
 
 #define GSM_PORT2NUM(port)              ((uint32_t)(port))
 
@@ -714,6 +620,11 @@ gsmr_t      gsmi_process_buffer(void);
 gsmr_t      gsmi_initiate_cmd(gsm_msg_t* msg);
 uint8_t     gsmi_is_valid_conn_ptr(gsm_conn_p conn);
 gsmr_t      gsmi_send_cb(gsm_cb_type_t type);
+#if GSM_CFG_EVT_QUEUE
+gsmr_t      gsmi_evt_queue_init(void);
+gsmr_t      gsmi_evt_queue_put(const gsm_cb_t* cb);
+void        gsmi_evt_queue_dispatch(void* r);
+#endif /* GSM_CFG_EVT_QUEUE */
 gsmr_t      gsmi_send_conn_cb(gsm_conn_t* conn, gsm_cb_fn cb);
 void        gsmi_conn_init(void);
 gsmr_t      gsmi_send_msg_to_producer_mbox(gsm_msg_t* msg, gsmr_t (*process_fn)(gsm_msg_t *), uint32_t block, uint32_t max_block_time);
@@ -722,12 +633,81 @@ uint32_t    gsmi_get_from_mbox_with_timeout_checks(gsm_sys_mbox_t* b, void** m,
 
 gsmr_t      gsmi_get_sim_info(uint32_t blocking);
 
+gsm_cmd_t   gsmi_cmd_steps_next(gsm_msg_t* msg, uint8_t first);
+void        gsmi_invalidate_cache(void);
+#if GSM_CFG_SMS
+gsm_mem_t   gsmi_sms_get_op_mem(gsm_msg_t* msg);
+uint8_t     gsmi_sms_get_op_format(gsm_msg_t* msg);
+#endif /* GSM_CFG_SMS */
+#if GSM_CFG_SMS_CONCAT
+void        gsmi_sms_concat_process(const gsm_sms_entry_t* entry);
+#endif /* GSM_CFG_SMS_CONCAT */
+#if GSM_CFG_SMS_DRAIN
+uint8_t     gsmi_sms_drain_notify(gsm_mem_t mem);
+void        gsmi_sms_drain_finish(gsm_mem_t mem);
+#endif /* GSM_CFG_SMS_DRAIN */
+#if GSM_CFG_SMS_WATERMARK
+void        gsmi_sms_watermark_update(gsm_mem_t mem, int8_t diff);
+#endif /* GSM_CFG_SMS_WATERMARK */
+#if GSM_CFG_SMS_OUTBOX
+gsmr_t      gsmi_sms_outbox_send_msg(const char* num, const char* text, uint32_t id);
+void        gsmi_sms_outbox_result(uint32_t id, gsmr_t res, uint16_t cms_err);
+void        gsmi_sms_outbox_resume(uint8_t reset);
+#endif /* GSM_CFG_SMS_OUTBOX */
+#if GSM_CFG_SMS_REPORT
+void        gsmi_sms_report_add(uint8_t mr, uint32_t tag);
+void        gsmi_sms_report_process(const gsm_sms_report_t* report);
+#endif /* GSM_CFG_SMS_REPORT */
+#if GSM_CFG_SMS_MIRROR
+void        gsmi_sms_mirror_sync_start(gsm_mem_t mem);
+void        gsmi_sms_mirror_sync_finish(gsm_mem_t mem, uint8_t ok);
+void        gsmi_sms_mirror_update(const gsm_sms_entry_t* entry, uint8_t update);
+void        gsmi_sms_mirror_add(gsm_mem_t mem, size_t pos);
+void        gsmi_sms_mirror_delete(gsm_mem_t mem, size_t pos);
+void        gsmi_sms_mirror_delete_status(gsm_mem_t mem, gsm_sms_status_t status);
+void        gsmi_sms_mirror_invalidate(void);
+gsmr_t      gsmi_sms_mirror_read(gsm_mem_t mem, size_t pos, gsm_sms_entry_t* entry, uint8_t update);
+gsmr_t      gsmi_sms_mirror_list(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entries, size_t etr, size_t* er, uint8_t update);
+#endif /* GSM_CFG_SMS_MIRROR */
+#if GSM_CFG_PHONEBOOK
+gsm_mem_t   gsmi_pb_get_op_mem(gsm_msg_t* msg);
+uint8_t     gsmi_pb_page_next(size_t* start_index, size_t page, size_t read);
+#endif /* GSM_CFG_PHONEBOOK */
+#if GSM_CFG_PB_CACHE
+void        gsmi_pb_cache_load_start(gsm_mem_t mem);
+gsmr_t      gsmi_pb_cache_load_chunk(gsm_msg_t* msg, uint8_t ok);
+size_t      gsmi_pb_cache_free_pos(gsm_mem_t mem);
+void        gsmi_pb_cache_update(gsm_mem_t mem, size_t pos, const char* name, const char* num, gsm_number_type_t type);
+void        gsmi_pb_cache_invalidate(void);
+gsmr_t      gsmi_pb_cache_search(gsm_mem_t mem, const char* search, gsm_pb_entry_t* entries, size_t etr, size_t* er);
+#endif /* GSM_CFG_PB_CACHE */
+#if GSM_CFG_PB_SYNC
+void        gsmi_pb_sync_start(gsm_msg_t* msg);
+void        gsmi_pb_sync_read(gsm_msg_t* msg, const gsm_pb_entry_t* e);
+gsm_cmd_t   gsmi_pb_sync_next(gsm_msg_t* msg, uint8_t ok);
+#endif /* GSM_CFG_PB_SYNC */
+#if GSM_CFG_OPERATOR_CACHE
+void        gsmi_operator_cache_start(void);
+void        gsmi_operator_cache_add(const gsm_operator_t* op);
+void        gsmi_operator_cache_finish(uint8_t ok);
+gsmr_t      gsmi_operator_cache_scan(gsm_operator_t* ops, size_t opsl, size_t* opf);
+void        gsmi_operator_names_start(void);
+void        gsmi_operator_names_add(uint32_t num, const char* name);
+gsmr_t      gsmi_operator_names_finish(uint8_t ok);
+#endif /* GSM_CFG_OPERATOR_CACHE */
+#if GSM_CFG_NETWORK_REG
+void        gsmi_network_reg_update(gsm_network_reg_domain_t domain, const gsm_network_reg_t* reg, uint8_t solicited);
+void        gsmi_network_reg_reset(void);
+#endif /* GSM_CFG_NETWORK_REG */
+
 /* Send functions */
 void        byte_to_str(uint8_t num, char* str);
 void        number_to_str(uint32_t num, char* str);
 void        signed_number_to_str(int32_t num, char* str);
 
 /* Send functions */
+void        gsmi_at_port_send(const void* data, size_t len);
+void        gsmi_at_port_flush(void);
 void        send_ip_mac(const void* d, uint8_t is_ip, uint8_t q, uint8_t c);
 void        send_string(const char* str, uint8_t e, uint8_t q, uint8_t c);
 void        send_number(uint32_t num, uint8_t q, uint8_t c);
@@ -51,11 +51,50 @@ gsmr_t      gsm_sms_enable(uint32_t blocking);
 gsmr_t      gsm_sms_disable(uint32_t blocking);
 
 gsmr_t      gsm_sms_send(const char* num, const char* text, uint32_t blocking);
+gsmr_t      gsm_sms_send_data(const char* num, const void* data, size_t len, uint32_t blocking);
+gsmr_t      gsm_sms_send_long(const char* num, const char* text, uint32_t blocking);
+gsmr_t      gsm_sms_send_batch(gsm_sms_batch_entry_t* entries, size_t count, uint32_t blocking);
 gsmr_t      gsm_sms_read(gsm_mem_t mem, size_t pos, gsm_sms_entry_t* entry, uint8_t update, uint32_t blocking);
 gsmr_t      gsm_sms_delete(gsm_mem_t mem, size_t pos, uint32_t blocking);
+gsmr_t      gsm_sms_delete_all(gsm_mem_t mem, gsm_sms_status_t status, uint32_t blocking);
 gsmr_t      gsm_sms_list(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entries, size_t etr, size_t* er, uint8_t update, uint32_t blocking);
+gsmr_t      gsm_sms_list_stream(gsm_mem_t mem, gsm_sms_status_t stat, gsm_sms_entry_t* entry, gsm_sms_list_fn fn, void* arg, size_t* er, uint8_t update, uint32_t blocking);
 gsmr_t      gsm_sms_set_preferred_storage(gsm_mem_t mem1, gsm_mem_t mem2, gsm_mem_t mem3, uint32_t blocking);
 
+#if GSM_CFG_SMS_DIRECT || __DOXYGEN__
+gsmr_t      gsm_sms_set_direct(uint8_t enable, uint32_t blocking);
+#endif /* GSM_CFG_SMS_DIRECT || __DOXYGEN__ */
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+gsmr_t      gsm_sms_send_tagged(const char* num, const char* text, uint32_t tag, uint32_t blocking);
+gsmr_t      gsm_sms_set_report(uint8_t enable, uint32_t blocking);
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+gsmr_t      gsm_sms_send_long_tagged(const char* num, const char* text, uint32_t tag, uint32_t blocking);
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
+#if GSM_CFG_SMS_DRAIN || __DOXYGEN__
+gsmr_t      gsm_sms_set_drain(uint8_t enable);
+#endif /* GSM_CFG_SMS_DRAIN || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_MIRROR || __DOXYGEN__
+gsmr_t      gsm_sms_mirror_sync(gsm_mem_t mem, uint32_t blocking);
+uint8_t     gsm_sms_mirror_is_valid(gsm_mem_t mem);
+gsmr_t      gsm_sms_mirror_get(gsm_mem_t mem, size_t pos, gsm_sms_entry_t* entry);
+size_t      gsm_sms_mirror_find(gsm_mem_t mem, gsm_sms_status_t status, const char* number, size_t* pos, size_t posl);
+#endif /* GSM_CFG_SMS_MIRROR || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_ROUTER || __DOXYGEN__
+gsmr_t      gsm_sms_router_add(const char* prefix, gsm_sms_route_fn fn, void* arg);
+gsmr_t      gsm_sms_router_remove(const char* prefix);
+gsmr_t      gsm_sms_router_dispatch(const gsm_sms_entry_t* entry);
+#endif /* GSM_CFG_SMS_ROUTER || __DOXYGEN__ */
+
+#if GSM_CFG_SMS_OUTBOX || __DOXYGEN__
+gsmr_t      gsm_sms_outbox_set_journal(const gsm_sms_outbox_journal_t* journal);
+gsmr_t      gsm_sms_outbox_replay(const gsm_sms_outbox_rec_t* rec);
+gsmr_t      gsm_sms_outbox_send(const char* num, const char* text, uint32_t* id);
+size_t      gsm_sms_outbox_get_pending(void);
+#endif /* GSM_CFG_SMS_OUTBOX || __DOXYGEN__ */
+
 /**
  * \}
  */
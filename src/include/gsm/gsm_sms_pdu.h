@@ -0,0 +1,71 @@
+/**	
+ * \file            gsm_sms_pdu.h
+ * \brief           SMS PDU encoder and decoder
+ */
+ 
+/*
+ * Copyright (c) 2018 Tilen Majerle
+ *  
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, 
+ * and to permit persons to whom the Software is furnished to do so, 
+ * subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of GSM-AT.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ */
+#ifndef __GSM_SMS_PDU_H
+#define __GSM_SMS_PDU_H
+
+/* C++ detection */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "gsm/gsm.h"
+
+/**
+ * \ingroup         GSM_SMS
+ * \defgroup        GSM_SMS_PDU PDU codec
+ * \brief           SMS PDU encoder and decoder
+ * \{
+ */
+
+#define GSM_SMS_PDU_MAX_LEN             176     /*!< Maximal PDU length in units of bytes, including SMSC information */
+#define GSM_SMS_PDU_UD_MAX_LEN          140     /*!< Maximal user data length in units of bytes */
+#define GSM_SMS_PDU_CONCAT_7BIT_LEN     153     /*!< Maximal number of septets in single part of concatenated message */
+#define GSM_SMS_PDU_CONCAT_UCS2_LEN     67      /*!< Maximal number of UCS2 characters in single part of concatenated message */
+
+gsm_sms_coding_t    gsm_sms_pdu_get_coding(const char* text, size_t len);
+size_t      gsm_sms_pdu_get_text_len(const char* text, size_t len, gsm_sms_coding_t coding);
+size_t      gsm_sms_pdu_get_text_fit(const char* text, size_t len, gsm_sms_coding_t coding, size_t max_units);
+size_t      gsm_sms_pdu_encode_submit(uint8_t* pdu, const char* num, const void* data, size_t len, gsm_sms_coding_t coding, const gsm_sms_concat_t* concat);
+uint8_t     gsm_sms_pdu_decode(const uint8_t* pdu, size_t len, gsm_sms_entry_t* entry);
+uint8_t     gsm_sms_pdu_decode_report(const uint8_t* pdu, size_t len, gsm_sms_report_t* report);
+
+/**
+ * \}
+ */
+
+/* C++ detection */
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GSM_SMS_PDU_H */
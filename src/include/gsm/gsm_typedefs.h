@@ -167,6 +167,26 @@ typedef enum {
     GSM_SMS_STATUS_UNSENT,                      /*!< SMS status is unsent */
 } gsm_sms_status_t;
 
+/**
+ * \ingroup         GSM_SMS
+ * \brief           SMS user data coding, value matches data coding scheme byte
+ */
+typedef enum {
+    GSM_SMS_CODING_7BIT = 0x00,                 /*!< GSM 03.38 default alphabet, packed to 7-bits */
+    GSM_SMS_CODING_8BIT = 0x04,                 /*!< 8-bit binary data */
+    GSM_SMS_CODING_UCS2 = 0x08,                 /*!< UCS2 16-bit characters */
+} gsm_sms_coding_t;
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           Concatenated SMS information from user data header
+ */
+typedef struct {
+    uint16_t ref;                               /*!< Reference number, same for all parts of single message */
+    uint8_t total;                              /*!< Total number of parts, `0` if message is not concatenated */
+    uint8_t seq;                                /*!< Sequence number of this part, starting with `1` */
+} gsm_sms_concat_t;
+
 /**
  * \ingroup         GSM_SMS
  * \brief           SMS entry structure
@@ -178,10 +198,96 @@ typedef struct {
     gsm_sms_status_t status;                    /*!< Message status */
     char number[26];                            /*!< Phone number */
     char name[20];                              /*!< Name in phonebook if exists */
+#if GSM_CFG_SMS_PDU
+    char data[321];                             /*!< Data memory, fits 160 GSM characters or 70 UCS2 characters converted to UTF-8 */
+#else /* GSM_CFG_SMS_PDU */
     char data[161];                             /*!< Data memory */
+#endif /* !GSM_CFG_SMS_PDU */
     size_t length;                              /*!< Length of SMS data */
+#if GSM_CFG_SMS_BODY_SLICE || __DOXYGEN__
+    size_t body_length;                         /*!< Length of entire received body, passed with \ref GSM_CB_SMS_BODY event */
+#endif /* GSM_CFG_SMS_BODY_SLICE || __DOXYGEN__ */
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+    gsm_sms_coding_t coding;                    /*!< User data coding. Text is converted to UTF-8 in `data` field */
+    gsm_sms_concat_t concat;                    /*!< Concatenation information if message is part of longer message */
+    uint8_t truncated;                          /*!< Set to `1` when converted text of malformed message did not fit `data` field and was truncated */
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
 } gsm_sms_entry_t;
 
+/**
+ * \ingroup         GSM_SMS
+ * \brief           Single message of SMS batch send
+ */
+typedef struct {
+    const char* num;                            /*!< Phone number */
+    const char* text;                           /*!< Text to send */
+    gsmr_t res;                                 /*!< Send result, set by stack */
+    size_t mr;                                  /*!< Message reference received from network, valid when `res` is \ref gsmOK */
+} gsm_sms_batch_entry_t;
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           Callback function for streaming SMS list
+ * \param[in]       entry: Listed SMS entry. Buffer is reused for next entry after function returns
+ * \param[in]       arg: User argument
+ * \return          \ref gsmOK to continue with next entry, member of \ref gsmr_t to stop listing
+ */
+typedef gsmr_t  (*gsm_sms_list_fn)(const gsm_sms_entry_t* entry, void* arg);
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           Handler function of SMS route
+ * \param[in]       entry: Received SMS entry, valid only during function call
+ * \param[in]       arg: User argument of route
+ */
+typedef void    (*gsm_sms_route_fn)(const gsm_sms_entry_t* entry, void* arg);
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           SMS delivery status report
+ */
+typedef struct {
+    uint8_t mr;                                 /*!< Message reference of sent message */
+    char number[26];                            /*!< Recipient phone number */
+    gsm_datetime_t datetime;                    /*!< Time of delivery or failure */
+    uint8_t st;                                 /*!< Status by network, `0x00-0x1F` delivered, `0x20-0x3F` still trying, failed otherwise */
+} gsm_sms_report_t;
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           SMS outbox journal record type
+ */
+typedef enum {
+    GSM_SMS_OUTBOX_REC_ADD = 0x00,              /*!< Message was added to outbox */
+    GSM_SMS_OUTBOX_REC_DONE,                    /*!< Message was sent or failed permanently */
+} gsm_sms_outbox_rec_type_t;
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           SMS outbox journal record
+ */
+typedef struct {
+    gsm_sms_outbox_rec_type_t type;             /*!< Record type */
+    uint32_t id;                                /*!< Message ID */
+    const char* num;                            /*!< Phone number, used with \ref GSM_SMS_OUTBOX_REC_ADD only */
+    const char* text;                           /*!< Text to send, used with \ref GSM_SMS_OUTBOX_REC_ADD only */
+    gsmr_t res;                                 /*!< Final send result, used with \ref GSM_SMS_OUTBOX_REC_DONE only */
+} gsm_sms_outbox_rec_t;
+
+/**
+ * \ingroup         GSM_SMS
+ * \brief           SMS outbox journal implemented by application
+ *
+ *                  Records are appended in order and made persistent with commit function,
+ *                  called once for group of appended records.
+ *                  Message is sent only after its \ref GSM_SMS_OUTBOX_REC_ADD record was committed
+ */
+typedef struct {
+    gsmr_t  (*append)(const gsm_sms_outbox_rec_t* rec, void* arg);  /*!< Append record to journal */
+    gsmr_t  (*commit)(void* arg);               /*!< Make all appended records persistent */
+    void* arg;                                  /*!< User argument for functions */
+} gsm_sms_outbox_journal_t;
+
 /**
  * \ingroup         GSM_PB
  * \brief           Phonebook entry structure
@@ -194,6 +300,15 @@ typedef struct {
     gsm_number_type_t type;                     /*!< Phone number type */
 } gsm_pb_entry_t;
 
+/**
+ * \ingroup         GSM_PB
+ * \brief           Callback function for streaming phonebook list
+ * \param[in]       entry: Listed phonebook entry. Buffer is reused for next entry after function returns
+ * \param[in]       arg: User argument
+ * \return          \ref gsmOK to continue with next entry, member of \ref gsmr_t to stop listing
+ */
+typedef gsmr_t  (*gsm_pb_list_fn)(const gsm_pb_entry_t* entry, void* arg);
+
 /**
  * \ingroup         GSM_OPERATOR
  * \brief           Operator status value
@@ -205,6 +320,24 @@ typedef enum {
     GSM_OPERATOR_STATUS_FORBIDDEN               /*!< Operator is forbidden */
 } gsm_operator_status_t;
 
+/**
+ * \ingroup         GSM_OPERATOR
+ * \brief           Operator access technology
+ */
+typedef enum {
+    GSM_OPERATOR_ACT_GSM = 0x00,                /*!< GSM */
+    GSM_OPERATOR_ACT_GSM_COMPACT,               /*!< GSM compact */
+    GSM_OPERATOR_ACT_UTRAN,                     /*!< UTRAN */
+    GSM_OPERATOR_ACT_GSM_EGPRS,                 /*!< GSM with EGPRS */
+    GSM_OPERATOR_ACT_UTRAN_HSDPA,               /*!< UTRAN with HSDPA */
+    GSM_OPERATOR_ACT_UTRAN_HSUPA,               /*!< UTRAN with HSUPA */
+    GSM_OPERATOR_ACT_UTRAN_HSDPA_HSUPA,         /*!< UTRAN with HSDPA and HSUPA */
+    GSM_OPERATOR_ACT_E_UTRAN,                   /*!< E-UTRAN */
+    GSM_OPERATOR_ACT_EC_GSM_IOT,                /*!< EC-GSM-IoT */
+    GSM_OPERATOR_ACT_E_UTRAN_NB_S1,             /*!< E-UTRAN NB-S1 (NB-IoT) */
+    GSM_OPERATOR_ACT_UNKNOWN = 0xFF,            /*!< Access technology not reported */
+} gsm_operator_act_t;
+
 /**
  * \ingroup         GSM_OPERATOR
  * \brief           Operator selection mode
@@ -236,8 +369,18 @@ typedef struct {
     char long_name[20];                         /*!< Operator long name */
     char short_name[20];                        /*!< Operator short name */
     uint32_t num;                               /*!< Operator numeric value */
+    gsm_operator_act_t act;                     /*!< Access technology, \ref GSM_OPERATOR_ACT_UNKNOWN if not reported */
 } gsm_operator_t;
 
+/**
+ * \ingroup         GSM_OPERATOR
+ * \brief           Callback function for streaming operator scan
+ * \param[in]       op: Found operator. Buffer is reused for next operator after function returns
+ * \param[in]       arg: User argument
+ * \return          \ref gsmOK to continue scan, member of \ref gsmr_t to cancel it
+ */
+typedef gsmr_t  (*gsm_operator_scan_fn)(const gsm_operator_t* op, void* arg);
+
 /**
  * \ingroup         GSM_OPERATOR
  * \brief           Current operator info
@@ -263,6 +406,26 @@ typedef enum {
     GSM_NETWORK_REG_STATUS_CONNECTED_ROAMING = 0x05 /*!< Device is connected and is roaming */
 } gsm_network_reg_status_t;
 
+/**
+ * \brief           Network registration domain
+ */
+typedef enum {
+    GSM_NETWORK_REG_DOMAIN_CS = 0x00,           /*!< Circuit switched registration, reported with `+CREG` */
+    GSM_NETWORK_REG_DOMAIN_PS,                  /*!< GPRS registration, reported with `+CGREG` */
+    GSM_NETWORK_REG_DOMAIN_EPS,                 /*!< LTE registration, reported with `+CEREG` */
+    GSM_NETWORK_REG_DOMAIN_END,                 /*!< Number of domains, not valid domain */
+} gsm_network_reg_domain_t;
+
+/**
+ * \brief           Network registration with location info
+ */
+typedef struct {
+    gsm_network_reg_status_t status;            /*!< Registration status */
+    uint32_t lac;                               /*!< Location area code, tracking area code for \ref GSM_NETWORK_REG_DOMAIN_EPS */
+    uint32_t ci;                                /*!< Cell ID */
+    gsm_operator_act_t act;                     /*!< Access technology, \ref GSM_OPERATOR_ACT_UNKNOWN if not reported */
+} gsm_network_reg_t;
+
 /**
  * \ingroup         GSM_CALL
  * \brief           List of call directions
@@ -363,14 +526,42 @@ typedef enum gsm_cb_type_t {
 
     GSM_CB_CPIN,                                /*!< SIM event */
     GSM_CB_OPERATOR_CURRENT,                    /*!< Current operator event */
+#if GSM_CFG_NETWORK_REG || __DOXYGEN__
+    GSM_CB_NETWORK_REG_CHANGED,                 /*!< Debounced network registration status changed */
+    GSM_CB_NETWORK_CELL_CHANGED,                /*!< Serving cell or access technology changed while registered */
+#endif /* GSM_CFG_NETWORK_REG || __DOXYGEN__ */
 #if GSM_CFG_SMS || __DOXYGEN__
     GSM_CB_SMS_ENABLE,                          /*!< SMS enable event */
     GSM_CB_SMS_READY,                           /*!< SMS ready event */
     GSM_CB_SMS_SENT,                            /*!< SMS sent successfully */
     GSM_CB_SMS_SEND_ERROR,                      /*!< SMS sent successfully */
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+    GSM_CB_SMS_SEND_LONG,                       /*!< Long SMS send finished */
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
     GSM_CB_SMS_RECV,                            /*!< SMS received */
+#if GSM_CFG_SMS_DIRECT || __DOXYGEN__
+    GSM_CB_SMS_RECV_DIRECT,                     /*!< SMS received directly with `+CMT`, not stored to memory */
+#endif /* GSM_CFG_SMS_DIRECT || __DOXYGEN__ */
+#if GSM_CFG_SMS_DRAIN || __DOXYGEN__
+    GSM_CB_SMS_RECV_BATCH,                      /*!< Batch of received SMS drained from memory */
+#endif /* GSM_CFG_SMS_DRAIN || __DOXYGEN__ */
+#if GSM_CFG_SMS_WATERMARK || __DOXYGEN__
+    GSM_CB_SMS_STORAGE,                         /*!< Usage of memory for received SMS crossed watermark */
+#endif /* GSM_CFG_SMS_WATERMARK || __DOXYGEN__ */
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+    GSM_CB_SMS_REPORT,                          /*!< Sent SMS was delivered, failed or status report expired */
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
+#if GSM_CFG_SMS_OUTBOX || __DOXYGEN__
+    GSM_CB_SMS_OUTBOX,                          /*!< Outbox message was sent or failed permanently */
+#endif /* GSM_CFG_SMS_OUTBOX || __DOXYGEN__ */
     GSM_CB_SMS_READ,                            /*!< SMS read */
     GSM_CB_SMS_LIST,                            /*!< SMS list */
+#if GSM_CFG_SMS_BODY_SLICE || __DOXYGEN__
+    GSM_CB_SMS_BODY,                            /*!< Slice of SMS body received during read or list */
+#endif /* GSM_CFG_SMS_BODY_SLICE || __DOXYGEN__ */
+#if GSM_CFG_SMS_CONCAT || __DOXYGEN__
+    GSM_CB_SMS_CONCAT,                          /*!< All parts of concatenated SMS received */
+#endif /* GSM_CFG_SMS_CONCAT || __DOXYGEN__ */
 #endif /* GSM_CFG_SMS || __DOXYGEN__ */
 #if GSM_CFG_CALL || __DOXYGEN__
     GSM_CB_CALL_ENABLE,                         /*!< Call enable event */
@@ -384,8 +575,12 @@ typedef enum gsm_cb_type_t {
     GSM_CB_PB_ENABLE,                           /*!< Phonebook enable event */
     GSM_CB_PB_LIST,                             /*!< Phonebook list event */
     GSM_CB_PB_SEARCH,                           /*!< Phonebook search event */
+#if GSM_CFG_PB_SYNC || __DOXYGEN__
+    GSM_CB_PB_SYNC,                             /*!< Phonebook sync progress event */
+#endif /* GSM_CFG_PB_SYNC || __DOXYGEN__ */
 #endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
-    
+
+    GSM_CB_END,                                 /*!< Last event type, used for per-type listener array size */
 } gsm_cb_type_t;
 
 /**
@@ -401,17 +596,74 @@ typedef struct gsm_cb_t {
         struct {
             const gsm_operator_curr_t* operator_current;    /*!< Current operator info */
         } operator_current;                     /*!< Current operator event. Use with \ref GSM_CB_OPERATOR_CURRENT event */
+#if GSM_CFG_NETWORK_REG || __DOXYGEN__
+        struct {
+            gsm_network_reg_domain_t domain;    /*!< Registration domain */
+            gsm_network_reg_t reg;              /*!< New registration */
+            gsm_network_reg_status_t prev_status;   /*!< Previous registration status */
+        } network_reg;                          /*!< Network registration event. Use with \ref GSM_CB_NETWORK_REG_CHANGED or \ref GSM_CB_NETWORK_CELL_CHANGED events */
+#endif /* GSM_CFG_NETWORK_REG || __DOXYGEN__ */
 #if GSM_CFG_SMS || __DOXYGEN__
         struct {
             gsmr_t status;                      /*!< Enable status */
         } sms_enable;                           /*!< SMS enable event. Use with \ref GSM_CB_SMS_ENABLE event */
         struct {
             size_t num;                         /*!< Received number in memory for sent SMS*/
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+            uint8_t part;                       /*!< Part number of concatenated message, starting with `1` */
+            uint8_t parts;                      /*!< Number of parts of message, `1` for single message */
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
         } sms_sent;                             /*!< SMS sent info. Use with \ref GSM_CB_SMS_SENT event */
+#if GSM_CFG_SMS_PDU || __DOXYGEN__
+        struct {
+            const char* num;                    /*!< Phone number */
+            uint8_t parts;                      /*!< Number of parts of message */
+            uint8_t sent;                       /*!< Number of parts successfully sent */
+            gsmr_t status;                      /*!< \ref gsmOK when all parts were sent, member of \ref gsmr_t otherwise */
+        } sms_send_long;                        /*!< Long SMS send finished. Use with \ref GSM_CB_SMS_SEND_LONG event */
+#endif /* GSM_CFG_SMS_PDU || __DOXYGEN__ */
         struct {
             gsm_mem_t mem;                      /*!< Memory of received message */
             size_t pos;                         /*!< Received position in memory for sent SMS */
         } sms_recv;                             /*!< SMS received info. Use with \ref GSM_CB_SMS_RECV event */
+#if GSM_CFG_SMS_DIRECT || __DOXYGEN__
+        struct {
+            gsm_sms_entry_t* entry;             /*!< Received SMS entry, valid only during event */
+        } sms_recv_direct;                      /*!< SMS received directly. Use with \ref GSM_CB_SMS_RECV_DIRECT event */
+#endif /* GSM_CFG_SMS_DIRECT || __DOXYGEN__ */
+#if GSM_CFG_SMS_DRAIN || __DOXYGEN__
+        struct {
+            gsm_mem_t mem;                      /*!< Memory messages were drained from */
+            gsm_sms_entry_t* entries;           /*!< Pointer to entries, valid only during event */
+            size_t size;                        /*!< Number of valid entries */
+        } sms_recv_batch;                       /*!< Batch of received SMS. Use with \ref GSM_CB_SMS_RECV_BATCH event */
+#endif /* GSM_CFG_SMS_DRAIN || __DOXYGEN__ */
+#if GSM_CFG_SMS_WATERMARK || __DOXYGEN__
+        struct {
+            gsm_mem_t mem;                      /*!< Memory for received messages */
+            size_t used;                        /*!< Number of used entries */
+            size_t total;                       /*!< Size of memory in units of entries */
+            uint8_t high;                       /*!< Set to `1` when high watermark is reached or `0` when usage dropped to low watermark */
+        } sms_storage;                          /*!< SMS storage watermark crossed. Use with \ref GSM_CB_SMS_STORAGE event */
+#endif /* GSM_CFG_SMS_WATERMARK || __DOXYGEN__ */
+#if GSM_CFG_SMS_REPORT || __DOXYGEN__
+        struct {
+            uint32_t tag;                       /*!< Tag of sent message or `0` if message was sent without tag */
+            uint8_t mr;                         /*!< Message reference of sent message */
+            const gsm_sms_report_t* report;     /*!< Status report or `NULL` when report did not arrive in time */
+            gsmr_t res;                         /*!< \ref gsmOK when delivered, \ref gsmERR when failed or \ref gsmTIMEOUT when report expired */
+        } sms_report;                           /*!< SMS status report. Use with \ref GSM_CB_SMS_REPORT event */
+#endif /* GSM_CFG_SMS_REPORT || __DOXYGEN__ */
+#if GSM_CFG_SMS_OUTBOX || __DOXYGEN__
+        struct {
+            uint32_t id;                        /*!< Message ID returned by \ref gsm_sms_outbox_send */
+            const char* num;                    /*!< Phone number, valid only during event */
+            gsmr_t res;                         /*!< Final result, \ref gsmOK when message was sent */
+            uint16_t cms_err;                   /*!< Error code of last `+CMS ERROR` response or `0` if not received */
+            uint8_t tries;                      /*!< Number of send attempts */
+            size_t pending;                     /*!< Number of messages still waiting in outbox */
+        } sms_outbox;                           /*!< Outbox message finished. Use with \ref GSM_CB_SMS_OUTBOX event */
+#endif /* GSM_CFG_SMS_OUTBOX || __DOXYGEN__ */
         struct {
             gsm_sms_entry_t* entry;             /*!< SMS entry */
         } sms_read;                             /*!< SMS read. Use with \ref GSM_CB_SMS_READ event */
@@ -421,6 +673,28 @@ typedef struct gsm_cb_t {
             size_t size;                        /*!< Number of valid entries */
             gsmr_t err;                         /*!< Error message if exists */
         } sms_list;                             /*!< SMS list. Use with \ref GSM_CB_SMS_LIST event */
+#if GSM_CFG_SMS_BODY_SLICE || __DOXYGEN__
+        struct {
+            const gsm_sms_entry_t* entry;       /*!< Entry with parsed message header */
+            const char* data;                   /*!< Pointer to slice in received data, valid only during event */
+            size_t len;                         /*!< Length of slice in units of bytes */
+            size_t offset;                      /*!< Offset of slice from beginning of body */
+            uint8_t last;                       /*!< Set to `1` when slice is last part of body */
+            uint8_t copy;                       /*!< Set to `1` in callback to copy slice to `data` field of entry at slice offset */
+        } sms_body;                             /*!< SMS body slice. Use with \ref GSM_CB_SMS_BODY event */
+#endif /* GSM_CFG_SMS_BODY_SLICE || __DOXYGEN__ */
+#if GSM_CFG_SMS_CONCAT || __DOXYGEN__
+        struct {
+            const char* number;                 /*!< Sender phone number */
+            const gsm_datetime_t* datetime;     /*!< Date and time of first part */
+            uint16_t ref;                       /*!< Reference number of message */
+            uint8_t total;                      /*!< Number of parts */
+            gsm_sms_coding_t coding;            /*!< Data coding */
+            const char* data;                   /*!< Assembled UTF-8 text or 8-bit data */
+            size_t length;                      /*!< Length of data in units of bytes */
+            uint8_t truncated;                  /*!< Set to `1` when text of any part was truncated */
+        } sms_concat;                           /*!< Concatenated SMS received. Use with \ref GSM_CB_SMS_CONCAT event */
+#endif /* GSM_CFG_SMS_CONCAT || __DOXYGEN__ */
 #endif /* GSM_CFG_SMS || __DOXYGEN__ */
 #if GSM_CFG_CALL || __DOXYGEN__
         struct {
@@ -447,6 +721,17 @@ typedef struct gsm_cb_t {
             size_t size;                        /*!< Number of valid entries */
             gsmr_t err;                         /*!< Error message if exists */
         } pb_search;                            /*!< Phonebok search list. Use with \ref GSM_CB_PB_SEARCH event */
+#if GSM_CFG_PB_SYNC || __DOXYGEN__
+        struct {
+            gsm_mem_t mem;                      /*!< Synchronized memory */
+            size_t read;                        /*!< Number of entries read from device */
+            size_t kept;                        /*!< Number of target entries already stored on device */
+            size_t written;                     /*!< Number of finished writes and deletes */
+            size_t writes;                      /*!< Number of needed writes and deletes, valid after all entries are read */
+            uint8_t done;                       /*!< Set to `1` when sync is finished */
+            gsmr_t res;                         /*!< Sync result, valid when `done` is set */
+        } pb_sync;                              /*!< Phonebook sync progress. Use with \ref GSM_CB_PB_SYNC event */
+#endif /* GSM_CFG_PB_SYNC || __DOXYGEN__ */
 #endif /* GSM_CFG_PHONEBOOK || __DOXYGEN__ */
         struct {
             gsm_conn_p conn;                    /*!< Connection where data were received */